@@ -41,6 +41,29 @@ protected:
      * evaluation of other forward/reverse modes.
      */
     bool standAlone_;
+    /**
+     * Whether or not the Jacobian and Hessian sparsity patterns used to
+     * determine which Taylor coefficients are always zero are computed
+     * only once and reused in later calls
+     */
+    bool cacheSparsity_;
+    /**
+     * Whether or not the Jacobian sparsity has already been cached
+     */
+    bool jacCached_;
+    /**
+     * The cached Jacobian sparsity (the columns of each row)
+     */
+    std::vector<std::vector<size_t> > jacRows_;
+    /**
+     * The cached Jacobian sparsity (the rows of each column)
+     */
+    std::vector<std::vector<size_t> > jacCols_;
+    /**
+     * The cached Hessian sparsity patterns (the columns of each row) for
+     * each combination of the dependents used in the Hessian
+     */
+    std::map<std::vector<bool>, std::vector<std::vector<size_t> > > hessCache_;
 
 protected:
 
@@ -58,7 +81,9 @@ protected:
                                  bool standAlone = false) :
             Super(name),
             id_(createNewAtomicFunctionID()),
-            standAlone_(standAlone) {
+            standAlone_(standAlone),
+            cacheSparsity_(true),
+            jacCached_(false) {
         CPPADCG_ASSERT_KNOWN(!name.empty(), "The atomic function name cannot be empty")
         this->option(CppAD::atomic_base<CGB>::set_sparsity_enum);
     }
@@ -91,6 +116,40 @@ public:
         return standAlone_;
     }
 
+    /**
+     * Whether or not the Jacobian and Hessian sparsity patterns, used while
+     * taping to determine which Taylor coefficients are always zero, are
+     * only computed once for this atomic function.
+     */
+    inline bool isCacheSparsity() const {
+        return cacheSparsity_;
+    }
+
+    /**
+     * Defines whether or not the Jacobian and Hessian sparsity patterns,
+     * used while taping to determine which Taylor coefficients are always
+     * zero, are only computed once for this atomic function.
+     * It should be disabled when the sparsity patterns depend on the
+     * values of the independent variables.
+     *
+     * @param cache true to compute the sparsity patterns only once
+     */
+    inline void setCacheSparsity(bool cache) {
+        cacheSparsity_ = cache;
+        if (!cache)
+            clearSparsityCache();
+    }
+
+    /**
+     * Discards any cached sparsity pattern.
+     */
+    inline void clearSparsityCache() {
+        jacCached_ = false;
+        jacRows_.clear();
+        jacCols_.clear();
+        hessCache_.clear();
+    }
+
     bool forward(size_t q,
                  size_t p,
                  const CppAD::vector<bool>& vx,
@@ -138,13 +197,6 @@ public:
 
             size_t n = tx.size() / (p + 1);
 
-            vector<std::set<size_t> > r(n);
-            for (size_t j = 0; j < n; j++) {
-                if (!tx[j * (p + 1) + 1].isIdenticalZero())
-                    r[j].insert(0);
-            }
-            vector<std::set<size_t> > s(m);
-
             if(x.size() == 0) {
                 x.resize(n);
                 for (size_t j = 0; j < n; j++) {
@@ -152,17 +204,39 @@ public:
                 }
             }
 
-            bool good = this->for_sparse_jac(1, r, s, x);
-            if (!good)
-                return false;
-
             vyLocal.resize(ty.size());
             for (size_t i = 0; i < vyLocal.size(); i++) {
                 vyLocal[i] = true;
             }
 
-            for (size_t i = 0; i < m; i++) {
-                vyLocal[i * (p + 1) + 1] = !s[i].empty();
+            if (cacheSparsity_) {
+                if (!loadJacobianSparsity(m, x))
+                    return false;
+
+                std::vector<bool> dir(n);
+                for (size_t j = 0; j < n; j++) {
+                    dir[j] = !tx[j * (p + 1) + 1].isIdenticalZero();
+                }
+
+                for (size_t i = 0; i < m; i++) {
+                    vyLocal[i * (p + 1) + 1] = isAnyMarked(jacRows_[i], dir);
+                }
+
+            } else {
+                vector<std::set<size_t> > r(n);
+                for (size_t j = 0; j < n; j++) {
+                    if (!tx[j * (p + 1) + 1].isIdenticalZero())
+                        r[j].insert(0);
+                }
+                vector<std::set<size_t> > s(m);
+
+                bool good = this->for_sparse_jac(1, r, s, x);
+                if (!good)
+                    return false;
+
+                for (size_t i = 0; i < m; i++) {
+                    vyLocal[i * (p + 1) + 1] = !s[i].empty();
+                }
             }
 
             if (p == 1) {
@@ -273,29 +347,67 @@ public:
         size_t m = ty.size() / p1;
         size_t n = tx.size() / p1;
 
-        vector<std::set<size_t> > rt(m);
-        for (size_t i = 0; i < m; i++) {
-            if (!py[i * p1].isIdenticalZero()) {
-                rt[i].insert(0);
-            }
-        }
-
         CppAD::vector<CGB> x(n);
         for (size_t j = 0; j < n; j++) {
             x[j] = tx[j * p1];
         }
 
-        vector<std::set<size_t> > st(n);
-        bool good = this->rev_sparse_jac(1, rt, st, x);
-        if (!good) {
-            return false;
-        }
+        if (cacheSparsity_) {
+            if (!loadJacobianSparsity(m, x))
+                return false;
 
-        for (size_t j = 0; j < n; j++) {
-            vxLocal[j * p1 + p] = !st[j].empty();
+            std::vector<bool> w(m);
+            for (size_t i = 0; i < m; i++) {
+                w[i] = !py[i * p1].isIdenticalZero();
+            }
+
+            for (size_t j = 0; j < n; j++) {
+                vxLocal[j * p1 + p] = isAnyMarked(jacCols_[j], w);
+            }
+
+        } else {
+            vector<std::set<size_t> > rt(m);
+            for (size_t i = 0; i < m; i++) {
+                if (!py[i * p1].isIdenticalZero()) {
+                    rt[i].insert(0);
+                }
+            }
+
+            vector<std::set<size_t> > st(n);
+            bool good = this->rev_sparse_jac(1, rt, st, x);
+            if (!good) {
+                return false;
+            }
+
+            for (size_t j = 0; j < n; j++) {
+                vxLocal[j * p1 + p] = !st[j].empty();
+            }
         }
 
-        if (p >= 1) {
+        if (p >= 1 && cacheSparsity_) {
+            /**
+             * Use the Hessian sparsity to determine which elements
+             * will always be zero
+             */
+            std::vector<bool> s(m);
+            for (size_t i = 0; i < m; i++) {
+                s[i] = !py[i * p1 + 1].isIdenticalZero();
+            }
+
+            const std::vector<std::vector<size_t> >* hess = loadHessianSparsity(s, x);
+            if (hess == nullptr)
+                return false;
+
+            std::vector<bool> dir(n);
+            for (size_t j = 0; j < n; j++) {
+                dir[j] = !tx[j * p1 + 1].isIdenticalZero();
+            }
+
+            for (size_t j = 0; j < n; j++) {
+                vxLocal[j * p1 + p - 1] = isAnyMarked((*hess)[j], dir);
+            }
+
+        } else if (p >= 1) {
             /**
              * Use the Hessian sparsity to determine which elements
              * will always be zero
@@ -543,6 +655,92 @@ protected:
 
 private:
 
+    /**
+     * Computes the Jacobian sparsity pattern if it was not cached yet.
+     *
+     * @return true on success, false otherwise
+     */
+    inline bool loadJacobianSparsity(size_t m,
+                                     const CppAD::vector<CGB>& x) {
+        if (jacCached_)
+            return true;
+
+        size_t n = x.size();
+
+        CppAD::vector<std::set<size_t> > r(n); // identity matrix
+        for (size_t j = 0; j < n; j++)
+            r[j].insert(j);
+
+        CppAD::vector<std::set<size_t> > s(m);
+        if (!this->for_sparse_jac(n, r, s, x))
+            return false;
+
+        jacRows_.assign(m, std::vector<size_t>());
+        jacCols_.assign(n, std::vector<size_t>());
+        for (size_t i = 0; i < m; i++) {
+            jacRows_[i].assign(s[i].begin(), s[i].end());
+            for (size_t j : s[i]) {
+                jacCols_[j].push_back(i);
+            }
+        }
+
+        jacCached_ = true;
+        return true;
+    }
+
+    /**
+     * Provides the Hessian sparsity pattern for a combination of
+     * dependents (computing it if it was not cached yet).
+     *
+     * @param s the dependents used in the Hessian
+     * @return the columns of each row of the Hessian sparsity pattern or
+     *         nullptr on failure
+     */
+    inline const std::vector<std::vector<size_t> >* loadHessianSparsity(const std::vector<bool>& s,
+                                                                      const CppAD::vector<CGB>& x) {
+        auto it = hessCache_.find(s);
+        if (it != hessCache_.end())
+            return &it->second;
+
+        size_t n = x.size();
+        size_t m = s.size();
+
+        CppAD::vector<std::set<size_t> > r(n); // identity matrix
+        for (size_t j = 0; j < n; j++)
+            r[j].insert(j);
+
+        CppAD::vector<bool> vx(n), sv(m), t(n);
+        for (size_t j = 0; j < n; j++)
+            vx[j] = true;
+        for (size_t i = 0; i < m; i++)
+            sv[i] = s[i];
+
+        const CppAD::vector<std::set<size_t> > u(m); // empty
+        CppAD::vector<std::set<size_t> > v(n);
+
+        if (!this->rev_sparse_hes(vx, sv, t, n, r, u, v, x))
+            return nullptr;
+
+        std::vector<std::vector<size_t> >& hess = hessCache_[s];
+        hess.resize(n);
+        for (size_t j = 0; j < n; j++) {
+            hess[j].assign(v[j].begin(), v[j].end());
+        }
+        return &hess;
+    }
+
+    /**
+     * Whether or not any of the provided indexes is marked.
+     */
+    static inline bool isAnyMarked(const std::vector<size_t>& indexes,
+                                   const std::vector<bool>& marked) {
+        for (size_t k : indexes) {
+            if (marked[k])
+                return true;
+        }
+        return false;
+    }
+
     inline bool evalForwardValues(size_t q,
                                   size_t p,
                                   const CppAD::vector<CGB>& tx,
@@ -141,6 +141,8 @@ protected:
     bool _used;
     // a flag indicating whether or not to reuse the IDs of destroyed variables
     bool _reuseIDs;
+    // a flag indicating whether or not to reorder operations to reduce the number of live temporary variables
+    bool _registerPressureScheduling;
     // scope color/index counter
     ScopeIDType _scopeColorCount;
     // the current scope color/index counter
@@ -197,6 +199,26 @@ public:
      */
     inline bool isReuseVariableIDs() const;
 
+    /**
+     * Defines whether or not to reorder the operations so that the number
+     * of temporary variables which are simultaneously in use is reduced
+     * (a Sethi-Ullman like ordering applied to the operation graph).
+     * This results in a smaller work array and fewer register spills in
+     * the generated code.
+     * It is only used when node IDs are reused (see setReuseVariableIDs())
+     * and for operation graphs without loops, conditional blocks, arrays,
+     * atomic functions, or print operations.
+     *
+     * @param schedule whether or not to reorder the operations
+     */
+    inline void setRegisterPressureScheduling(bool schedule);
+
+    /**
+     * Whether or not the operations are reordered so that the number of
+     * temporary variables which are simultaneously in use is reduced.
+     */
+    inline bool isRegisterPressureScheduling() const;
+
     /**
      * Marks the provided variables as being independent variables.
      *
@@ -351,6 +373,30 @@ public:
                                           size_t& bifurcations,
                                           size_t maxBifurcations = (std::numeric_limits<size_t>::max)());
 
+    /**
+     * Determines the independent variables required to evaluate each
+     * dependent variable.
+     * Unlike a Jacobian sparsity pattern, these are value dependencies and
+     * therefore they also include, for instance, the variables used in the
+     * comparisons of conditional expressions.
+     *
+     * @param dependent the dependent variables
+     * @return the indexes of the independent variables (in the order they
+     *         were created in this handler) used by each dependent
+     */
+    inline std::vector<std::set<size_t> > findIndependentDependencies(ArrayView<CGB> dependent);
+
+    /**
+     * Determines the number of operations required to evaluate a set of
+     * dependent variables.
+     * Operations shared by several dependents are only counted once.
+     *
+     * @param dependent the dependent variables
+     * @return the number of operation nodes (excluding the independent
+     *         variables)
+     */
+    inline size_t countOperations(ArrayView<CGB> dependent);
+
     /**************************************************************************
      *                       Source code generation
      *************************************************************************/
@@ -706,6 +752,20 @@ protected:
 
     inline void reorderOperation(Node& node);
 
+    /**
+     * Reorders the operations in the evaluation queue so that the number of
+     * temporary variables which are simultaneously in use is reduced.
+     * The arguments which require more temporary variables are evaluated
+     * first (Sethi-Ullman numbering generalized to a graph of operations).
+     */
+    inline void scheduleForRegisterPressure();
+
+    /**
+     * Whether or not an operation can be moved to any location in the
+     * evaluation queue, as long as its arguments are evaluated before it.
+     */
+    inline static bool isFreelySchedulable(const Node& node);
+
     /**
      * Determine the highest location in the evaluation queue of temporary
      * variables used by an operation node in the same scope.
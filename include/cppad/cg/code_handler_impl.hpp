@@ -38,6 +38,7 @@ CodeHandler<Base>::CodeHandler(size_t varCount) :
         _atomicFunctionsOrder(nullptr),
         _used(false),
         _reuseIDs(true),
+        _registerPressureScheduling(false),
         _scopeColorCount(0),
         _currentScopeColor(0),
         _lang(nullptr),
@@ -72,6 +73,16 @@ inline bool CodeHandler<Base>::isReuseVariableIDs() const {
     return _reuseIDs;
 }
 
+template<class Base>
+inline void CodeHandler<Base>::setRegisterPressureScheduling(bool schedule) {
+    _registerPressureScheduling = schedule;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isRegisterPressureScheduling() const {
+    return _registerPressureScheduling;
+}
+
 template<class Base>
 inline void CodeHandler<Base>::makeVariables(std::vector<AD<CGB> >& variables) {
     for (auto& v : variables) {
@@ -442,7 +453,7 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
                                                                                           _loops.indexes, _loops.indexRandomPatterns,
                                                                                           _loops.dependentIndexPatterns, _loops.independentIndexPatterns,
                                                                                           _totalUseCount, _scope, *_auxIterationIndexOp,
-                                                                                          _zeroDependents));
+                                                                                          _zeroDependents, _jobTimer));
 
     lang.generateSourceCode(out, std::move(_info));
 
@@ -1635,6 +1646,10 @@ inline void CodeHandler<Base>::addToEvaluationQueue(Node& arg) {
 template<class Base>
 inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependent) {
 
+    if (_registerPressureScheduling) {
+        scheduleForRegisterPressure();
+    }
+
     reorderOperations(dependent);
 
     /**
@@ -1805,6 +1820,181 @@ inline void CodeHandler<Base>::reorderOperation(Node& node) {
     }
 }
 
+template<class Base>
+inline void CodeHandler<Base>::scheduleForRegisterPressure() {
+    const size_t nOps = _variableOrder.size();
+    if (nOps < 3)
+        return; // nothing to improve
+
+    auto isInQueue = [this](const Node& node) {
+        size_t order = getEvaluationOrder(node);
+        return order > 0 && _variableOrder[order - 1] == &node;
+    };
+
+    /**
+     * determine the operations in the evaluation queue used by each
+     * operation (directly or through other operations which are not in
+     * the queue since they are part of the same expression)
+     */
+    std::vector<std::vector<size_t>> deps(nOps); // positions in the original evaluation queue
+    std::vector<std::vector<Node*>> expression(nOps); // nodes evaluated together with each operation
+    std::vector<bool> used(nOps, false);
+
+    startNewOperationTreeVisit();
+
+    std::vector<Node*> stack;
+    for (size_t i = 0; i < nOps; i++) {
+        Node& var = *_variableOrder[i];
+        if (!isFreelySchedulable(var))
+            return; // keep the original order
+
+        stack.clear();
+        stack.push_back(&var);
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+
+            for (const Arg& a : node->getArguments()) {
+                Node* arg = a.getOperation();
+                if (arg == nullptr || isIndependent(*arg)) {
+                    continue;
+
+                } else if (isInQueue(*arg)) {
+                    size_t pos = getEvaluationOrder(*arg) - 1;
+                    if (pos >= i)
+                        return; // unexpected order (keep the original order)
+                    if (std::find(deps[i].begin(), deps[i].end(), pos) == deps[i].end()) {
+                        deps[i].push_back(pos);
+                        used[pos] = true;
+                    }
+
+                } else {
+                    if (isVisited(*arg) || !isFreelySchedulable(*arg))
+                        return; // shared expression or an unsupported operation (keep the original order)
+
+                    markVisited(*arg);
+                    expression[i].push_back(arg);
+                    stack.push_back(arg);
+                }
+            }
+        }
+    }
+
+    /**
+     * number of temporary variables required to evaluate each operation
+     * (the arguments requiring more temporaries are evaluated first)
+     */
+    std::vector<size_t> need(nOps);
+    for (size_t i = 0; i < nOps; i++) {
+        std::vector<size_t>& d = deps[i];
+        std::stable_sort(d.begin(), d.end(), [&need](size_t a, size_t b) {
+            return need[a] > need[b];
+        });
+
+        need[i] = 1;
+        for (size_t k = 0; k < d.size(); k++) {
+            need[i] = std::max<size_t>(need[i], need[d[k]] + k);
+        }
+    }
+
+    /**
+     * new evaluation order (depth first starting from the operations not
+     * used by any other operation)
+     */
+    std::vector<Node*> newOrder;
+    newOrder.reserve(nOps);
+    std::vector<size_t> newPos(nOps);
+    std::vector<bool> added(nOps, false);
+    std::vector<std::pair<size_t, size_t>> opStack; // position, next argument
+
+    for (size_t r = 0; r < nOps; r++) {
+        if (used[r])
+            continue;
+
+        opStack.emplace_back(r, 0);
+        while (!opStack.empty()) {
+            size_t i = opStack.back().first;
+            size_t& k = opStack.back().second;
+
+            while (k < deps[i].size() && added[deps[i][k]]) {
+                k++;
+            }
+
+            if (k < deps[i].size()) {
+                opStack.emplace_back(deps[i][k], 0);
+            } else {
+                added[i] = true;
+                newPos[i] = newOrder.size();
+                newOrder.push_back(_variableOrder[i]);
+                opStack.pop_back();
+            }
+        }
+    }
+
+    CPPADCG_ASSERT_UNKNOWN(newOrder.size() == nOps)
+
+    if (newOrder == _variableOrder)
+        return;
+
+    /**
+     * update the evaluation order
+     */
+    for (size_t i = 0; i < nOps; i++) {
+        size_t order = newPos[i] + 1;
+        setEvaluationOrder(*_variableOrder[i], order);
+        for (Node* n : expression[i]) {
+            setEvaluationOrder(*n, order);
+        }
+    }
+
+    _variableOrder.swap(newOrder);
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isFreelySchedulable(const Node& node) {
+    switch (node.getOperationType()) {
+        case CGOpCode::Assign:
+        case CGOpCode::Abs:
+        case CGOpCode::Acos:
+        case CGOpCode::Acosh:
+        case CGOpCode::Add:
+        case CGOpCode::Alias:
+        case CGOpCode::Asin:
+        case CGOpCode::Asinh:
+        case CGOpCode::Atan:
+        case CGOpCode::Atanh:
+        case CGOpCode::ComLt:
+        case CGOpCode::ComLe:
+        case CGOpCode::ComEq:
+        case CGOpCode::ComGe:
+        case CGOpCode::ComGt:
+        case CGOpCode::ComNe:
+        case CGOpCode::Cosh:
+        case CGOpCode::Cos:
+        case CGOpCode::Div:
+        case CGOpCode::Erf:
+        case CGOpCode::Erfc:
+        case CGOpCode::Exp:
+        case CGOpCode::Expm1:
+        case CGOpCode::Inv:
+        case CGOpCode::Log:
+        case CGOpCode::Log1p:
+        case CGOpCode::Mul:
+        case CGOpCode::Pow:
+        case CGOpCode::Sign:
+        case CGOpCode::Sinh:
+        case CGOpCode::Sin:
+        case CGOpCode::Sqrt:
+        case CGOpCode::Sub:
+        case CGOpCode::Tanh:
+        case CGOpCode::Tan:
+        case CGOpCode::UnMinus:
+            return true;
+        default:
+            return false;
+    }
+}
+
 template<class Base>
 inline size_t CodeHandler<Base>::findLastTemporaryLocation(Node& root) {
 
@@ -2048,6 +2238,102 @@ inline void CodeHandler<Base>::findVariableDependencies(size_t i,
     depthFirstGraphNavigation(root, analyse, true);
 }
 
+template<class Base>
+inline std::vector<std::set<size_t> > CodeHandler<Base>::findIndependentDependencies(ArrayView<CGB> dependent) {
+    std::vector<std::set<size_t> > deps(dependent.size());
+
+    // the (sorted) independent variables used by each node
+    CodeHandlerVector<Base, std::vector<size_t> > indeps(*this);
+    indeps.adjustSize();
+
+    startNewOperationTreeVisit();
+
+    for (size_t j = 0; j < _independentVariables.size(); ++j) {
+        Node& indep = *_independentVariables[j];
+        indeps[indep].push_back(j);
+        markVisited(indep);
+    }
+
+    auto nodeAnalysis = [this](OperationStackData<Base>& stackEl,
+                               OperationStack<Base>& stack) {
+        auto& node = stackEl.node();
+        if (isVisited(node))
+            return false; // already determined
+
+        markVisited(node);
+        stack.pushNodeArguments(node, 0);
+        return true;
+    };
+
+    std::vector<size_t> merged;
+
+    auto nodePostProcess = [&](OperationStackData<Base>& stackEl) {
+        auto& node = stackEl.node();
+        std::vector<size_t>& nodeIndeps = indeps[node];
+
+        for (const Arg& a : node.getArguments()) {
+            if (a.getOperation() != nullptr) {
+                const std::vector<size_t>& argIndeps = indeps[*a.getOperation()];
+                merged.clear();
+                std::set_union(nodeIndeps.begin(), nodeIndeps.end(),
+                               argIndeps.begin(), argIndeps.end(),
+                               std::back_inserter(merged));
+                nodeIndeps.swap(merged);
+            }
+        }
+    };
+
+    for (size_t i = 0; i < dependent.size(); ++i) {
+        Node* root = dependent[i].getOperationNode();
+        if (root == nullptr)
+            continue; // a parameter
+
+        depthFirstGraphNavigation(*root, 0, nodeAnalysis, nodePostProcess, true);
+
+        const std::vector<size_t>& rootIndeps = indeps[*root];
+        deps[i].insert(rootIndeps.begin(), rootIndeps.end());
+    }
+
+    return deps;
+}
+
+template<class Base>
+inline size_t CodeHandler<Base>::countOperations(ArrayView<CGB> dependent) {
+    size_t count = 0;
+
+    startNewOperationTreeVisit();
+
+    auto nodeAnalysis = [&](OperationStackData<Base>& stackEl,
+                            OperationStack<Base>& stack) {
+        auto& node = stackEl.node();
+        if (isVisited(node))
+            return false; // already counted
+
+        markVisited(node);
+        if (!isIndependent(node))
+            count++;
+        stack.pushNodeArguments(node, 0);
+        return true;
+    };
+
+    auto nodePostProcess = [](OperationStackData<Base>&) {
+    };
+
+    for (size_t i = 0; i < dependent.size(); ++i) {
+        Node* root = dependent[i].getOperationNode();
+        if (root == nullptr || isVisited(*root))
+            continue; // a parameter or already counted
+
+        markVisited(*root);
+        if (!isIndependent(*root))
+            count++;
+
+        depthFirstGraphNavigation(*root, 0, nodeAnalysis, nodePostProcess, false);
+    }
+
+    return count;
+}
+
 template<class Base>
 inline bool CodeHandler<Base>::isIndependent(const Node& arg) const {
     return arg.getOperationType() == CGOpCode::Inv;
@@ -55,7 +55,12 @@ static_assert(false,
 #include <cstring>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #include <functional>
+#include <iterator>
 
 // ---------------------------------------------------------------------------
 // operating system detection
@@ -127,6 +132,7 @@ static_assert(false,
 #include <cppad/cg/atomic_dependency_locator.hpp>
 #include <cppad/cg/variable_name_generator.hpp>
 #include <cppad/cg/job_timer.hpp>
+#include <cppad/cg/source_file_stream.hpp>
 #include <cppad/cg/lang/language.hpp>
 #include <cppad/cg/lang/lang_stream_stack.hpp>
 #include <cppad/cg/scope_path_element.hpp>
@@ -169,6 +175,7 @@ static_assert(false,
 #include <cppad/cg/evaluator/evaluator_ad.hpp>
 #include <cppad/cg/evaluator/evaluator_adcg.hpp>
 #include <cppad/cg/evaluator/evaluator_cg.hpp>
+#include <cppad/cg/evaluator/evaluator_parallel.hpp>
 #include <cppad/cg/operation_path_node.hpp>
 #include <cppad/cg/operation_path.hpp>
 #include <cppad/cg/solver.hpp>
@@ -207,6 +214,7 @@ static_assert(false,
 #include <cppad/cg/lang/c/language_c_loops.hpp>
 #include <cppad/cg/lang/c/lang_c_default_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_hessian_var_name_gen.hpp>
+#include <cppad/cg/lang/c/lang_c_default_dynamic_param_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_reverse2_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_custom_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_util.hpp>
@@ -215,6 +223,7 @@ static_assert(false,
 #include <cppad/cg/model/threadpool/multi_threading_type.hpp>
 #include <cppad/cg/model/threadpool/thread_pool_schedule_strategy.hpp>
 #include <cppad/cg/model/external_function_wrapper.hpp>
+#include <cppad/cg/model/array_atomic_fun.hpp>
 #include <cppad/cg/model/atomic_external_function_wrapper.hpp>
 #include <cppad/cg/model/generic_model_external_function_wrapper.hpp>
 #include <cppad/cg/model/model_library_processor.hpp>
@@ -222,6 +231,8 @@ static_assert(false,
 #include <cppad/cg/model/generic_model.hpp>
 #include <cppad/cg/model/functor_generic_model.hpp>
 #include <cppad/cg/model/functor_model_library.hpp>
+#include <cppad/cg/model/interpreter/bytecode_function.hpp>
+#include <cppad/cg/model/interpreter/interpreted_model.hpp>
 #include <cppad/cg/model/save_files_model_library_processor.hpp>
 
 // automated static library creation
@@ -263,6 +274,7 @@ static_assert(false,
 
 // automated dynamic library creation
 #include <cppad/cg/model/dynamic_lib/dynamiclib.hpp>
+#include <cppad/cg/model/dynamic_lib/tiered_generic_model.hpp>
 #include <cppad/cg/model/dynamic_lib/dynamic_library_processor.hpp>
 
 // ---------------------------------------------------------------------------
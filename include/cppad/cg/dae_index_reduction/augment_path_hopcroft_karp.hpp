@@ -0,0 +1,311 @@
+#ifndef CPPAD_CG_AUGMENT_PATH_HOPCROFT_KARP_INCLUDED
+#define CPPAD_CG_AUGMENT_PATH_HOPCROFT_KARP_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/dae_index_reduction/augment_path.hpp>
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * An augment path algorithm based on the Hopcroft-Karp method.
+ *
+ * augmentPath() performs a breadth-first search from a single equation
+ * which finds the shortest augmenting path (unassigned derivative variables
+ * are preferred over algebraic variables).
+ * Just like AugmentPathDepthLookahead, all the nodes visited in an
+ * unsuccessful search are colored.
+ *
+ * maximumMatching() assigns a set of equations at once using phases of
+ * vertex-disjoint shortest augmenting paths which requires O(E sqrt(V))
+ * operations instead of O(E V) for individual augmentations.
+ *
+ * None of the searches are recursive and therefore they can be used in
+ * very large systems.
+ */
+template<class Base>
+class AugmentPathHopcroftKarp : public AugmentPath<Base> {
+protected:
+    using CGBase = CppAD::cg::CG<Base>;
+    using ADCG = CppAD::AD<CGBase>;
+protected:
+    /**
+     * The variable used to reach each equation (by equation index)
+     */
+    std::vector<Vnode<Base>*> reachedBy_;
+    /**
+     * The equation used to reach each variable (by variable index)
+     */
+    std::vector<Enode<Base>*> parent_;
+    /**
+     * Equations to visit
+     */
+    std::vector<Enode<Base>*> queue_;
+    /**
+     * The layer of each equation in the current phase (by equation index)
+     */
+    std::vector<size_t> layer_;
+public:
+
+    bool augmentPath(Enode<Base>& i) override final {
+        std::ostream& out = this->logger_->log();
+        Verbosity verbosity = this->logger_->getVerbosity();
+
+        i.color(out, verbosity);
+
+        queue_.clear();
+        queue_.push_back(&i);
+
+        for (size_t q = 0; q < queue_.size(); ++q) {
+            Enode<Base>& e = *queue_[q];
+
+            Vnode<Base>* free = findUnassigned(e);
+            if (free != nullptr) {
+                // flip the assignments along the path
+                Vnode<Base>* j = free;
+                Enode<Base>* k = &e;
+                while (true) {
+                    Vnode<Base>* next = k == &i ? nullptr : reachedBy_[k->index()];
+                    j->setAssignmentEquation(*k, out, verbosity);
+                    if (next == nullptr)
+                        break;
+                    k = parent_[next->index()];
+                    j = next;
+                }
+                return true;
+            }
+
+            for (Vnode<Base>* jj : e.variables()) {
+                if (jj->isColored())
+                    continue;
+                jj->color(out, verbosity);
+                set(parent_, jj->index(), &e);
+
+                Enode<Base>& k = *jj->assignmentEquation(); // all variables are assigned to another equation
+                if (!k.isColored()) {
+                    k.color(out, verbosity);
+                    set(reachedBy_, k.index(), jj);
+                    queue_.push_back(&k);
+                }
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Assigns as many of the provided equations as possible to variables
+     * while keeping the existing assignments (a maximum matching).
+     * The color of the nodes is not used nor modified.
+     *
+     * @param equations The equations to assign (existing assignments of
+     *                  other equations are only modified through
+     *                  augmenting paths)
+     * @return the number of newly assigned equations
+     */
+    inline size_t maximumMatching(const std::vector<Enode<Base>*>& equations) {
+        return maximumMatching(equations, [](const Vnode<Base>&) { return true; });
+    }
+
+    /**
+     * Assigns as many of the provided equations as possible to variables
+     * while keeping the existing assignments (a maximum matching) using
+     * only some of the variables.
+     * The color of the nodes is not used nor modified.
+     *
+     * @param equations The equations to assign (existing assignments of
+     *                  other equations are only modified through
+     *                  augmenting paths)
+     * @param accept Whether or not a variable can be used in the
+     *               augmenting paths
+     * @return the number of newly assigned equations
+     */
+    template<class VarFilter>
+    inline size_t maximumMatching(const std::vector<Enode<Base>*>& equations,
+                                  VarFilter accept) {
+        std::ostream& out = this->logger_->log();
+        Verbosity verbosity = this->logger_->getVerbosity();
+
+        const size_t inf = std::numeric_limits<size_t>::max();
+
+        std::vector<Enode<Base>*> free;
+        for (Enode<Base>* i : equations) {
+            if (i->assignmentVariable() == nullptr)
+                free.push_back(i);
+        }
+
+        struct Frame {
+            Enode<Base>* eq;
+            size_t var; // the position of the next variable to visit
+        };
+        std::vector<Frame> stack;
+        std::vector<Vnode<Base>*> path;
+
+        size_t assigned = 0;
+
+        while (!free.empty()) {
+            /**
+             * breadth-first search from all the unassigned equations
+             */
+            for (Enode<Base>* i : queue_) {
+                set(layer_, i->index(), inf);
+            }
+            queue_.clear();
+
+            for (Enode<Base>* i : free) {
+                set(layer_, i->index(), 0);
+                queue_.push_back(i);
+            }
+
+            size_t shortest = inf;
+            for (size_t q = 0; q < queue_.size(); ++q) {
+                Enode<Base>& e = *queue_[q];
+                size_t l = layer_[e.index()];
+                if (l >= shortest)
+                    break;
+
+                for (Vnode<Base>* jj : e.variables()) {
+                    if (!accept(*jj))
+                        continue;
+                    Enode<Base>* k = jj->assignmentEquation();
+                    if (k == nullptr) {
+                        shortest = l; // a free variable is reachable
+                    } else if (getLayer(*k) == inf) {
+                        set(layer_, k->index(), l + 1);
+                        queue_.push_back(k);
+                    }
+                }
+            }
+
+            if (shortest == inf)
+                break; // no more augmenting paths
+
+            /**
+             * vertex-disjoint depth-first searches along the layers
+             */
+            size_t found = 0;
+            for (Enode<Base>* i : free) {
+                stack.clear();
+                path.clear();
+                stack.push_back(Frame{i, 0});
+
+                bool augmented = false;
+                while (!stack.empty() && !augmented) {
+                    Frame& f = stack.back();
+                    Enode<Base>& e = *f.eq;
+                    const std::vector<Vnode<Base>*>& vars = e.variables();
+                    size_t l = layer_[e.index()];
+
+                    if (f.var == vars.size()) {
+                        // dead end: it will not be visited again in this phase
+                        layer_[e.index()] = inf;
+                        stack.pop_back();
+                        if (!path.empty())
+                            path.pop_back();
+                        continue;
+                    }
+
+                    Vnode<Base>* jj = vars[f.var++];
+                    if (!accept(*jj))
+                        continue;
+                    Enode<Base>* k = jj->assignmentEquation();
+                    if (k == nullptr) {
+                        if (l == shortest) {
+                            path.push_back(jj);
+                            augmented = true;
+                        }
+                    } else if (l < shortest && getLayer(*k) == l + 1) {
+                        path.push_back(jj);
+                        stack.push_back(Frame{k, 0}); // f is no longer valid
+                    }
+                }
+
+                if (augmented) {
+                    // the equations in the path cannot be used again in this phase
+                    for (size_t p = 0; p < path.size(); ++p) {
+                        Enode<Base>& e = *stack[p].eq;
+                        path[p]->setAssignmentEquation(e, out, verbosity);
+                        layer_[e.index()] = inf;
+                    }
+                    found++;
+                }
+            }
+
+            if (found == 0)
+                break;
+
+            assigned += found;
+
+            auto it = std::remove_if(free.begin(), free.end(), [](Enode<Base>* i) {
+                return i->assignmentVariable() != nullptr;
+            });
+            free.erase(it, free.end());
+        }
+
+        for (Enode<Base>* i : queue_) {
+            set(layer_, i->index(), inf);
+        }
+        queue_.clear();
+
+        return assigned;
+    }
+
+protected:
+
+    /**
+     * Searches for an unassigned variable in an equation (derivative
+     * variables are preferred).
+     */
+    static inline Vnode<Base>* findUnassigned(const Enode<Base>& i) {
+        Vnode<Base>* algebraic = nullptr;
+        for (Vnode<Base>* jj : i.variables()) {
+            if (jj->assignmentEquation() == nullptr) {
+                if (jj->antiDerivative() != nullptr)
+                    return jj;
+                else if (algebraic == nullptr)
+                    algebraic = jj;
+            }
+        }
+        return algebraic;
+    }
+
+    inline size_t getLayer(const Enode<Base>& i) const {
+        return i.index() < layer_.size() ? layer_[i.index()] : std::numeric_limits<size_t>::max();
+    }
+
+    template<class T>
+    static inline void set(std::vector<T>& v,
+                           size_t index,
+                           const T& value) {
+        if (index >= v.size())
+            v.resize(index + 1, T());
+        v[index] = value;
+    }
+
+    static inline void set(std::vector<size_t>& v,
+                           size_t index,
+                           size_t value) {
+        if (index >= v.size())
+            v.resize(index + 1, std::numeric_limits<size_t>::max());
+        v[index] = value;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
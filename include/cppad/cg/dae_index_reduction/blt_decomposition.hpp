@@ -0,0 +1,147 @@
+#ifndef CPPAD_CG_BLT_DECOMPOSITION_INCLUDED
+#define CPPAD_CG_BLT_DECOMPOSITION_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+#include <cppad/cg/dae_index_reduction/dae_equation_info.hpp>
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Determines the block lower triangular (BLT) form of a system of equations
+ * using the strongly connected components (Tarjan's algorithm) of the
+ * graph where each equation depends on the equations assigned to the
+ * variables it uses.
+ *
+ * @param eqVars The variables used by each equation (one row per equation)
+ * @param assignedVar The variable assigned to each equation (a negative
+ *                    value if the equation is not assigned)
+ * @return The blocks of equation indexes in the order they must be solved
+ *         (each block only depends on itself and on previous blocks)
+ */
+inline std::vector<std::vector<size_t> > bltDecomposition(const SparsityPattern& eqVars,
+                                                          const std::vector<int>& assignedVar) {
+    const size_t n = eqVars.rows();
+    const size_t unvisited = std::numeric_limits<size_t>::max();
+
+    CPPADCG_ASSERT_KNOWN(assignedVar.size() == n, "Invalid assignment array size")
+
+    std::vector<size_t> var2Eq(eqVars.cols(), unvisited);
+    for (size_t i = 0; i < n; i++) {
+        if (assignedVar[i] >= 0) {
+            CPPADCG_ASSERT_KNOWN(size_t(assignedVar[i]) < eqVars.cols(), "Invalid assigned variable index")
+            CPPADCG_ASSERT_KNOWN(var2Eq[assignedVar[i]] == unvisited, "A variable cannot be assigned to more than one equation")
+            var2Eq[assignedVar[i]] = i;
+        }
+    }
+
+    std::vector<size_t> index(n, unvisited);
+    std::vector<size_t> low(n);
+    std::vector<bool> onStack(n, false);
+    std::vector<size_t> stack;
+
+    struct Frame {
+        size_t eq;
+        const size_t* var; // the next variable to visit
+    };
+    std::vector<Frame> calls;
+
+    std::vector<std::vector<size_t> > blocks;
+    size_t counter = 0;
+
+    auto visit = [&](size_t i) {
+        index[i] = low[i] = counter++;
+        stack.push_back(i);
+        onStack[i] = true;
+        calls.push_back(Frame{i, eqVars.begin(i)});
+    };
+
+    for (size_t s = 0; s < n; s++) {
+        if (index[s] != unvisited)
+            continue;
+
+        visit(s);
+
+        while (!calls.empty()) {
+            Frame& f = calls.back();
+            size_t i = f.eq;
+
+            if (f.var != eqVars.end(i)) {
+                size_t k = var2Eq[*f.var];
+                ++f.var;
+                if (k == unvisited || k == i)
+                    continue;
+
+                if (index[k] == unvisited) {
+                    visit(k); // f is no longer valid
+                } else if (onStack[k]) {
+                    low[i] = std::min(low[i], index[k]);
+                }
+                continue;
+            }
+
+            if (low[i] == index[i]) {
+                // a new block
+                blocks.emplace_back();
+                std::vector<size_t>& block = blocks.back();
+                size_t k;
+                do {
+                    k = stack.back();
+                    stack.pop_back();
+                    onStack[k] = false;
+                    block.push_back(k);
+                } while (k != i);
+                std::sort(block.begin(), block.end());
+            }
+
+            calls.pop_back();
+            if (!calls.empty()) {
+                size_t parent = calls.back().eq;
+                low[parent] = std::min(low[parent], low[i]);
+            }
+        }
+    }
+
+    return blocks;
+}
+
+/**
+ * Determines the block lower triangular (BLT) form of a DAE system
+ * (e.g. the model created by an index reduction algorithm).
+ *
+ * @param fun The DAE model
+ * @param eqInfo Equation related information (with the assigned variable
+ *               of each equation)
+ * @return The blocks of equation indexes in the order they must be solved
+ */
+template<class Base>
+inline std::vector<std::vector<size_t> > bltDecomposition(ADFun<CG<Base> >& fun,
+                                                          const std::vector<DaeEquationInfo>& eqInfo) {
+    CPPADCG_ASSERT_KNOWN(eqInfo.size() == fun.Range(), "Invalid equation information size")
+
+    std::vector<int> assignedVar(eqInfo.size());
+    for (size_t i = 0; i < eqInfo.size(); i++) {
+        assignedVar[i] = eqInfo[i].getAssignedVarIndex();
+    }
+
+    return bltDecomposition(jacobianSparsityPattern(fun), assignedVar);
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,596 @@
+#ifndef CPPAD_CG_DAE_BLOCK_C_SOURCE_GEN_INCLUDED
+#define CPPAD_CG_DAE_BLOCK_C_SOURCE_GEN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/dae_index_reduction/blt_decomposition.hpp>
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A block of equations of a DAE sorted into a block lower triangular form.
+ */
+struct DaeBlock {
+    /**
+     * The equations in this block (indexes in the DAE model)
+     */
+    std::vector<size_t> equations;
+    /**
+     * The tearing variables (indexes in the DAE model independent vector)
+     * which must be determined by a (Newton) solver.
+     * Empty if all the variables of the block are determined explicitly.
+     */
+    std::vector<size_t> tearVariables;
+    /**
+     * The equations which are used as residuals to determine the tearing
+     * variables (one per tearing variable)
+     */
+    std::vector<size_t> residualEquations;
+    /**
+     * The variables determined explicitly, in the order they are evaluated
+     * (indexes in the DAE model independent vector)
+     */
+    std::vector<size_t> explicitVariables;
+    /**
+     * The equations used to determine each explicit variable
+     */
+    std::vector<size_t> explicitEquations;
+    /**
+     * The variables read by the block (indexes in the DAE model independent
+     * vector) which define the independent vector of the block model: the
+     * tearing variables followed by the other variables used by the block
+     * equations (e.g. variables of previous blocks).
+     * Variables of constant blocks are not included since their values are
+     * used directly.
+     */
+    std::vector<size_t> inputVariables;
+
+    /**
+     * Whether or not all the variables in this block are determined
+     * explicitly
+     */
+    inline bool isExplicit() const {
+        return tearVariables.empty();
+    }
+
+    /**
+     * Whether or not this block does not read any variable (all its
+     * variables are constant and it does not have a model)
+     */
+    inline bool isConstant() const {
+        return inputVariables.empty();
+    }
+};
+
+/**
+ * Generates the source code for the simulation of a DAE system (e.g. a
+ * semi-explicit index-1 system created by an index reduction algorithm)
+ * sorted into blocks.
+ *
+ * The equations are sorted into the block lower triangular (BLT) form using
+ * the variable assigned to each equation. The variables of each block are
+ * determined, whenever possible, explicitly using symbolic manipulation
+ * (CodeHandler::solveFor()). The remaining variables of algebraic loops are
+ * torn so that only a few tearing variables must be determined by a solver.
+ *
+ * A model (ModelCSourceGen) is created for each block with the
+ * independent vector defined by the variables read by the block
+ * (DaeBlock::inputVariables) and the dependent vector:
+ *   - the residuals of the residual equations (for the tearing variables),
+ *   - the values of the explicit variables (in evaluation order).
+ *
+ * The explicit variables are computed using the tearing variable values
+ * provided in the independent vector. A sparse Jacobian is also generated
+ * for blocks with tearing variables with the derivatives of the residuals
+ * relative to the tearing variables only (the first elements of the block
+ * independent vector).
+ *
+ * Blocks which do not read any variable are constant: their values are
+ * determined during the generation and used directly by the next blocks,
+ * and no model is created for them.
+ *
+ * The blocks must be evaluated in order and the values of the variables
+ * of each block should be used to build the independent vectors of the
+ * next blocks.
+ */
+template<class Base>
+class DaeBlockCSourceGen {
+public:
+    using CGBase = CG<Base>;
+    using ADCG = AD<CGBase>;
+protected:
+    /**
+     * The DAE model
+     */
+    ADFun<CGBase>& fun_;
+    /**
+     * The equation information (with the assigned variables)
+     */
+    std::vector<DaeEquationInfo> eqInfo_;
+    /**
+     * The prefix for the name of the models
+     */
+    std::string name_;
+    /**
+     * Typical values for the independent variables
+     */
+    std::vector<Base> x_;
+    /**
+     * The sorted blocks
+     */
+    std::vector<DaeBlock> blocks_;
+    /**
+     * The tapes for each block
+     */
+    std::vector<std::unique_ptr<ADFun<CGBase> > > blockFuns_;
+    /**
+     * The source code generators for each block
+     */
+    std::vector<std::unique_ptr<ModelCSourceGen<Base> > > models_;
+    /**
+     * The values of the explicit variables of each constant block
+     */
+    std::vector<std::vector<Base> > constantValues_;
+    /**
+     * The values of the variables of constant blocks (indexes in the DAE
+     * model independent vector)
+     */
+    std::map<size_t, Base> constants_;
+public:
+
+    /**
+     * Creates a new source generator for a DAE system.
+     *
+     * @param fun The DAE model
+     * @param eqInfo Equation related information (every equation must have
+     *               an assigned variable)
+     * @param name The prefix for the name of the models of each block
+     *             (it must be a valid C function name)
+     */
+    DaeBlockCSourceGen(ADFun<CGBase>& fun,
+                       const std::vector<DaeEquationInfo>& eqInfo,
+                       std::string name) :
+        fun_(fun),
+        eqInfo_(eqInfo),
+        name_(std::move(name)) {
+        CPPADCG_ASSERT_KNOWN(eqInfo_.size() == fun_.Range(), "Invalid equation information size")
+    }
+
+    DaeBlockCSourceGen(const DaeBlockCSourceGen&) = delete;
+    DaeBlockCSourceGen& operator=(const DaeBlockCSourceGen&) = delete;
+
+    /**
+     * Defines typical values for the independent variables which are also
+     * provided to the models of each block.
+     *
+     * @param x The typical values
+     */
+    inline void setTypicalIndependentValues(const std::vector<Base>& x) {
+        CPPADCG_ASSERT_KNOWN(x.size() == 0 || x.size() == fun_.Domain(), "Invalid independent variable vector size")
+        x_ = x;
+    }
+
+    /**
+     * Provides the sorted blocks (only available after generate()).
+     */
+    inline const std::vector<DaeBlock>& getBlocks() const {
+        return blocks_;
+    }
+
+    /**
+     * Provides the tape of a block (only available after generate()).
+     * Constant blocks do not have a tape.
+     *
+     * @param block The block index
+     */
+    inline ADFun<CGBase>& getBlockFunction(size_t block) {
+        CPPADCG_ASSERT_KNOWN(block < blockFuns_.size(), "Invalid block index")
+        CPPADCG_ASSERT_KNOWN(blockFuns_[block] != nullptr, "Constant blocks do not have a tape")
+        return *blockFuns_[block];
+    }
+
+    /**
+     * Provides the values of the explicit variables of a constant block
+     * (only available after generate()).
+     *
+     * @param block The block index
+     */
+    inline const std::vector<Base>& getConstantValues(size_t block) const {
+        CPPADCG_ASSERT_KNOWN(block < constantValues_.size(), "Invalid block index")
+        CPPADCG_ASSERT_KNOWN(blocks_[block].isConstant(), "The block is not constant")
+        return constantValues_[block];
+    }
+
+    /**
+     * Provides the source code generators for each block which is not
+     * constant which can be added to a ModelLibraryCSourceGen (only
+     * available after generate()).
+     * The models are named <name>_block<index>.
+     */
+    inline std::vector<ModelCSourceGen<Base>*> getModels() const {
+        std::vector<ModelCSourceGen<Base>*> models;
+        for (const auto& m : models_) {
+            if (m != nullptr)
+                models.push_back(m.get());
+        }
+        return models;
+    }
+
+    /**
+     * Sorts the equations into blocks, tears the algebraic loops and
+     * creates the source code generators for each block.
+     *
+     * @throws CGException if an equation does not have an assigned variable
+     */
+    inline void generate() {
+        const size_t n = fun_.Domain();
+
+        std::vector<int> assignedVar(eqInfo_.size());
+        for (size_t i = 0; i < eqInfo_.size(); i++) {
+            int j = eqInfo_[i].getAssignedVarIndex();
+            if (j < 0 || size_t(j) >= n) {
+                throw CGException("Equation ", i, " does not have an assigned variable");
+            }
+            assignedVar[i] = j;
+        }
+
+        SparsityPattern eqVars = jacobianSparsityPattern(fun_);
+
+        std::vector<std::vector<size_t> > blocks = bltDecomposition(eqVars, assignedVar);
+
+        /**
+         * Generate an operation graph
+         */
+        CodeHandler<Base> handler;
+
+        std::vector<CGBase> indep0(n);
+        handler.makeVariables(indep0);
+        if (!x_.empty()) {
+            for (size_t j = 0; j < n; j++)
+                indep0[j].setValue(x_[j]);
+        }
+
+        const std::vector<CGBase> res0 = fun_.Forward(0, indep0);
+
+        blocks_.clear();
+        blockFuns_.clear();
+        models_.clear();
+        constantValues_.clear();
+        constants_.clear();
+        blocks_.reserve(blocks.size());
+
+        std::vector<bool> known(n, true);
+        for (size_t i = 0; i < assignedVar.size(); i++)
+            known[assignedVar[i]] = false;
+
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            blocks_.emplace_back();
+            DaeBlock& block = blocks_.back();
+            block.equations = blocks[b];
+
+            tearBlock(handler, indep0, res0, eqVars, assignedVar, known, block);
+
+            determineInputVariables(eqVars, block);
+
+            constantValues_.emplace_back();
+            if (block.isConstant()) {
+                determineConstants(handler, indep0, block);
+                blockFuns_.emplace_back();
+            } else {
+                createBlockFunction(handler, indep0, res0, block);
+            }
+
+            // undo the substitutions so that the next blocks use the variable values
+            for (auto it = block.explicitVariables.rbegin(); it != block.explicitVariables.rend(); ++it) {
+                handler.undoSubstituteIndependent(*indep0[*it].getOperationNode());
+            }
+
+            for (size_t i : block.equations)
+                known[assignedVar[i]] = true;
+
+            createModel(b, block);
+        }
+    }
+
+protected:
+
+    /**
+     * Determines which variables of a block can be computed explicitly and
+     * selects the tearing variables (the variable used in the most
+     * unresolved equations) when no more variables can be solved explicitly.
+     * The explicit variables remain substituted in the operation graph.
+     */
+    inline void tearBlock(CodeHandler<Base>& handler,
+                          std::vector<CGBase>& indep0,
+                          const std::vector<CGBase>& res0,
+                          const SparsityPattern& eqVars,
+                          const std::vector<int>& assignedVar,
+                          std::vector<bool>& known,
+                          DaeBlock& block) {
+        const std::vector<size_t>& eqs = block.equations;
+
+        std::vector<bool> resolved(eqs.size(), false);
+        size_t nResolved = 0;
+
+        auto tear = [&](size_t e) {
+            size_t i = eqs[e];
+            size_t j = assignedVar[i];
+            block.tearVariables.push_back(j);
+            block.residualEquations.push_back(i);
+            known[j] = true;
+            resolved[e] = true;
+            nResolved++;
+        };
+
+        while (nResolved < eqs.size()) {
+            bool progress = true;
+            while (progress) {
+                progress = false;
+
+                for (size_t e = 0; e < eqs.size(); ++e) {
+                    if (resolved[e])
+                        continue;
+
+                    size_t i = eqs[e];
+                    size_t j = assignedVar[i];
+
+                    bool ready = true;
+                    for (const size_t* v = eqVars.begin(i); v != eqVars.end(i); ++v) {
+                        if (*v != j && !known[*v]) {
+                            ready = false;
+                            break;
+                        }
+                    }
+                    if (!ready)
+                        continue;
+
+                    if (solve(handler, indep0[j], res0[i])) {
+                        block.explicitVariables.push_back(j);
+                        block.explicitEquations.push_back(i);
+                        known[j] = true;
+                        resolved[e] = true;
+                        nResolved++;
+                    } else {
+                        tear(e);
+                    }
+                    progress = true;
+                }
+            }
+
+            if (nResolved == eqs.size())
+                break;
+
+            /**
+             * select a tearing variable
+             */
+            std::map<size_t, size_t> usage;
+            for (size_t e = 0; e < eqs.size(); ++e) {
+                if (resolved[e])
+                    continue;
+                for (const size_t* v = eqVars.begin(eqs[e]); v != eqVars.end(eqs[e]); ++v) {
+                    if (!known[*v])
+                        usage[*v]++;
+                }
+            }
+
+            size_t best = eqs.size();
+            size_t bestUsage = 0;
+            for (size_t e = 0; e < eqs.size(); ++e) {
+                if (!resolved[e]) {
+                    size_t u = usage[assignedVar[eqs[e]]];
+                    if (best == eqs.size() || u > bestUsage) {
+                        best = e;
+                        bestUsage = u;
+                    }
+                }
+            }
+
+            tear(best);
+        }
+    }
+
+    /**
+     * Attempts to solve an equation for a variable by substituting the
+     * variable with its explicit expression.
+     *
+     * @return true if the substitution was performed
+     */
+    static inline bool solve(CodeHandler<Base>& handler,
+                             CGBase& indep,
+                             const CGBase& res) {
+        OperationNode<Base>* var = indep.getOperationNode();
+        OperationNode<Base>* expression = res.getOperationNode();
+        if (expression == nullptr || expression == var)
+            return false;
+
+        std::string name;
+        if (var->getName() != nullptr)
+            name = *var->getName();
+
+        if (!handler.isSolvable(*expression, *var))
+            return false;
+
+        try {
+            handler.substituteIndependent(*var, *expression, false); // indep not removed from the list of variables
+            return true;
+        } catch (const CGException&) {
+            if (var->getOperationType() == CGOpCode::Alias) {
+                handler.undoSubstituteIndependent(*var);
+            }
+            if (!name.empty())
+                var->setName(name);
+            return false;
+        }
+    }
+
+    /**
+     * Determines the variables read by a block: the tearing variables
+     * followed by the variables used by the block equations which are not
+     * computed explicitly in the block nor constant.
+     */
+    inline void determineInputVariables(const SparsityPattern& eqVars,
+                                        DaeBlock& block) const {
+        std::set<size_t> other;
+        for (size_t i : block.equations) {
+            other.insert(eqVars.begin(i), eqVars.end(i));
+        }
+        for (size_t j : block.tearVariables)
+            other.erase(j);
+        for (size_t j : block.explicitVariables)
+            other.erase(j);
+        for (const auto& c : constants_)
+            other.erase(c.first);
+
+        block.inputVariables = block.tearVariables;
+        block.inputVariables.insert(block.inputVariables.end(), other.begin(), other.end());
+    }
+
+    /**
+     * Creates the values for all the DAE variables used to evaluate the
+     * operation graph of a block: the typical values (or zero) and the
+     * values of the constant variables.
+     */
+    inline std::vector<ADCG> createFullIndependentVector(size_t n) const {
+        std::vector<ADCG> xAll(n);
+        if (!x_.empty()) {
+            for (size_t j = 0; j < n; j++)
+                xAll[j] = x_[j];
+        }
+        for (const auto& c : constants_)
+            xAll[c.first] = c.second;
+        return xAll;
+    }
+
+    /**
+     * Determines the values of the variables of a block which does not
+     * read any variable.
+     *
+     * @throws CGException if a value cannot be determined
+     */
+    inline void determineConstants(CodeHandler<Base>& handler,
+                                   const std::vector<CGBase>& indep0,
+                                   const DaeBlock& block) {
+        std::vector<CGBase> dep;
+        dep.reserve(block.explicitVariables.size());
+        for (size_t j : block.explicitVariables)
+            dep.push_back(indep0[j]);
+
+        std::vector<ADCG> xAll = createFullIndependentVector(indep0.size());
+
+        Evaluator<Base, CGBase> evaluator(handler);
+        std::vector<ADCG> y = evaluator.evaluate(xAll, dep);
+
+        std::vector<Base>& values = constantValues_.back();
+        values.resize(y.size());
+        for (size_t k = 0; k < y.size(); k++) {
+            CGBase v = CppAD::Value(y[k]);
+            if (!v.isValueDefined())
+                throw CGException("Failed to determine the value of the constant variable ", block.explicitVariables[k]);
+            values[k] = v.getValue();
+            constants_[block.explicitVariables[k]] = values[k];
+        }
+    }
+
+    /**
+     * Creates the tape of a block with the residuals of the residual
+     * equations followed by the explicit variables using only the
+     * variables read by the block as independent variables.
+     */
+    inline void createBlockFunction(CodeHandler<Base>& handler,
+                                    const std::vector<CGBase>& indep0,
+                                    const std::vector<CGBase>& res0,
+                                    const DaeBlock& block) {
+        std::vector<CGBase> dep;
+        dep.reserve(block.residualEquations.size() + block.explicitVariables.size());
+        for (size_t i : block.residualEquations)
+            dep.push_back(res0[i]);
+        for (size_t j : block.explicitVariables)
+            dep.push_back(indep0[j]);
+
+        const std::vector<size_t>& inputs = block.inputVariables;
+
+        std::vector<ADCG> x(inputs.size());
+        if (!x_.empty()) {
+            for (size_t k = 0; k < x.size(); k++)
+                x[k] = x_[inputs[k]];
+        }
+        CppAD::Independent(x);
+
+        // the remaining DAE variables are not used by the block
+        std::vector<ADCG> xAll = createFullIndependentVector(indep0.size());
+        for (size_t k = 0; k < inputs.size(); k++)
+            xAll[inputs[k]] = x[k];
+
+        Evaluator<Base, CGBase> evaluator(handler);
+        std::vector<ADCG> y = evaluator.evaluate(xAll, dep);
+
+        blockFuns_.emplace_back(new ADFun<CGBase>(x, y));
+    }
+
+    /**
+     * Creates the source code generator for a block.
+     */
+    inline void createModel(size_t b,
+                            const DaeBlock& block) {
+        if (block.isConstant()) {
+            models_.emplace_back();
+            return;
+        }
+
+        ADFun<CGBase>& blockFun = *blockFuns_[b];
+
+        models_.emplace_back(new ModelCSourceGen<Base>(blockFun, name_ + "_block" + std::to_string(b)));
+        ModelCSourceGen<Base>& model = *models_.back();
+
+        model.setCreateForwardZero(true);
+        if (!x_.empty()) {
+            std::vector<Base> x(block.inputVariables.size());
+            for (size_t k = 0; k < x.size(); k++)
+                x[k] = x_[block.inputVariables[k]];
+            model.setTypicalIndependentValues(x);
+        }
+
+        if (!block.isExplicit()) {
+            /**
+             * derivatives of the residuals relative to the tearing variables
+             * only (the first columns of the block model)
+             */
+            const size_t nt = block.tearVariables.size();
+            CppAD::sparse_rc<std::vector<size_t> > tearPattern(blockFun.Domain(), nt, nt);
+            for (size_t k = 0; k < nt; ++k)
+                tearPattern.set(k, k, k);
+
+            CppAD::sparse_rc<std::vector<size_t> > pattern;
+            blockFun.for_jac_sparsity(tearPattern, false, false, isBitsetSparsityPreferable(nt), pattern);
+
+            std::vector<size_t> rows, cols;
+            for (size_t e = 0; e < pattern.nnz(); ++e) {
+                if (pattern.row()[e] < block.residualEquations.size()) {
+                    rows.push_back(pattern.row()[e]);
+                    cols.push_back(pattern.col()[e]);
+                }
+            }
+
+            model.setCreateSparseJacobian(true);
+            model.setCustomSparseJacobianElements(rows, cols);
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
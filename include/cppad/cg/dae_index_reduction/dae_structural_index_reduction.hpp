@@ -17,6 +17,8 @@
 
 #include <cppad/cg/dae_index_reduction/dae_index_reduction.hpp>
 #include <cppad/cg/dae_index_reduction/bipartite_graph.hpp>
+#include <cppad/cg/dae_index_reduction/blt_decomposition.hpp>
+#include <cppad/cg/dae_index_reduction/dae_block_c_source_gen.hpp>
 
 namespace CppAD {
 namespace cg {
@@ -37,6 +37,7 @@ class DummyDerivatives : public DaeIndexReduction<Base> {
     using VectorB = Eigen::Matrix<Base, Eigen::Dynamic, 1>;
     using VectorCB = Eigen::Matrix<std::complex<Base>, Eigen::Dynamic, 1>;
     using MatrixB = Eigen::Matrix<Base, Eigen::Dynamic, Eigen::Dynamic>;
+    using SparseMatrixB = Eigen::SparseMatrix<Base, Eigen::RowMajor>;
 protected:
     /**
      * Method used to identify the structural index
@@ -98,6 +99,16 @@ protected:
      * Avoid using these variables as dummy derivatives
      */
     std::set<std::string> avoidAsDummy_;
+    /**
+     * The maximum number of elements (rows x columns) of a Jacobian block
+     * which is always factorized with a dense QR decomposition
+     */
+    size_t maxDenseSelectionSize_;
+    /**
+     * The maximum ratio of non-zero elements in a larger Jacobian block
+     * for it to be factorized with a sparse QR decomposition
+     */
+    double maxSparseSelectionDensity_;
 public:
 
     /**
@@ -125,7 +136,9 @@ public:
             reduceEquations_(true),
             generateSemiExplicitDae_(false),
             reorder_(true),
-            avoidConvertAlg2DifVars_(true) {
+            avoidConvertAlg2DifVars_(true),
+            maxDenseSelectionSize_(250000),
+            maxSparseSelectionDensity_(0.1) {
 
         for (Vnode<Base>* jj : idxIdentify.getGraph().variables()) {
             if (jj->antiDerivative() != nullptr) {
@@ -236,6 +249,46 @@ public:
         return avoidAsDummy_;
     }
 
+    /**
+     * The maximum number of elements (rows x columns) of a block of the
+     * Jacobian for which the dummy derivatives are always selected using a
+     * dense QR decomposition with column pivoting.
+     */
+    inline size_t getMaxDenseSelectionSize() const {
+        return maxDenseSelectionSize_;
+    }
+
+    /**
+     * Defines the maximum number of elements (rows x columns) of a block of
+     * the Jacobian for which the dummy derivatives are always selected using
+     * a dense QR decomposition with column pivoting.
+     * Larger blocks use a sparse rank-revealing QR decomposition if they
+     * are sufficiently sparse (see setMaxSparseSelectionDensity()).
+     */
+    inline void setMaxDenseSelectionSize(size_t maxSize) {
+        maxDenseSelectionSize_ = maxSize;
+    }
+
+    /**
+     * The maximum ratio of non-zero elements in a large block of the
+     * Jacobian for which the dummy derivatives are selected using a sparse
+     * rank-revealing QR decomposition.
+     */
+    inline double getMaxSparseSelectionDensity() const {
+        return maxSparseSelectionDensity_;
+    }
+
+    /**
+     * Defines the maximum ratio of non-zero elements in a large block of the
+     * Jacobian for which the dummy derivatives are selected using a sparse
+     * rank-revealing QR decomposition.
+     * The sparse decomposition prefers columns which reduce fill-in while the
+     * dense decomposition prefers the columns with the largest norm.
+     */
+    inline void setMaxSparseSelectionDensity(double density) {
+        maxSparseSelectionDensity_ = density;
+    }
+
     inline std::unique_ptr<ADFun<CG<Base>>> reduceIndex(std::vector<DaeVarInfo>& newVarInfo,
                                                         std::vector<DaeEquationInfo>& newEqInfo) override {
 
@@ -1399,23 +1452,31 @@ protected:
             return;
         }
 
+        /**
+         * The position of each variable in vars
+         */
+        std::vector<int> var2Col(jacobian_.cols(), -1);
+        for (size_t j = 0; j < vars.size(); j++) {
+            var2Col[vars[j]->index() - diffVarStart_] = int(j);
+        }
+
         /**
          * Determine the columns/variables that must be removed
          */
+        std::vector<bool> notZero(vars.size(), false);
+        for (Enode<Base>* ii : eqs) {
+            for (typename SparseMatrixB::InnerIterator it(jacobian_, ii->index() - diffEqStart_); it; ++it) {
+                int j = var2Col[it.col()];
+                if (j >= 0 && it.value() != Base(0.0)) {
+                    notZero[j] = true;
+                }
+            }
+        }
+
         std::set<size_t> excludeCols;
         std::set<size_t> avoidCols;
         for (size_t j = 0; j < vars.size(); j++) {
-            Vnode<Base>* jj = vars[j];
-            bool notZero = false;
-            for (size_t i = 0; i < eqs.size(); i++) {
-                Enode<Base>* ii = eqs[i];
-                Base val = jacobian_.coeff(ii->index() - diffEqStart_, jj->index() - diffVarStart_);
-                if (val != Base(0.0)) {
-                    notZero = true;
-                    break;
-                }
-            }
-            if (!notZero) {
+            if (!notZero[j]) {
                 // all zeros: must not choose this column/variable
                 excludeCols.insert(j);
             } else if (avoidAsDummy_.find(vars[j]->name()) != avoidAsDummy_.end()) {
@@ -1433,62 +1494,40 @@ protected:
         }
 
         std::vector<Vnode<Base>* > varsLocal;
-
-        Eigen::ColPivHouseholderQR<MatrixB> qr;
+        std::vector<size_t> pivots; // the columns of varsLocal sorted by the column pivoting
+        size_t rank = 0;
 
         auto orderColumns = [&]() {
             varsLocal.reserve(vars.size() - excludeCols.size());
+            std::vector<int> var2Local(jacobian_.cols(), -1);
             for (size_t j = 0; j < vars.size(); j++) {
                 if (excludeCols.find(j) == excludeCols.end()) {
+                    var2Local[vars[j]->index() - diffVarStart_] = int(varsLocal.size());
                     varsLocal.push_back(vars[j]);
                 }
             }
 
-
-            work.setZero(eqs.size(), varsLocal.size());
-
-            // determine the rows that only contain a single nonzero (a single column)
+            std::vector<Eigen::Triplet<Base> > elements;
             for (size_t i = 0; i < eqs.size(); i++) {
-                Enode<Base>* ii = eqs[i];
-                for (size_t j = 0; j < varsLocal.size(); j++) {
-                    const Vnode<Base>* jj = varsLocal[j];
-                    Base val = jacobian_.coeff(ii->index() - diffEqStart_, jj->index() - diffVarStart_);
-                    if (val != Base(0.0)) {
-                        work(i, j) = val;
+                for (typename SparseMatrixB::InnerIterator it(jacobian_, eqs[i]->index() - diffEqStart_); it; ++it) {
+                    int j = var2Local[it.col()];
+                    if (j >= 0 && it.value() != Base(0.0)) {
+                        elements.emplace_back(int(i), j, it.value());
                     }
                 }
             }
 
-            if (this->verbosity_ >= Verbosity::High)
-                log() << "subset Jac:\n" << work << "\n";
-
-            qr.compute(work);
-
-            if (qr.info() != Eigen::Success) {
-                throw CGException("Failed to select dummy derivatives! "
-                                  "QR decomposition of a submatrix of the Jacobian failed!");
-            } else if (qr.rank() < work.rows()) {
-                throw CGException("Failed to select dummy derivatives! "
-                                  "The resulting system is probably singular for the provided data.");
-            }
-
-            using PermutationMatrix = typename Eigen::ColPivHouseholderQR<MatrixB>::PermutationType;
-            using Indices = typename PermutationMatrix::IndicesType;
-
-            const PermutationMatrix& p = qr.colsPermutation();
-            const Indices& indices = p.indices();
+            size_t rows = eqs.size();
+            size_t cols = varsLocal.size();
+            double density = double(elements.size()) / double(std::max<size_t>(rows * cols, 1));
 
-            if (this->verbosity_ >= Verbosity::High) {
-                log() << "## matrix Q:\n";
-                MatrixB q = qr.matrixQ();
-                log() << q << "\n";
-                log() << "## matrix R:\n";
-                MatrixB r = qr.matrixR().template triangularView<Eigen::Upper>();
-                log() << r << "\n";
-                log() << "## matrix P: " << indices.transpose() << "\n";
+            if (rows * cols > maxDenseSelectionSize_ && density <= maxSparseSelectionDensity_) {
+                selectColumnsSparse(rows, cols, elements, pivots, rank);
+            } else {
+                selectColumnsDense(rows, cols, elements, work, pivots, rank);
             }
 
-            if (indices.size() < work.rows()) {
+            if (rank < rows || pivots.size() < rows) {
                 throw CGException("Failed to select dummy derivatives! "
                                   "The resulting system is probably singular for the provided data.");
             }
@@ -1513,17 +1552,14 @@ protected:
             orderColumns();
         }
 
-        const auto& p = qr.colsPermutation();
-        const auto& indices = p.indices();
-
         std::vector<Vnode<Base>* > newDummies;
         if (avoidConvertAlg2DifVars_) {
             auto& graph = idxIdentify_->getGraph();
             const auto& varInfo = graph.getOriginalVariableInfo();
 
             // add algebraic first
-            for (int i = 0; newDummies.size() < size_t(work.rows()) && i < qr.rank(); i++) {
-                Vnode<Base>* v = varsLocal[indices(i)];
+            for (size_t i = 0; newDummies.size() < eqs.size() && i < rank; i++) {
+                Vnode<Base>* v = varsLocal[pivots[i]];
                 CPPADCG_ASSERT_UNKNOWN(v->originalVariable() != nullptr);
                 size_t tape = v->originalVariable()->tapeIndex();
                 CPPADCG_ASSERT_UNKNOWN(tape < varInfo.size());
@@ -1533,8 +1569,8 @@ protected:
                 }
             }
             // add remaining
-            for (int i = 0; newDummies.size() < size_t(work.rows()); i++) {
-                Vnode<Base>* v = varsLocal[indices(i)];
+            for (size_t i = 0; newDummies.size() < eqs.size(); i++) {
+                Vnode<Base>* v = varsLocal[pivots[i]];
                 CPPADCG_ASSERT_UNKNOWN(v->originalVariable() != nullptr);
                 size_t tape = v->originalVariable()->tapeIndex();
                 CPPADCG_ASSERT_UNKNOWN(tape < varInfo.size());
@@ -1545,9 +1581,9 @@ protected:
             }
 
         } else {
-            // use order provided by the householder column pivoting
-            for (int i = 0; i < work.rows(); i++) {
-                newDummies.push_back(varsLocal[indices(i)]);
+            // use order provided by the column pivoting
+            for (size_t i = 0; i < eqs.size(); i++) {
+                newDummies.push_back(varsLocal[pivots[i]]);
             }
         }
 
@@ -1566,6 +1602,103 @@ protected:
         dummyD_.insert(dummyD_.end(), newDummies.begin(), newDummies.end());
     }
 
+    /**
+     * Sorts the columns of a subset of the Jacobian using a dense QR
+     * decomposition with column pivoting.
+     *
+     * @param rows the number of rows
+     * @param cols the number of columns
+     * @param elements the non-zero elements of the subset of the Jacobian
+     * @param work a work matrix
+     * @param pivots the column order provided by the column pivoting
+     * @param rank the numerical rank
+     */
+    inline void selectColumnsDense(size_t rows,
+                                   size_t cols,
+                                   const std::vector<Eigen::Triplet<Base> >& elements,
+                                   MatrixB& work,
+                                   std::vector<size_t>& pivots,
+                                   size_t& rank) {
+        work.setZero(rows, cols);
+        for (const auto& e : elements) {
+            work(e.row(), e.col()) = e.value();
+        }
+
+        if (this->verbosity_ >= Verbosity::High)
+            log() << "subset Jac:\n" << work << "\n";
+
+        Eigen::ColPivHouseholderQR<MatrixB> qr(work);
+
+        if (qr.info() != Eigen::Success) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "QR decomposition of a submatrix of the Jacobian failed!");
+        }
+
+        const auto& indices = qr.colsPermutation().indices();
+
+        if (this->verbosity_ >= Verbosity::High) {
+            log() << "## matrix Q:\n";
+            MatrixB q = qr.matrixQ();
+            log() << q << "\n";
+            log() << "## matrix R:\n";
+            MatrixB r = qr.matrixR().template triangularView<Eigen::Upper>();
+            log() << r << "\n";
+            log() << "## matrix P: " << indices.transpose() << "\n";
+        }
+
+        rank = qr.rank();
+        pivots.resize(indices.size());
+        for (size_t i = 0; i < pivots.size(); i++) {
+            pivots[i] = indices(i);
+        }
+    }
+
+    /**
+     * Sorts the columns of a subset of the Jacobian using a sparse
+     * rank-revealing QR decomposition (with a COLAMD fill-reducing ordering).
+     * Used for large blocks where a dense decomposition would be too
+     * expensive.
+     *
+     * @param rows the number of rows
+     * @param cols the number of columns
+     * @param elements the non-zero elements of the subset of the Jacobian
+     * @param pivots the column order provided by the column pivoting
+     * @param rank the numerical rank
+     */
+    inline void selectColumnsSparse(size_t rows,
+                                    size_t cols,
+                                    const std::vector<Eigen::Triplet<Base> >& elements,
+                                    std::vector<size_t>& pivots,
+                                    size_t& rank) {
+        using ColMajorMatrix = Eigen::SparseMatrix<Base, Eigen::ColMajor>;
+
+        if (this->verbosity_ >= Verbosity::High)
+            log() << "subset Jac: " << rows << "x" << cols << " with " << elements.size() << " non-zeros (sparse QR)\n";
+
+        ColMajorMatrix mat(rows, cols);
+        mat.setFromTriplets(elements.begin(), elements.end());
+        mat.makeCompressed();
+
+        Eigen::SparseQR<ColMajorMatrix, Eigen::COLAMDOrdering<int> > qr(mat);
+
+        if (qr.info() != Eigen::Success) {
+            throw CGException("Failed to select dummy derivatives! "
+                              "Sparse QR decomposition of a submatrix of the Jacobian failed!");
+        }
+
+        const auto& indices = qr.colsPermutation().indices();
+
+        if (this->verbosity_ >= Verbosity::High) {
+            log() << "## matrix P: " << indices.transpose() << "\n";
+        }
+
+        rank = qr.rank();
+        pivots.resize(indices.size());
+        for (size_t i = 0; i < pivots.size(); i++) {
+            pivots[i] = indices(i);
+        }
+    }
+
     inline static void printModel(std::ostream& out,
                                   CodeHandler<Base>& handler,
                                   const std::vector<CGBase>& res,
@@ -18,6 +18,7 @@
 
 #include <cppad/cg/dae_index_reduction/dae_structural_index_reduction.hpp>
 #include <cppad/cg/dae_index_reduction/augment_path_depth_lookahead.hpp>
+#include <cppad/cg/dae_index_reduction/augment_path_hopcroft_karp.hpp>
 
 namespace CppAD {
 namespace cg {
@@ -39,6 +40,8 @@ protected:
     bool reduced_;
     AugmentPathDepthLookahead<Base> defaultAugmentPath_;
     AugmentPath<Base>* augmentPath_;
+    // used to assign the original equations before the equation by equation search
+    AugmentPathHopcroftKarp<Base> initialMatching_;
 public:
 
     /**
@@ -72,7 +75,7 @@ public:
         return *augmentPath_;
     }
 
-    void setAugmentPath(AugmentPath<Base>& a) const {
+    void setAugmentPath(AugmentPath<Base>& a) {
         augmentPath_ = &a;
     }
 
@@ -85,6 +88,7 @@ public:
             log() << "########  Pantelides method  ########\n";
 
         augmentPath_->setLogger(*this);
+        initialMatching_.setLogger(*this);
 
         reduced_ = true;
 
@@ -116,14 +120,31 @@ protected:
         if (this->verbosity_ >= Verbosity::High)
             graph_.printDot(this->log());
 
+        /**
+         * initial assignment of the original equations (without the V-nodes
+         * with A!=0) which avoids one augmenting path search per equation
+         */
+        for (Vnode<Base>* jj : vnodes) {
+            if (!jj->isDeleted() && jj->derivative() != nullptr) {
+                jj->deleteNode(log(), this->verbosity_);
+            }
+        }
+
+        initialMatching_.maximumMatching(enodes);
+
         size_t Ndash = enodes.size();
         for (size_t k = 0; k < Ndash; k++) {
             Enode<Base>* i = enodes[k];
 
+            // the equation might have been differentiated while processing a previous equation
+            while (i->derivative() != nullptr) {
+                i = i->derivative();
+            }
+
             if (this->verbosity_ >= Verbosity::High)
                 log() << "Outer loop: equation k = " << *i << "\n";
 
-            bool pathfound = false;
+            bool pathfound = i->assignmentVariable() != nullptr;
             while (!pathfound) {
 
                 /**
@@ -18,6 +18,7 @@
 
 #include <cppad/cg/dae_index_reduction/dae_structural_index_reduction.hpp>
 #include <cppad/cg/dae_index_reduction/augment_path_depth_lookahead.hpp>
+#include <cppad/cg/dae_index_reduction/augment_path_hopcroft_karp.hpp>
 #include <cppad/cg/dae_index_reduction/augment_path_depth_lookahead_a.hpp>
 
 namespace CppAD {
@@ -48,6 +49,8 @@ protected:
     AugmentPathDepthLookaheadA<Base> defaultAugmentPathA_;
     AugmentPath<Base>* augmentPath_;
     AugmentPath<Base>* augmentPathA_;
+    // used to assign the equations to the highest order derivatives before the equation by equation search
+    AugmentPathHopcroftKarp<Base> initialMatching_;
 public:
 
     /**
@@ -83,7 +86,7 @@ public:
         return *augmentPath_;
     }
 
-    void setAugmentPath(AugmentPath<Base>& a) const {
+    void setAugmentPath(AugmentPath<Base>& a) {
         augmentPath_ = &a;
     }
 
@@ -125,6 +128,7 @@ public:
 
         augmentPath_->setLogger(*this);
         augmentPathA_->setLogger(*this);
+        initialMatching_.setLogger(*this);
 
         reduced_ = true;
 
@@ -175,6 +179,15 @@ protected:
             graph_.printDot(this->log());
 
         while (true) {
+            /**
+             * assign as many equations as possible to the highest order
+             * derivatives at once (the same variables used by augmentPathA_)
+             */
+            initialMatching_.maximumMatching(enodes, [](const Vnode<Base>& j) {
+                return j.derivative() == nullptr && // highest order derivative
+                       j.antiDerivative() != nullptr; // not an algebraic variable
+            });
+
             // augment the matching one by one
             for (size_t k = 0; k < enodes.size(); k++) {
                 Enode<Base>* i = enodes[k];
@@ -153,6 +153,9 @@ class FunctorGenericModel;
 template<class Base>
 class CCompiler;
 
+template<class Base>
+class AbstractCCompiler;
+
 template<class Base>
 class DynamicLib;
 
@@ -198,6 +201,8 @@ class SmartMapValuePointer;
 template<class Type>
 class ArrayView;
 
+class SparsityPattern;
+
 template<class Base>
 inline void print(const Base& v);
 
@@ -292,6 +297,23 @@ enum class JacobianADMode {
     Forward, Reverse, Automatic
 };
 
+/**
+ * The order of the elements of a sparse matrix in the arrays used by
+ * generated models
+ */
+enum class SparseMatrixLayout {
+    Custom, // the order of the sparsity pattern or of the user defined elements
+    CSR, // compressed sparse row (row-major with sorted column indexes)
+    CSC // compressed sparse column (column-major with sorted row indexes)
+};
+
+/**
+ * The elements of a symmetric matrix which should be provided
+ */
+enum class MatrixTriangle {
+    Full, Lower, Upper
+};
+
 /**
  * Index pattern types
  */
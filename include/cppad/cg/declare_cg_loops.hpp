@@ -131,10 +131,10 @@ inline void generateLoopForJacHes(ADFun<CG<Base> >& fun,
                                   const std::vector<CG<Base> >& x,
                                   const std::vector<std::vector<CG<Base> > >& vw,
                                   std::vector<CG<Base> >& y,
-                                  const std::vector<std::set<size_t> >& jacSparsity,
+                                  const SparsityPattern& jacSparsity,
                                   const std::vector<std::set<size_t> >& jacEvalSparsity,
                                   std::vector<std::map<size_t, CG<Base> > >& jac,
-                                  const std::vector<std::set<size_t> >& hesSparsity,
+                                  const SparsityPattern& hesSparsity,
                                   const std::vector<std::set<size_t> >& hesEvalSparsity,
                                   std::vector<std::map<size_t, std::map<size_t, CG<Base> > > >& vhess,
                                   bool constainsAtomics);
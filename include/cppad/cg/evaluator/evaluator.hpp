@@ -37,9 +37,11 @@ class EvaluatorBase;
  * pattern (CRTP). Therefore the default behaviour can be overridden without
  * the use of virtual methods.
  *
- * This class should not be instantiated directly.
+ * The operation graph is navigated using an explicit stack (the arguments
+ * of most operations are evaluated before the operation itself) so that
+ * long chains of operations do not exhaust the call stack.
  *
- * @todo implement nonrecursive algorithm (so that there will never be any stack limit issues)
+ * This class should not be instantiated directly.
  */
 template<class ScalarIn, class ScalarOut, class ActiveOut, class FinalEvaluatorType>
 class EvaluatorBase {
@@ -250,18 +252,62 @@ protected:
         // first evaluation of this node
         FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
 
+        /**
+         * The path is used as an explicit stack: the arguments which can be
+         * evaluated in advance are evaluated (depth first, in the order of
+         * the arguments) before the node itself, which avoids the recursion
+         * through evalArg() for long chains of operations.
+         */
+        const size_t startDepth = depth_;
+
         path_.push_back(OperationPathNode<ScalarIn>(&node, -1));
         depth_++;
 
-        ActiveOut result = thisOps.evalOperation(node);
+        while (depth_ > startDepth) {
+            OperationPathNode<ScalarIn>& current = path_.back();
+            OperationNode<ScalarIn>& currNode = *current.node;
+
+            if (thisOps.isArgumentPrefetchable(currNode)) {
+                const std::vector<Argument<ScalarIn> >& args = currNode.getArguments();
+                size_t a = current.argIndex + 1; // the initial argument index is -1
+                for (; a < args.size(); ++a) {
+                    OperationNode<ScalarIn>* arg = args[a].getOperation();
+                    if (arg != nullptr && evals_[*arg] == nullptr)
+                        break;
+                }
+
+                if (a < args.size()) {
+                    // evaluate this argument first
+                    current.argIndex = a;
+                    path_.push_back(OperationPathNode<ScalarIn>(args[a].getOperation(), -1));
+                    depth_++;
+                    continue;
+                }
+            }
 
-        // save it for reuse
-        ActiveOut* resultPtr = saveEvaluation(node, ActiveOut(result));
+            ActiveOut result = thisOps.evalOperation(currNode);
 
-        depth_--;
-        path_.pop_back();
+            // save it for reuse
+            saveEvaluation(currNode, ActiveOut(result));
 
-        return *resultPtr;
+            depth_--;
+            path_.pop_back();
+        }
+
+        return *evals_[node];
+    }
+
+    /**
+     * Whether or not all the arguments of an operation can be evaluated
+     * before the operation itself.
+     * Evaluators which do not evaluate every argument of an operation, or
+     * whose evaluation depends on the path to the operation, must return
+     * false for that operation (it will then evaluate its own arguments).
+     *
+     * @param node the operation
+     */
+    inline bool isArgumentPrefetchable(const OperationNode<ScalarIn>& node) const {
+        return false;
     }
 
     inline ActiveOut* saveEvaluation(const OperationNode<ScalarIn>& node,
@@ -684,6 +730,46 @@ protected:
     inline void processActiveOut(const NodeIn& node,
                                  ActiveOut& a) {
     }
+
+    /**
+     * The operations whose default implementation evaluates all their
+     * arguments with evalArg().
+     */
+    inline bool isArgumentPrefetchable(const NodeIn& node) const {
+        switch (node.getOperationType()) {
+            case CGOpCode::Assign:
+            case CGOpCode::Abs:
+            case CGOpCode::Acos:
+            case CGOpCode::Add:
+            case CGOpCode::Alias:
+            case CGOpCode::Asin:
+            case CGOpCode::Atan:
+            case CGOpCode::ComLt:
+            case CGOpCode::ComLe:
+            case CGOpCode::ComEq:
+            case CGOpCode::ComGe:
+            case CGOpCode::ComGt:
+            case CGOpCode::ComNe:
+            case CGOpCode::Cosh:
+            case CGOpCode::Cos:
+            case CGOpCode::Div:
+            case CGOpCode::Exp:
+            case CGOpCode::Log:
+            case CGOpCode::Mul:
+            case CGOpCode::Pow:
+            case CGOpCode::Sign:
+            case CGOpCode::Sinh:
+            case CGOpCode::Sin:
+            case CGOpCode::Sqrt:
+            case CGOpCode::Sub:
+            case CGOpCode::Tanh:
+            case CGOpCode::Tan:
+            case CGOpCode::UnMinus:
+                return true;
+            default:
+                return false;
+        }
+    }
 };
 
 /**
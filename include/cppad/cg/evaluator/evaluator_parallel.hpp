@@ -0,0 +1,329 @@
+#ifndef CPPAD_CG_EVALUATOR_PARALLEL_INCLUDED
+#define CPPAD_CG_EVALUATOR_PARALLEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Evaluates the operation graph of a code handler for a different set of
+ * independent variables and (possibly) data types using several threads.
+ *
+ * The dependent variables are split into groups which do not share any
+ * operation (other than the independent variables) and each group is
+ * evaluated by a different Evaluator in its own thread.
+ * The results are returned in the order of the original dependents.
+ *
+ * The operations of the output type must be safe to use from several
+ * threads simultaneously, e.g. plain Base values or CG<Base> variables
+ * from a different code handler for each worker (see evaluate()).
+ * CppAD::AD types are NOT supported unless CppAD was prepared for
+ * multi-threading.
+ * Graphs with atomic functions are always evaluated in a single thread.
+ * For this reason, the output type must always be explicitly defined.
+ *
+ * @tparam ActiveOut the output type (e.g. ScalarOut or CG<ScalarOut>)
+ */
+template<class ScalarIn, class ScalarOut, class ActiveOut>
+class ParallelEvaluator {
+protected:
+    using NodeIn = OperationNode<ScalarIn>;
+protected:
+    /**
+     * The original source code handler
+     */
+    CodeHandler<ScalarIn>& handler_;
+    /**
+     * The maximum number of threads (zero means the hardware concurrency)
+     */
+    size_t threads_;
+public:
+
+    /**
+     * @param handler The original source code handler
+     */
+    inline explicit ParallelEvaluator(CodeHandler<ScalarIn>& handler) :
+        handler_(handler),
+        threads_(0) {
+    }
+
+    inline virtual ~ParallelEvaluator() = default;
+
+    /**
+     * @return the maximum number of threads used to evaluate the operation
+     *         graph (zero means the number of concurrent threads supported
+     *         by the hardware)
+     */
+    inline size_t getThreadCount() const {
+        return threads_;
+    }
+
+    /**
+     * Defines the maximum number of threads used to evaluate the operation
+     * graph.
+     *
+     * @param threads the maximum number of threads (zero means the number of
+     *                concurrent threads supported by the hardware)
+     */
+    inline void setThreadCount(size_t threads) {
+        threads_ = threads;
+    }
+
+    /**
+     * Performs all the operations required to calculate the dependent
+     * variables with a (potentially) new data type.
+     * All the threads use the same independent variables.
+     *
+     * @param indepNew The new independent variables.
+     * @param depOld Dependent variable vector representing the operations that
+     *               are going to be executed to determine the new variables
+     *               (all variables must belong to the same code handler)
+     * @return The dependent variable values
+     * @throws CGException on error (such as an unhandled operation type)
+     */
+    inline std::vector<ActiveOut> evaluate(ArrayView<const ActiveOut> indepNew,
+                                           ArrayView<const CG<ScalarIn> > depOld) {
+        size_t nThreads = threads_ == 0 ? size_t(std::thread::hardware_concurrency()) : threads_;
+
+        std::vector<ArrayView<const ActiveOut> > workerIndep(std::max<size_t>(nThreads, 1), indepNew);
+
+        return evaluate(workerIndep, depOld, nullptr);
+    }
+
+    /**
+     * Performs all the operations required to calculate the dependent
+     * variables with a (potentially) new data type.
+     * Each worker thread uses its own set of independent variables which
+     * allows, for instance, the creation of CG<Base> variables in a
+     * different code handler for each thread.
+     *
+     * @param indepNew The new independent variables of each worker thread
+     *                 (its size defines the maximum number of threads).
+     * @param depOld Dependent variable vector representing the operations that
+     *               are going to be executed to determine the new variables
+     *               (all variables must belong to the same code handler)
+     * @param depWorker If not null, it will hold the index of the worker
+     *                  used to evaluate each dependent
+     *                  (parameters are associated with the first worker)
+     * @return The dependent variable values
+     * @throws CGException on error (such as an unhandled operation type)
+     */
+    inline std::vector<ActiveOut> evaluate(const std::vector<ArrayView<const ActiveOut> >& indepNew,
+                                           ArrayView<const CG<ScalarIn> > depOld,
+                                           std::vector<size_t>* depWorker = nullptr) {
+        if (indepNew.empty()) {
+            throw CGException("At least one set of independent variables is required.");
+        }
+
+        size_t m = depOld.size();
+        std::vector<ActiveOut> depNew(m);
+
+        if (depWorker != nullptr) {
+            depWorker->assign(m, 0);
+        }
+
+        /**
+         * determine the groups of dependents which do not share operations
+         */
+        std::vector<size_t> group(m); // the group of each dependent
+        std::vector<size_t> groupSize(m, 0); // number of operations in each group
+        bool atomic = false;
+        splitDependents(depOld, group, groupSize, atomic);
+
+        /**
+         * assign the groups to the workers (largest groups first)
+         */
+        std::vector<size_t> groups;
+        for (size_t i = 0; i < m; ++i) {
+            if (depOld[i].getOperationNode() != nullptr && group[i] == i)
+                groups.push_back(i);
+        }
+        std::stable_sort(groups.begin(), groups.end(), [&groupSize](size_t a, size_t b) {
+            return groupSize[a] > groupSize[b];
+        });
+
+        size_t nWorkers = atomic ? 1 : std::min(indepNew.size(), groups.size());
+        nWorkers = std::max<size_t>(nWorkers, 1);
+
+        std::vector<size_t> group2Worker(m, 0);
+        std::vector<size_t> load(nWorkers, 0);
+        for (size_t g : groups) {
+            size_t w = std::min_element(load.begin(), load.end()) - load.begin();
+            group2Worker[g] = w;
+            load[w] += groupSize[g];
+        }
+
+        std::vector<std::vector<size_t> > workerDeps(nWorkers);
+        for (size_t i = 0; i < m; ++i) {
+            if (depOld[i].getOperationNode() == nullptr) {
+                depNew[i] = ActiveOut(depOld[i].getValue()); // parameter
+            } else {
+                size_t w = group2Worker[group[i]];
+                workerDeps[w].push_back(i);
+                if (depWorker != nullptr)
+                    (*depWorker)[i] = w;
+            }
+        }
+
+        /**
+         * evaluate
+         */
+        // the evaluators must be created before starting the threads (they are registered in the handler)
+        std::vector<std::unique_ptr<Evaluator<ScalarIn, ScalarOut, ActiveOut> > > evaluators(nWorkers);
+        for (auto& e : evaluators) {
+            e.reset(new Evaluator<ScalarIn, ScalarOut, ActiveOut>(handler_));
+        }
+
+        auto evalWorker = [&](size_t w) {
+            const std::vector<size_t>& deps = workerDeps[w];
+            if (deps.empty())
+                return;
+
+            std::vector<CG<ScalarIn> > depOldW(deps.size());
+            for (size_t e = 0; e < deps.size(); ++e) {
+                depOldW[e] = depOld[deps[e]];
+            }
+
+            std::vector<ActiveOut> depNewW = evaluators[w]->evaluate(indepNew[w], depOldW);
+
+            for (size_t e = 0; e < deps.size(); ++e) {
+                depNew[deps[e]] = std::move(depNewW[e]);
+            }
+        };
+
+        if (nWorkers == 1) {
+            evalWorker(0);
+            return depNew;
+        }
+
+        std::vector<std::exception_ptr> errors(nWorkers);
+        std::vector<std::thread> workers;
+        workers.reserve(nWorkers);
+
+        for (size_t w = 0; w < nWorkers; w++) {
+            workers.emplace_back([&, w]() {
+                try {
+                    evalWorker(w);
+                } catch (...) {
+                    errors[w] = std::current_exception();
+                }
+            });
+        }
+
+        for (auto& t : workers) {
+            t.join();
+        }
+
+        for (const auto& e : errors) {
+            if (e) {
+                std::rethrow_exception(e);
+            }
+        }
+
+        return depNew;
+    }
+
+protected:
+
+    /**
+     * Groups the dependents which share operations (other than the
+     * independent variables).
+     *
+     * @param depOld the dependent variables
+     * @param group the group of each dependent (the index of one of the
+     *              dependents in the group)
+     * @param groupSize the number of operations of each group
+     * @param atomic whether or not atomic functions are used
+     */
+    inline void splitDependents(ArrayView<const CG<ScalarIn> > depOld,
+                                std::vector<size_t>& group,
+                                std::vector<size_t>& groupSize,
+                                bool& atomic) const {
+        size_t m = depOld.size();
+        for (size_t i = 0; i < m; ++i) {
+            group[i] = i;
+        }
+
+        // union-find
+        auto find = [&group](size_t i) {
+            while (group[i] != i) {
+                group[i] = group[group[i]];
+                i = group[i];
+            }
+            return i;
+        };
+
+        CodeHandlerVector<ScalarIn, size_t> owner(handler_); // dependent index + 1
+        owner.adjustSize();
+        owner.fill(0);
+
+        std::vector<NodeIn*> stack;
+
+        for (size_t i = 0; i < m; ++i) {
+            NodeIn* root = depOld[i].getOperationNode();
+            if (root == nullptr)
+                continue;
+
+            if (root->getCodeHandler() != &handler_) {
+                throw CGException("All dependent variables must belong to the same code handler.");
+            }
+
+            stack.push_back(root);
+            while (!stack.empty()) {
+                NodeIn& node = *stack.back();
+                stack.pop_back();
+
+                if (node.getOperationType() == CGOpCode::Inv)
+                    continue; // never modified (can be shared)
+
+                size_t o = owner[node];
+                if (o != 0) {
+                    // already visited
+                    size_t g1 = find(o - 1);
+                    size_t g2 = find(i);
+                    if (g1 != g2) {
+                        group[g1] = g2;
+                        groupSize[g2] += groupSize[g1];
+                    }
+                    continue;
+                }
+
+                owner[node] = i + 1;
+                groupSize[find(i)]++;
+
+                CGOpCode op = node.getOperationType();
+                if (op == CGOpCode::AtomicForward || op == CGOpCode::AtomicReverse) {
+                    atomic = true;
+                }
+
+                for (const Argument<ScalarIn>& a : node.getArguments()) {
+                    if (a.getOperation() != nullptr)
+                        stack.push_back(a.getOperation());
+                }
+            }
+        }
+
+        for (size_t i = 0; i < m; ++i) {
+            group[i] = find(i);
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
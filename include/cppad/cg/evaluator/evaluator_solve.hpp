@@ -188,6 +188,15 @@ protected:
         return CG<Scalar>(node); // use original
     }
 
+    /**
+     * Only some of the arguments are cloned and the replacements depend on
+     * the path to each operation: the arguments are always evaluated by
+     * the operation itself.
+     */
+    inline bool isArgumentPrefetchable(const OperationNode<Scalar>& node) const {
+        return false;
+    }
+
 private:
     inline bool isOnPath(const SourceCodePath& path) const {
         size_t d = this->depth_ - 1;
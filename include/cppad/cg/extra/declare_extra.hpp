@@ -61,6 +61,8 @@ size_t sparseForJacHessian(ADFun<Base>& fun,
                            VectorVectorBase& hes,
                            SparseForjacHessianWork& work);
 
+class SparsityPattern;
+
 /***********************************************************************
  * Sparsity evaluation
  **********************************************************************/
@@ -83,6 +85,15 @@ inline VectorBool jacobianSparsity(ADFun<Base>& fun);
 template<class VectorSet, class Base>
 inline VectorSet jacobianSparsitySet(ADFun<Base>& fun);
 
+inline bool isBitsetSparsityPreferable(size_t q);
+
+template<class Base>
+inline SparsityPattern jacobianSparsityPattern(ADFun<Base>& fun,
+                                               bool internalBool);
+
+template<class Base>
+inline SparsityPattern jacobianSparsityPattern(ADFun<Base>& fun);
+
 inline bool estimateBestJacobianADMode(const std::vector<size_t>& jacRows,
                                        const std::vector<size_t>& jacCols);
 
@@ -99,6 +110,38 @@ template<class VectorSet, class Base>
 inline VectorSet hessianSparsitySet(ADFun<Base>& fun,
                                     bool transpose = false);
 
+template<class Base>
+inline SparsityPattern hessianSparsityPattern(ADFun<Base>& fun,
+                                              const std::vector<bool>& selectDomain,
+                                              const std::vector<bool>& selectRange,
+                                              bool internalBool);
+
+template<class Base>
+inline SparsityPattern hessianSparsityPattern(ADFun<Base>& fun);
+
+template<class Base>
+inline SparsityPattern hessianSparsityPattern(ADFun<Base>& fun,
+                                              const std::set<size_t>& eqs);
+
+template<class Base>
+inline void sparseJacobianElements(ADFun<Base>& fun,
+                                   const std::vector<Base>& x,
+                                   const SparsityPattern& sparsity,
+                                   const std::vector<size_t>& row,
+                                   const std::vector<size_t>& col,
+                                   std::vector<Base>& jac,
+                                   bool forward);
+
+template<class Base>
+inline void sparseHessianElements(ADFun<Base>& fun,
+                                  const std::vector<Base>& x,
+                                  const std::vector<Base>& w,
+                                  const SparsityPattern& sparsity,
+                                  const std::vector<size_t>& row,
+                                  const std::vector<size_t>& col,
+                                  std::vector<Base>& hess,
+                                  const std::string& coloring = "cppad.symmetric");
+
 template<class VectorBool, class Base>
 inline VectorBool hessianSparsity(ADFun<Base>& fun,
                                   size_t i,
@@ -129,6 +172,19 @@ template<class VectorSet, class VectorSize>
 inline void generateSparsitySet(const VectorSize& row,
                                 const VectorSize& col,
                                 VectorSet& sparsity);
+
+inline void selectSparsityTriangle(std::vector<size_t>& row,
+                                   std::vector<size_t>& col,
+                                   MatrixTriangle triangle);
+
+inline void sortSparsityIndexes(std::vector<size_t>& row,
+                                std::vector<size_t>& col,
+                                SparseMatrixLayout layout);
+
+inline bool compressSparsityIndexes(size_t nMajor,
+                                    const std::vector<size_t>& major,
+                                    const std::vector<size_t>& minor,
+                                    std::vector<size_t>& start);
 }
 }
 
@@ -107,6 +107,85 @@ inline VectorSet jacobianSparsitySet(ADFun<Base>& fun) {
     }
 }
 
+/**
+ * Determines whether or not CppAD should use packed bit sets (instead of
+ * lists of sets) for the propagation of a sparsity pattern.
+ * Bit sets require q bits for each variable in the tape and are only
+ * preferable when the number of propagated columns is small.
+ *
+ * @param q the number of columns in the propagated sparsity pattern
+ */
+inline bool isBitsetSparsityPreferable(size_t q) {
+    return q <= 64; // at most a single word for each variable
+}
+
+/**
+ * Creates a diagonal CppAD sparsity pattern.
+ *
+ * @param n the number of rows and columns
+ * @param select the diagonal elements to include (all if empty)
+ */
+inline CppAD::sparse_rc<std::vector<size_t> > diagonalSparsityPattern(size_t n,
+                                                                      const std::vector<bool>& select = std::vector<bool>()) {
+    CPPADCG_ASSERT_KNOWN(select.empty() || select.size() == n, "Invalid selection size")
+
+    size_t nnz = n;
+    if (!select.empty())
+        nnz = std::count(select.begin(), select.end(), true);
+
+    CppAD::sparse_rc<std::vector<size_t> > pattern(n, n, nnz);
+    size_t e = 0;
+    for (size_t j = 0; j < n; j++) {
+        if (select.empty() || select[j])
+            pattern.set(e++, j, j);
+    }
+    return pattern;
+}
+
+/**
+ * Determines the Jacobian sparsity for a model using a compressed
+ * representation.
+ *
+ * @param fun The model
+ * @param internalBool whether or not CppAD should use packed bit sets
+ *                     for its internal computations (preferable for
+ *                     dense-ish patterns)
+ * @return The Jacobian sparsity
+ */
+template<class Base>
+inline SparsityPattern jacobianSparsityPattern(ADFun<Base>& fun,
+                                               bool internalBool) {
+    size_t m = fun.Range();
+    size_t n = fun.Domain();
+
+    const bool transpose = false;
+    const bool dependency = false;
+    CppAD::sparse_rc<std::vector<size_t> > pattern;
+
+    if (n <= m) {
+        // use forward mode
+        fun.for_jac_sparsity(diagonalSparsityPattern(n), transpose, dependency, internalBool, pattern);
+    } else {
+        // use reverse mode
+        fun.rev_jac_sparsity(diagonalSparsityPattern(m), transpose, dependency, internalBool, pattern);
+    }
+
+    return SparsityPattern::fromSparseRc(pattern);
+}
+
+/**
+ * Determines the Jacobian sparsity for a model using a compressed
+ * representation.
+ *
+ * @param fun The model
+ * @return The Jacobian sparsity
+ */
+template<class Base>
+inline SparsityPattern jacobianSparsityPattern(ADFun<Base>& fun) {
+    size_t q = std::min(fun.Range(), fun.Domain());
+    return jacobianSparsityPattern(fun, isBitsetSparsityPreferable(q));
+}
+
 /**
  * Estimates the work load of forward vs reverse mode for the evaluation of
  * a Jacobian
@@ -185,6 +264,157 @@ inline VectorSet hessianSparsitySet(ADFun<Base>& fun, bool transpose = false) {
     return hessianSparsitySet<VectorSet, Base>(fun, w, transpose);
 }
 
+/**
+ * Determines the sparsity of the sum of the Hessians of some dependent
+ * variables using a compressed representation.
+ *
+ * @param fun The model
+ * @param selectDomain the independent variables to consider (all if empty),
+ *                     the rows and columns of the other variables are empty
+ * @param selectRange the dependent variables whose Hessians are added
+ * @param internalBool whether or not CppAD should use packed bit sets
+ *                     for its internal computations (preferable for
+ *                     dense-ish patterns)
+ * @return The Hessian sparsity
+ */
+template<class Base>
+inline SparsityPattern hessianSparsityPattern(ADFun<Base>& fun,
+                                              const std::vector<bool>& selectDomain,
+                                              const std::vector<bool>& selectRange,
+                                              bool internalBool) {
+    size_t n = fun.Domain();
+
+    CPPADCG_ASSERT_KNOWN(selectRange.size() == fun.Range(), "Invalid range selection size")
+
+    const bool transpose = false;
+    const bool dependency = false;
+
+    CppAD::sparse_rc<std::vector<size_t> > jacPattern;
+    fun.for_jac_sparsity(diagonalSparsityPattern(n, selectDomain), transpose, dependency, internalBool, jacPattern);
+
+    CppAD::sparse_rc<std::vector<size_t> > hesPattern;
+    fun.rev_hes_sparsity(selectRange, transpose, internalBool, hesPattern);
+
+    return SparsityPattern::fromSparseRc(hesPattern);
+}
+
+/**
+ * Determines the sparsity of the sum of the Hessians of all the dependent
+ * variables using a compressed representation.
+ *
+ * @param fun The model
+ * @return The Hessian sparsity
+ */
+template<class Base>
+inline SparsityPattern hessianSparsityPattern(ADFun<Base>& fun) {
+    std::vector<bool> selectRange(fun.Range(), true);
+    return hessianSparsityPattern(fun, std::vector<bool>(), selectRange,
+                                  isBitsetSparsityPreferable(fun.Domain()));
+}
+
+/**
+ * Determines the sparsity of the sum of the Hessians of some of the
+ * dependent variables using a compressed representation.
+ *
+ * @param fun The model
+ * @param eqs the dependent variables whose Hessians are added
+ * @return The Hessian sparsity
+ */
+template<class Base>
+inline SparsityPattern hessianSparsityPattern(ADFun<Base>& fun,
+                                              const std::set<size_t>& eqs) {
+    std::vector<bool> selectRange(fun.Range(), false);
+    for (size_t i : eqs) {
+        selectRange[i] = true;
+    }
+    return hessianSparsityPattern(fun, std::vector<bool>(), selectRange,
+                                  isBitsetSparsityPreferable(fun.Domain()));
+}
+
+/**
+ * Evaluates some of the elements of a sparse Jacobian.
+ *
+ * @param fun The model
+ * @param x the independent variable values
+ * @param sparsity the Jacobian sparsity pattern
+ * @param row the row index of each requested element (must be part of the
+ *            sparsity pattern)
+ * @param col the column index of each requested element (must be part of
+ *            the sparsity pattern)
+ * @param jac the values of the requested elements
+ * @param forward whether or not to use forward mode (reverse mode otherwise)
+ */
+template<class Base>
+inline void sparseJacobianElements(ADFun<Base>& fun,
+                                   const std::vector<Base>& x,
+                                   const SparsityPattern& sparsity,
+                                   const std::vector<size_t>& row,
+                                   const std::vector<size_t>& col,
+                                   std::vector<Base>& jac,
+                                   bool forward) {
+    CPPADCG_ASSERT_KNOWN(row.size() == col.size(), "The number of row and column indexes must be the same")
+
+    CppAD::sparse_rc<std::vector<size_t> > subsetPattern(fun.Range(), fun.Domain(), row.size());
+    for (size_t e = 0; e < row.size(); e++) {
+        subsetPattern.set(e, row[e], col[e]);
+    }
+    CppAD::sparse_rcv<std::vector<size_t>, std::vector<Base> > subset(subsetPattern);
+
+    const CppAD::sparse_rc<std::vector<size_t> > pattern = sparsity.toSparseRc();
+
+    CppAD::sparse_jac_work work; // temporary structure for CPPAD
+    if (forward) {
+        size_t groupMax = 1; // a single direction per forward sweep
+        fun.sparse_jac_for(groupMax, x, subset, pattern, "cppad", work);
+    } else {
+        fun.sparse_jac_rev(x, subset, pattern, "cppad", work);
+    }
+
+    jac = subset.val();
+}
+
+/**
+ * Evaluates some of the elements of the sparse Hessian of a weighted sum
+ * of the dependent variables.
+ *
+ * @param fun The model
+ * @param x the independent variable values
+ * @param w the weight of each dependent variable
+ * @param sparsity the Hessian sparsity pattern
+ * @param row the row index of each requested element (must be part of the
+ *            sparsity pattern)
+ * @param col the column index of each requested element (must be part of
+ *            the sparsity pattern)
+ * @param hess the values of the requested elements
+ * @param coloring the CppAD coloring method
+ */
+template<class Base>
+inline void sparseHessianElements(ADFun<Base>& fun,
+                                  const std::vector<Base>& x,
+                                  const std::vector<Base>& w,
+                                  const SparsityPattern& sparsity,
+                                  const std::vector<size_t>& row,
+                                  const std::vector<size_t>& col,
+                                  std::vector<Base>& hess,
+                                  const std::string& coloring) {
+    CPPADCG_ASSERT_KNOWN(row.size() == col.size(), "The number of row and column indexes must be the same")
+
+    size_t n = fun.Domain();
+
+    CppAD::sparse_rc<std::vector<size_t> > subsetPattern(n, n, row.size());
+    for (size_t e = 0; e < row.size(); e++) {
+        subsetPattern.set(e, row[e], col[e]);
+    }
+    CppAD::sparse_rcv<std::vector<size_t>, std::vector<Base> > subset(subsetPattern);
+
+    const CppAD::sparse_rc<std::vector<size_t> > pattern = sparsity.toSparseRc();
+
+    CppAD::sparse_hes_work work; // temporary structure for CPPAD
+    fun.sparse_hes(x, w, subset, pattern, coloring, work);
+
+    hess = subset.val();
+}
+
 /**
  * Determines the hessian sparsity for a given dependent variable/equation
  * in a model
@@ -308,6 +538,116 @@ inline void generateSparsitySet(const VectorSize& row,
     }
 }
 
+/**
+ * Keeps only the elements of a symmetric matrix in a triangle.
+ * Elements in the other triangle are replaced by their symmetric element
+ * and repeated elements are removed (the first occurrence is kept).
+ *
+ * @param row the row index of each element
+ * @param col the column index of each element
+ * @param triangle the elements to keep
+ */
+inline void selectSparsityTriangle(std::vector<size_t>& row,
+                                   std::vector<size_t>& col,
+                                   MatrixTriangle triangle) {
+    CPPADCG_ASSERT_UNKNOWN(row.size() == col.size())
+
+    if (triangle == MatrixTriangle::Full)
+        return;
+
+    std::set<std::pair<size_t, size_t> > added;
+
+    size_t nnz = 0;
+    for (size_t e = 0; e < row.size(); e++) {
+        size_t i = row[e];
+        size_t j = col[e];
+        if ((triangle == MatrixTriangle::Lower) == (i < j)) {
+            std::swap(i, j);
+        }
+
+        if (added.insert(std::make_pair(i, j)).second) {
+            row[nnz] = i;
+            col[nnz] = j;
+            nnz++;
+        }
+    }
+
+    row.resize(nnz);
+    col.resize(nnz);
+}
+
+/**
+ * Sorts the elements of a sparse matrix according to a layout.
+ *
+ * @param row the row index of each element
+ * @param col the column index of each element
+ * @param layout the new element order (nothing is done for
+ *               SparseMatrixLayout::Custom)
+ */
+inline void sortSparsityIndexes(std::vector<size_t>& row,
+                                std::vector<size_t>& col,
+                                SparseMatrixLayout layout) {
+    CPPADCG_ASSERT_UNKNOWN(row.size() == col.size())
+
+    if (layout == SparseMatrixLayout::Custom)
+        return;
+
+    const std::vector<size_t>& major = layout == SparseMatrixLayout::CSR ? row : col;
+    const std::vector<size_t>& minor = layout == SparseMatrixLayout::CSR ? col : row;
+
+    std::vector<size_t> order(row.size());
+    for (size_t e = 0; e < order.size(); e++)
+        order[e] = e;
+
+    std::stable_sort(order.begin(), order.end(), [&](size_t e1, size_t e2) {
+        return major[e1] < major[e2] || (major[e1] == major[e2] && minor[e1] < minor[e2]);
+    });
+
+    std::vector<size_t> newRow(row.size()), newCol(col.size());
+    for (size_t e = 0; e < order.size(); e++) {
+        newRow[e] = row[order[e]];
+        newCol[e] = col[order[e]];
+    }
+
+    row.swap(newRow);
+    col.swap(newCol);
+}
+
+/**
+ * Creates the position of the first element of each row (CSR) or column
+ * (CSC) of a sparse matrix whose elements are already sorted.
+ *
+ * @param nMajor the number of rows (CSR) or columns (CSC)
+ * @param major the row (CSR) or column (CSC) index of each element
+ * @param minor the column (CSR) or row (CSC) index of each element
+ * @param start the position of the first element of each row/column
+ *              (size nMajor + 1)
+ * @return false if the elements are not sorted according to the requested
+ *         layout
+ */
+inline bool compressSparsityIndexes(size_t nMajor,
+                                    const std::vector<size_t>& major,
+                                    const std::vector<size_t>& minor,
+                                    std::vector<size_t>& start) {
+    CPPADCG_ASSERT_UNKNOWN(major.size() == minor.size())
+
+    start.assign(nMajor + 1, 0);
+
+    for (size_t e = 0; e < major.size(); e++) {
+        if (major[e] >= nMajor)
+            return false;
+        if (e > 0 && (major[e] < major[e - 1] || (major[e] == major[e - 1] && minor[e] <= minor[e - 1])))
+            return false;
+        start[major[e] + 1]++;
+    }
+
+    for (size_t i = 0; i < nMajor; i++) {
+        start[i + 1] += start[i];
+    }
+
+    return true;
+}
+
 } // END cg namespace
 } // END CppAD namespace
 
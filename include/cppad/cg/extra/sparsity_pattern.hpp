@@ -0,0 +1,334 @@
+#ifndef CPPAD_CG_SPARSITY_PATTERN_INCLUDED
+#define CPPAD_CG_SPARSITY_PATTERN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A sparsity pattern in the compressed sparse row (CSR) format.
+ * The column indexes of each row are sorted and unique.
+ * Only one index is stored for each non-zero element (plus one for each
+ * row) which makes it much more compact than a std::vector<std::set<size_t> >
+ * for large patterns.
+ *
+ * @author Joao Leal
+ */
+class SparsityPattern {
+private:
+    /// number of rows
+    size_t _nr;
+    /// number of columns
+    size_t _nc;
+    /// the position in _col of the first element of each row (size _nr + 1)
+    std::vector<size_t> _rowStart;
+    /// the column index of each non-zero element
+    std::vector<size_t> _col;
+public:
+
+    inline SparsityPattern() :
+        _nr(0),
+        _nc(0),
+        _rowStart(1, 0) {
+    }
+
+    /**
+     * Creates an empty sparsity pattern (without non-zero elements).
+     *
+     * @param nr the number of rows
+     * @param nc the number of columns
+     */
+    inline SparsityPattern(size_t nr,
+                           size_t nc) :
+        _nr(nr),
+        _nc(nc),
+        _rowStart(nr + 1, 0) {
+    }
+
+    /**
+     * Creates a sparsity pattern from the row and column indexes of the
+     * non-zero elements.
+     * The elements can be provided in any order and duplicates are ignored.
+     *
+     * @param nr the number of rows
+     * @param nc the number of columns
+     * @param row the row index of each non-zero element
+     * @param col the column index of each non-zero element
+     * @param nnz the number of elements in row and col
+     */
+    template<class VectorSize, class VectorSize2>
+    inline SparsityPattern(size_t nr,
+                           size_t nc,
+                           const VectorSize& row,
+                           const VectorSize2& col,
+                           size_t nnz) :
+        _nr(nr),
+        _nc(nc),
+        _rowStart(nr + 1, 0),
+        _col(nnz) {
+
+        // count the elements in each row
+        for (size_t e = 0; e < nnz; e++) {
+            CPPADCG_ASSERT_KNOWN(size_t(row[e]) < _nr, "Invalid sparsity pattern row index")
+            CPPADCG_ASSERT_KNOWN(size_t(col[e]) < _nc, "Invalid sparsity pattern column index")
+            _rowStart[row[e] + 1]++;
+        }
+
+        for (size_t i = 0; i < _nr; i++) {
+            _rowStart[i + 1] += _rowStart[i];
+        }
+
+        // place the elements (counting sort by row)
+        std::vector<size_t> next(_rowStart.begin(), _rowStart.end() - 1);
+        for (size_t e = 0; e < nnz; e++) {
+            _col[next[row[e]]++] = col[e];
+        }
+
+        // sort each row and remove duplicates
+        size_t pos = 0;
+        for (size_t i = 0; i < _nr; i++) {
+            auto begin = _col.begin() + _rowStart[i];
+            auto end = _col.begin() + _rowStart[i + 1];
+            std::sort(begin, end);
+            end = std::unique(begin, end);
+
+            size_t rowNnz = end - begin;
+            std::copy(begin, end, _col.begin() + pos);
+            _rowStart[i] = pos;
+            pos += rowNnz;
+        }
+        _rowStart[_nr] = pos;
+        _col.resize(pos);
+    }
+
+    template<class VectorSize>
+    inline SparsityPattern(size_t nr,
+                           size_t nc,
+                           const VectorSize& row,
+                           const VectorSize& col) :
+        SparsityPattern(nr, nc, row, col, row.size()) {
+        CPPADCG_ASSERT_KNOWN(row.size() == col.size(), "The number of row and column indexes must be the same")
+    }
+
+    /**
+     * Creates a sparsity pattern from a set based representation.
+     *
+     * @param sets the column indexes of each row
+     * @param nc the number of columns
+     */
+    template<class VectorSet>
+    static inline SparsityPattern fromSets(const VectorSet& sets,
+                                           size_t nc) {
+        size_t nr = sets.size();
+        SparsityPattern p(nr, nc);
+
+        size_t nnz = 0;
+        for (size_t i = 0; i < nr; i++) {
+            nnz += sets[i].size();
+        }
+        p._col.reserve(nnz);
+
+        for (size_t i = 0; i < nr; i++) {
+            p._rowStart[i] = p._col.size();
+            for (size_t j : sets[i]) {
+                CPPADCG_ASSERT_KNOWN(j < nc, "Invalid sparsity pattern column index")
+                p._col.push_back(j);
+            }
+        }
+        p._rowStart[nr] = p._col.size();
+
+        return p;
+    }
+
+    /**
+     * Creates a sparsity pattern from a CppAD sparsity pattern.
+     */
+    template<class VectorSize>
+    static inline SparsityPattern fromSparseRc(const CppAD::sparse_rc<VectorSize>& pattern) {
+        return SparsityPattern(pattern.nr(), pattern.nc(), pattern.row(), pattern.col(), pattern.nnz());
+    }
+
+    /**
+     * @return the number of rows
+     */
+    inline size_t rows() const {
+        return _nr;
+    }
+
+    /**
+     * @return the number of columns
+     */
+    inline size_t cols() const {
+        return _nc;
+    }
+
+    /**
+     * @return the total number of non-zero elements
+     */
+    inline size_t nnz() const {
+        return _col.size();
+    }
+
+    /**
+     * @return the number of non-zero elements in a row
+     */
+    inline size_t rowSize(size_t i) const {
+        CPPADCG_ASSERT_UNKNOWN(i < _nr)
+        return _rowStart[i + 1] - _rowStart[i];
+    }
+
+    /**
+     * @return a pointer to the first column index of a row
+     */
+    inline const size_t* begin(size_t i) const {
+        CPPADCG_ASSERT_UNKNOWN(i < _nr)
+        return _col.data() + _rowStart[i];
+    }
+
+    /**
+     * @return a pointer after the last column index of a row
+     */
+    inline const size_t* end(size_t i) const {
+        CPPADCG_ASSERT_UNKNOWN(i < _nr)
+        return _col.data() + _rowStart[i + 1];
+    }
+
+    /**
+     * @return the position of the first element of each row in the column
+     *         index array (CSR row pointer with size rows() + 1)
+     */
+    inline const std::vector<size_t>& getRowStart() const {
+        return _rowStart;
+    }
+
+    /**
+     * @return the column index of each non-zero element (CSR column indexes)
+     */
+    inline const std::vector<size_t>& getColumnIndexes() const {
+        return _col;
+    }
+
+    /**
+     * Determines whether or not an element is part of the sparsity pattern.
+     */
+    inline bool contains(size_t i,
+                         size_t j) const {
+        if (i >= _nr)
+            return false;
+        return std::binary_search(begin(i), end(i), j);
+    }
+
+    /**
+     * Creates the row and column indexes of the non-zero elements
+     * (row-major order).
+     */
+    template<class VectorSize>
+    inline void toIndexes(VectorSize& row,
+                          VectorSize& col) const {
+        row.resize(nnz());
+        col.resize(nnz());
+
+        for (size_t i = 0; i < _nr; i++) {
+            for (size_t e = _rowStart[i]; e < _rowStart[i + 1]; e++) {
+                row[e] = i;
+                col[e] = _col[e];
+            }
+        }
+    }
+
+    /**
+     * Creates a set based representation of this sparsity pattern.
+     */
+    template<class VectorSet = std::vector<std::set<size_t> > >
+    inline VectorSet toSets() const {
+        VectorSet s(_nr);
+        for (size_t i = 0; i < _nr; i++) {
+            s[i].insert(begin(i), end(i));
+        }
+        return s;
+    }
+
+    /**
+     * Creates a dense (row-major) boolean representation of this sparsity
+     * pattern.
+     */
+    template<class VectorBool = std::vector<bool> >
+    inline VectorBool toBool() const {
+        VectorBool s(_nr * _nc);
+        for (size_t i = 0; i < _nr * _nc; i++) {
+            s[i] = false;
+        }
+        for (size_t i = 0; i < _nr; i++) {
+            for (size_t e = _rowStart[i]; e < _rowStart[i + 1]; e++) {
+                s[i * _nc + _col[e]] = true;
+            }
+        }
+        return s;
+    }
+
+    /**
+     * Creates a CppAD sparsity pattern (row-major order).
+     */
+    inline CppAD::sparse_rc<std::vector<size_t> > toSparseRc() const {
+        CppAD::sparse_rc<std::vector<size_t> > pattern(_nr, _nc, nnz());
+        for (size_t i = 0; i < _nr; i++) {
+            for (size_t e = _rowStart[i]; e < _rowStart[i + 1]; e++) {
+                pattern.set(e, i, _col[e]);
+            }
+        }
+        return pattern;
+    }
+
+    /**
+     * @return the transpose of this sparsity pattern
+     */
+    inline SparsityPattern transpose() const {
+        SparsityPattern t(_nc, _nr);
+        t._col.resize(nnz());
+
+        for (size_t j : _col) {
+            t._rowStart[j + 1]++;
+        }
+        for (size_t j = 0; j < _nc; j++) {
+            t._rowStart[j + 1] += t._rowStart[j];
+        }
+
+        // rows are visited in order and therefore the result is sorted
+        std::vector<size_t> next(t._rowStart.begin(), t._rowStart.end() - 1);
+        for (size_t i = 0; i < _nr; i++) {
+            for (size_t e = _rowStart[i]; e < _rowStart[i + 1]; e++) {
+                t._col[next[_col[e]]++] = i;
+            }
+        }
+
+        return t;
+    }
+
+    inline bool operator==(const SparsityPattern& other) const {
+        return _nr == other._nr && _nc == other._nc &&
+               _rowStart == other._rowStart && _col == other._col;
+    }
+
+    inline bool operator!=(const SparsityPattern& other) const {
+        return !(*this == other);
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -70,6 +70,7 @@ public:
     static const JobType GRAPH;
     static const JobType SOURCE_FOR_MODEL;
     static const JobType SOURCE_GENERATION;
+    static const JobType FUNCTION_PARTITION;
     static const JobType COMPILING_FOR_MODEL;
     static const JobType COMPILING;
     static const JobType COMPILING_DYNAMIC_LIBRARY;
@@ -94,6 +95,9 @@ const JobType JobTypeHolder<T>::SOURCE_FOR_MODEL("source-code for model", "sourc
 template<int T>
 const JobType JobTypeHolder<T>::SOURCE_GENERATION("generating source for", "generated source for");
 
+template<int T>
+const JobType JobTypeHolder<T>::FUNCTION_PARTITION("partitioned", "partitioned");
+
 template<int T>
 const JobType JobTypeHolder<T>::COMPILING_FOR_MODEL("compiling object files", "compiled object files");
 
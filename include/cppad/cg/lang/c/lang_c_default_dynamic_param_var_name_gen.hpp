@@ -0,0 +1,228 @@
+#ifndef CPPAD_CG_LANG_C_DEFAULT_DYNAMIC_PARAM_VAR_NAME_GEN_INCLUDED
+#define CPPAD_CG_LANG_C_DEFAULT_DYNAMIC_PARAM_VAR_NAME_GEN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2018 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Creates variables names for the source code of models with CppAD dynamic
+ * parameters.
+ * The dynamic parameters are considered to have been registered as
+ * independent variables in the code generation handler after all the other
+ * independent variables (and multipliers). They are provided to the
+ * generated function through an additional (last) input array.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LangCDefaultDynamicParamVarNameGenerator : public VariableNameGenerator<Base> {
+protected:
+    VariableNameGenerator<Base>* _nameGen;
+    // the lowest variable ID used for the dynamic parameters
+    const size_t _minParameterID;
+    // array name of the dynamic parameters
+    const std::string _parName;
+    // auxiliary string stream
+    std::stringstream _ss;
+public:
+
+    /**
+     * @param nameGen the name generator used for all other variables
+     * @param nIndep the number of independent variables (including
+     *               multipliers) registered before the dynamic parameters
+     */
+    LangCDefaultDynamicParamVarNameGenerator(VariableNameGenerator<Base>* nameGen,
+                                             size_t nIndep) :
+        _nameGen(nameGen),
+        _minParameterID(nIndep + 1),
+        _parName("p") {
+
+        CPPADCG_ASSERT_KNOWN(_nameGen != nullptr, "The name generator must not be NULL")
+
+        initialize();
+    }
+
+    LangCDefaultDynamicParamVarNameGenerator(VariableNameGenerator<Base>* nameGen,
+                                             std::string parName,
+                                             size_t nIndep) :
+        _nameGen(nameGen),
+        _minParameterID(nIndep + 1),
+        _parName(std::move(parName)) {
+
+        CPPADCG_ASSERT_KNOWN(_nameGen != nullptr, "The name generator must not be null")
+        CPPADCG_ASSERT_KNOWN(_parName.size() > 0, "The name for the dynamic parameters must not be empty")
+
+        initialize();
+    }
+
+    inline virtual ~LangCDefaultDynamicParamVarNameGenerator() = default;
+
+    const std::vector<FuncArgument>& getDependent() const override {
+        return _nameGen->getDependent();
+    }
+
+    const std::vector<FuncArgument>& getTemporary() const override {
+        return _nameGen->getTemporary();
+    }
+
+    size_t getMinTemporaryVariableID() const override {
+        return _nameGen->getMinTemporaryVariableID();
+    }
+
+    size_t getMaxTemporaryVariableID() const override {
+        return _nameGen->getMaxTemporaryVariableID();
+    }
+
+    size_t getMaxTemporaryArrayVariableID() const override {
+        return _nameGen->getMaxTemporaryArrayVariableID();
+    }
+
+    size_t getMaxTemporarySparseArrayVariableID() const override {
+        return _nameGen->getMaxTemporarySparseArrayVariableID();
+    }
+
+    std::string generateDependent(size_t index) override {
+        return _nameGen->generateDependent(index);
+    }
+
+    std::string generateIndependent(const OperationNode<Base>& independent,
+                                    size_t id) override {
+        if (id < _minParameterID) {
+            return _nameGen->generateIndependent(independent, id);
+        }
+
+        _ss.clear();
+        _ss.str("");
+        _ss << _parName << "[" << (id - _minParameterID) << "]";
+        return _ss.str();
+    }
+
+    std::string generateTemporary(const OperationNode<Base>& variable,
+                                  size_t id) override {
+        return _nameGen->generateTemporary(variable, id);
+    }
+
+    std::string generateTemporaryArray(const OperationNode<Base>& variable,
+                                       size_t id) override {
+        return _nameGen->generateTemporaryArray(variable, id);
+    }
+
+    std::string generateTemporarySparseArray(const OperationNode<Base>& variable,
+                                             size_t id) override {
+        return _nameGen->generateTemporarySparseArray(variable, id);
+    }
+
+    std::string generateIndexedDependent(const OperationNode<Base>& var,
+                                         size_t id,
+                                         const IndexPattern& ip) override {
+        return _nameGen->generateIndexedDependent(var, id, ip);
+    }
+
+    std::string generateIndexedIndependent(const OperationNode<Base>& indexedIndep,
+                                           size_t id,
+                                           const IndexPattern& ip) override {
+        // loops are not detected for models with dynamic parameters
+        return _nameGen->generateIndexedIndependent(indexedIndep, id, ip);
+    }
+
+    const std::string& getIndependentArrayName(const OperationNode<Base>& indep,
+                                               size_t id) override {
+        if (id < _minParameterID)
+            return _nameGen->getIndependentArrayName(indep, id);
+        else
+            return _parName;
+    }
+
+    size_t getIndependentArrayIndex(const OperationNode<Base>& indep,
+                                    size_t id) override {
+        if (id < _minParameterID)
+            return _nameGen->getIndependentArrayIndex(indep, id);
+        else
+            return id - _minParameterID;
+    }
+
+    bool isConsecutiveInIndepArray(const OperationNode<Base>& indepFirst,
+                                   size_t id1,
+                                   const OperationNode<Base>& indepSecond,
+                                   size_t id2) override {
+        if ((id1 < _minParameterID) != (id2 < _minParameterID))
+            return false;
+
+        if (id1 < _minParameterID && id2 < _minParameterID)
+            return _nameGen->isConsecutiveInIndepArray(indepFirst, id1, indepSecond, id2);
+        else
+            return id1 + 1 == id2;
+    }
+
+    bool isInSameIndependentArray(const OperationNode<Base>& indep1,
+                                  size_t id1,
+                                  const OperationNode<Base>& indep2,
+                                  size_t id2) override {
+        if ((id1 < _minParameterID) != (id2 < _minParameterID))
+            return false;
+
+        if (id1 < _minParameterID && id2 < _minParameterID)
+            return _nameGen->isInSameIndependentArray(indep1, id1, indep2, id2);
+        else
+            return true;
+    }
+
+    void setTemporaryVariableID(size_t minTempID,
+                                size_t maxTempID,
+                                size_t maxTempArrayID,
+                                size_t maxTempSparseArrayID) override {
+        _nameGen->setTemporaryVariableID(minTempID, maxTempID, maxTempArrayID, maxTempSparseArrayID);
+    }
+
+    const std::string& getTemporaryVarArrayName(const OperationNode<Base>& var,
+                                                size_t id) override {
+        return _nameGen->getTemporaryVarArrayName(var, id);
+    }
+
+    size_t getTemporaryVarArrayIndex(const OperationNode<Base>& var,
+                                     size_t id) override {
+        return _nameGen->getTemporaryVarArrayIndex(var, id);
+    }
+
+    bool isConsecutiveInTemporaryVarArray(const OperationNode<Base>& varFirst,
+                                          size_t idFirst,
+                                          const OperationNode<Base>& varSecond,
+                                          size_t idSecond) override {
+        return _nameGen->isConsecutiveInTemporaryVarArray(varFirst, idFirst, varSecond, idSecond);
+    }
+
+    bool isInSameTemporaryVarArray(const OperationNode<Base>& var1,
+                                   size_t id1,
+                                   const OperationNode<Base>& var2,
+                                   size_t id2) override {
+        return _nameGen->isInSameTemporaryVarArray(var1, id1, var2, id2);
+    }
+
+private:
+
+    inline void initialize() {
+        this->_independent = _nameGen->getIndependent(); // copy
+
+        this->_independent.push_back(FuncArgument(_parName));
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -97,8 +97,16 @@ protected:
     size_t _maxAssignmentsPerFunction;
     // the maximum number of operations per variable assignment
     size_t _maxOperationsPerAssignment;
+    // the maximum number of operations per local function when split points are selected automatically
+    size_t _maxOperationsPerFunction;
+    // the number of operations in each local function of the last automatic function splitting
+    std::vector<size_t> _functionOperations;
+    // the number of values passed to each local function by the previous ones (automatic function splitting)
+    std::vector<size_t> _functionBoundaryValues;
     //  maps file names to with their contents
     std::map<std::string, std::string>* _sources;
+    // writes the source files to disk instead of the map of sources (optional)
+    SourceFileStream* _sourceStream;
     // the values in the temporary array
     std::vector<const Arg*> _tmpArrayValues;
     // the values in the temporary sparse array
@@ -110,6 +118,8 @@ protected:
     std::vector<const LoopStartOperationNode<Base>*> _currentLoops;
     // the maximum precision used to print values
     size_t _parameterPrecision;
+    // atomic functions which are called directly (models compiled in the same library)
+    std::set<std::string> _directAtomics;
 private:
     std::vector<std::string> funcArgDcl_;
     std::vector<std::string> localFuncArgDcl_;
@@ -141,7 +151,9 @@ public:
         _ignoreZeroDepAssign(false),
         _maxAssignmentsPerFunction(0),
         _maxOperationsPerAssignment((std::numeric_limits<size_t>::max)()),
+        _maxOperationsPerFunction(0),
         _sources(nullptr),
+        _sourceStream(nullptr),
         _parameterPrecision(std::numeric_limits<Base>::digits10) {
     }
 
@@ -238,6 +250,72 @@ public:
         _parameterPrecision = p;
     }
 
+    /**
+     * Provides the names of the atomic functions which are called directly
+     * instead of through the LangCAtomicFun structure.
+     *
+     * @return the names of the atomic functions
+     */
+    inline const std::set<std::string>& getDirectAtomicFunctions() const {
+        return _directAtomics;
+    }
+
+    /**
+     * Defines the atomic functions which are called directly instead of
+     * through the LangCAtomicFun structure.
+     * These atomic functions must be models compiled into the same library
+     * (with the same name as the atomic function) and the library must
+     * provide the functions named by getDirectAtomicForwardName() and
+     * getDirectAtomicReverseName().
+     * When a direct call fails (returns 0) the LangCAtomicFun structure is
+     * called instead so that the model library reports the failure.
+     *
+     * @param names the names of the atomic functions
+     */
+    inline void setDirectAtomicFunctions(const std::set<std::string>& names) {
+        _directAtomics = names;
+    }
+
+    /**
+     * Provides the name of the function used to call the forward mode of
+     * an atomic function directly.
+     *
+     * @param atomicName the atomic function name
+     */
+    static inline std::string getDirectAtomicForwardName(const std::string& atomicName) {
+        return atomicName + "_atomic_forward";
+    }
+
+    /**
+     * Provides the name of the function used to call the reverse mode of
+     * an atomic function directly.
+     *
+     * @param atomicName the atomic function name
+     */
+    static inline std::string getDirectAtomicReverseName(const std::string& atomicName) {
+        return atomicName + "_atomic_reverse";
+    }
+
+    /**
+     * Generates the declarations of the functions used to call atomic
+     * functions directly.
+     *
+     * @param atomicNames the names of the atomic functions
+     * @param atomicArgName the name of the atomic function structure
+     *                      argument
+     */
+    static inline std::string generateDirectAtomicDeclarations(const std::set<std::string>& atomicNames,
+                                                               const std::string& atomicArgName = "atomicFun") {
+        std::string dcl;
+        for (const std::string& name : atomicNames) {
+            dcl += "int " + getDirectAtomicForwardName(name) + "(int q, int p, const Array tx[], Array* ty, "
+                   "struct LangCAtomicFun " + atomicArgName + ");\n";
+            dcl += "int " + getDirectAtomicReverseName(name) + "(int p, const Array tx[], Array* px, const Array py[], "
+                   "struct LangCAtomicFun " + atomicArgName + ");\n";
+        }
+        return dcl;
+    }
+
     /**
      * Defines the maximum number of assignment per generated function.
      * Zero means it is disabled (no limit).
@@ -274,6 +352,74 @@ public:
         _maxOperationsPerAssignment = maxOperationsPerAssignment;
     }
 
+    /**
+     * The maximum number of operations per local function used by the
+     * automatic function splitting.
+     *
+     * @return The maximum number of operations per function (zero if the
+     *         automatic function splitting is disabled)
+     */
+    inline size_t getMaxOperationsPerFunction() const {
+        return _maxOperationsPerFunction;
+    }
+
+    /**
+     * Enables the automatic selection of the points where the generated
+     * function is split into multiple local functions/files.
+     * The split points are selected using the dependencies between
+     * variables so that the number of values passed between local functions
+     * is minimized while each local function has approximately the
+     * provided number of operations.
+     * When enabled, it replaces the maximum number of assignments per
+     * function but it also requires the map for the source files provided
+     * to setMaxAssignmentsPerFunction().
+     *
+     * @param maxOperationsPerFunction the target number of operations per
+     *                                 local function (zero disables the
+     *                                 automatic function splitting)
+     */
+    inline void setMaxOperationsPerFunction(size_t maxOperationsPerFunction) {
+        _maxOperationsPerFunction = maxOperationsPerFunction;
+    }
+
+    /**
+     * Provides the stream where the source files are written.
+     *
+     * @return the source file stream (null if the source files are saved
+     *         in the map provided to setMaxAssignmentsPerFunction())
+     */
+    inline SourceFileStream* getSourceStream() const {
+        return _sourceStream;
+    }
+
+    /**
+     * Defines a stream where each source file of a function split into
+     * multiple files is written as soon as it is generated, instead of
+     * the map provided to setMaxAssignmentsPerFunction().
+     *
+     * @param sourceStream the source file stream (null to use the map)
+     */
+    inline void setSourceStream(SourceFileStream* sourceStream) {
+        _sourceStream = sourceStream;
+    }
+
+    /**
+     * Provides the number of operations in each local function created by
+     * the last automatic function splitting.
+     */
+    inline const std::vector<size_t>& getFunctionOperations() const {
+        return _functionOperations;
+    }
+
+    /**
+     * Provides the number of values computed in previous local functions
+     * which are used by each local function created by the last automatic
+     * function splitting.
+     */
+    inline const std::vector<size_t>& getFunctionBoundaryValues() const {
+        return _functionBoundaryValues;
+    }
+
     inline std::string generateTemporaryVariableDeclaration(bool isWrapperFunction,
                                                             bool zeroArrayDependents,
                                                             const std::vector<int>& atomicMaxForward,
@@ -664,7 +810,8 @@ protected:
                             std::unique_ptr<LanguageGenerationData<Base> > info) override {
 
         const bool createFunction = !_functionName.empty();
-        const bool multiFunction = createFunction && _maxAssignmentsPerFunction > 0 && _sources != nullptr;
+        const bool autoSplit = isAutomaticFunctionSplitting();
+        const bool multiFunction = createFunction && (_maxAssignmentsPerFunction > 0 || autoSplit) && _sources != nullptr;
 
         // clean up
         _code.str("");
@@ -679,6 +826,8 @@ protected:
         _atomicFuncArrays.clear();
         _streamStack.clear();
         _dependentIDs.clear();
+        _functionOperations.clear();
+        _functionBoundaryValues.clear();
 
         // save some info
         _info = std::move(info);
@@ -782,9 +931,18 @@ protected:
 
         // the names of local functions
         std::vector<std::string> localFuncNames;
-        if (multiFunction) {
+
+        // the automatic split points
+        std::vector<size_t> varOperations;
+        std::vector<size_t> boundaryValues;
+        std::vector<size_t> splits;
+        if (autoSplit) {
+            splits = selectFunctionSplits(varOperations, boundaryValues);
+            localFuncNames.reserve(splits.size() + 1);
+        } else if (multiFunction) {
             localFuncNames.reserve(variableOrder.size() / _maxAssignmentsPerFunction);
         }
+        std::vector<size_t> usedSplits;
 
         /**
          * non-constant variables
@@ -824,11 +982,20 @@ protected:
             }
 
             size_t assignCount = 0;
+            size_t nextSplit = 0;
             for (size_t i = 0; i < variableOrder.size(); ++i) {
                 Node* it = variableOrder[i];
 
                 // check if a new function should start
-                if (assignCount >= _maxAssignmentsPerFunction && multiFunction && _currentLoops.empty()) {
+                if (autoSplit) {
+                    if (nextSplit < splits.size() && splits[nextSplit] <= i && _currentLoops.empty()) {
+                        assignCount = 0;
+                        saveLocalFunction(localFuncNames, localFuncNames.empty() && _info->zeroDependents);
+                        usedSplits.push_back(i);
+                        while (nextSplit < splits.size() && splits[nextSplit] <= i)
+                            nextSplit++;
+                    }
+                } else if (assignCount >= _maxAssignmentsPerFunction && multiFunction && _currentLoops.empty()) {
                     assignCount = 0;
                     saveLocalFunction(localFuncNames, localFuncNames.empty() && _info->zeroDependents);
                 }
@@ -857,6 +1024,10 @@ protected:
             }
         }
 
+        if (autoSplit && !localFuncNames.empty()) {
+            reportFunctionSplits(usedSplits, varOperations, boundaryValues);
+        }
+
         if (!localFuncNames.empty()) {
             /**
              * Create the wrapper function which calls the other functions
@@ -929,7 +1100,8 @@ protected:
             if (localFuncNames.empty()) {
                 _ss << "#include <math.h>\n"
                         "#include <stdio.h>\n\n"
-                    << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+                    << ATOMICFUN_STRUCT_DEFINITION << "\n\n"
+                    << generateDirectAtomicDeclarations(_directAtomics, _atomicArgName);
                 printFunctionDeclaration(_ss, "void", _functionName, funcArgDcl_);
                 _ss << " {\n";
                 _nameGen->customFunctionVariableDeclarations(_ss);
@@ -946,19 +1118,32 @@ protected:
                 out << _ss.str();
 
                 if (_sources != nullptr) {
-                    (*_sources)[_functionName + ".c"] = _ss.str();
+                    saveSource(_functionName + ".c", _ss.str());
                 }
             } else {
                 _nameGen->finalizeCustomFunctionVariables(_code);
                 _code << "}\n\n";
 
-                (*_sources)[_functionName + ".c"] = _code.str();
+                saveSource(_functionName + ".c", _code.str());
             }
         } else {
             out << _code.str();
         }
     }
 
+    /**
+     * Saves a new source file in the source file stream or in the map of
+     * sources.
+     */
+    inline void saveSource(const std::string& name,
+                           const std::string& source) {
+        if (_sourceStream != nullptr) {
+            _sourceStream->write(name, source);
+        } else {
+            (*_sources)[name] = source;
+        }
+    }
+
     inline size_t getVariableID(const Node& node) const {
         return _info->varId[node];
     }
@@ -1053,7 +1238,8 @@ protected:
 
         _ss << "#include <math.h>\n"
                 "#include <stdio.h>\n\n"
-                << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+                << ATOMICFUN_STRUCT_DEFINITION << "\n\n"
+                << generateDirectAtomicDeclarations(_directAtomics, _atomicArgName);
         printFunctionDeclaration(_ss, "void", funcName, localFuncArgDcl_);
         _ss << " {\n";
         _nameGen->customFunctionVariableDeclarations(_ss);
@@ -1081,7 +1267,7 @@ protected:
         _nameGen->finalizeCustomFunctionVariables(_ss);
         _ss << "}\n\n";
 
-        (*_sources)[funcName + ".c"] = _ss.str();
+        saveSource(funcName + ".c", _ss.str());
         localFuncNames.push_back(funcName);
 
         _code.str("");
@@ -1229,7 +1415,164 @@ protected:
     }
 
     bool requiresVariableDependencies() const override {
-        return false;
+        return isAutomaticFunctionSplitting();
+    }
+
+    /**
+     * Whether or not the points where the generated function is split into
+     * several local functions are selected automatically.
+     */
+    inline bool isAutomaticFunctionSplitting() const {
+        return _maxOperationsPerFunction > 0 && _sources != nullptr && !_functionName.empty();
+    }
+
+    /**
+     * Determines the number of operations used to evaluate a variable
+     * (including the operations without a variable which are printed in
+     * the same assignment).
+     */
+    inline size_t countVariableOperations(const Node& var) const {
+        size_t count = 0;
+        std::vector<const Node*> stack{&var};
+        while (!stack.empty()) {
+            const Node* node = stack.back();
+            stack.pop_back();
+            count++;
+            for (const Arg& a : node->getArguments()) {
+                const Node* arg = a.getOperation();
+                if (arg != nullptr && getVariableID(*arg) == 0) {
+                    stack.push_back(arg);
+                }
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Selects the positions in the variable order where new local functions
+     * should start.
+     * Each local function has at most the maximum number of operations per
+     * function (unless a single variable exceeds it) and, within the last
+     * half of that budget, the position with the lowest number of values
+     * which cross the function boundary is selected.
+     *
+     * @param varOperations the number of operations of each variable
+     *                      (output)
+     * @param boundaryValues the number of values defined before and used
+     *                       after each position in the variable order
+     *                       (output)
+     * @return the split positions in the variable order
+     */
+    virtual std::vector<size_t> selectFunctionSplits(std::vector<size_t>& varOperations,
+                                                     std::vector<size_t>& boundaryValues) const {
+        const std::vector<Node*>& variableOrder = _info->variableOrder;
+        const std::vector<std::set<Node*>>& dependencies = _info->variableDependencies;
+        const size_t n = variableOrder.size();
+        CPPADCG_ASSERT_UNKNOWN(dependencies.size() == n)
+
+        std::map<const Node*, size_t> position;
+        varOperations.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            position[variableOrder[i]] = i;
+            varOperations[i] = countVariableOperations(*variableOrder[i]);
+        }
+
+        // the last variable which uses each variable
+        std::vector<size_t> lastUse(n);
+        for (size_t i = 0; i < n; i++) {
+            lastUse[i] = i;
+        }
+        for (size_t i = 0; i < n; i++) {
+            for (const Node* dep : dependencies[i]) {
+                auto itPos = position.find(dep);
+                if (itPos != position.end()) { // independent variables are not in the variable order
+                    lastUse[itPos->second] = std::max(lastUse[itPos->second], i);
+                }
+            }
+        }
+
+        // values that cross a split placed before each variable
+        std::vector<long> delta(n + 1, 0);
+        for (size_t p = 0; p < n; p++) {
+            if (lastUse[p] > p) {
+                delta[p + 1]++;
+                delta[lastUse[p] + 1]--;
+            }
+        }
+        boundaryValues.resize(n + 1);
+        long live = 0;
+        for (size_t c = 0; c <= n; c++) {
+            live += delta[c];
+            boundaryValues[c] = size_t(live);
+        }
+
+        const size_t maxOps = _maxOperationsPerFunction;
+        std::vector<size_t> splits;
+        size_t begin = 0;
+        while (begin < n) {
+            size_t ops = varOperations[begin];
+            size_t end = begin + 1;
+            size_t best = n;
+            while (end < n && ops + varOperations[end] <= maxOps) {
+                if (2 * ops >= maxOps && (best == n || boundaryValues[end] <= boundaryValues[best]))
+                    best = end;
+                ops += varOperations[end];
+                end++;
+            }
+            if (end >= n)
+                break;
+
+            if (2 * ops >= maxOps && (best == n || boundaryValues[end] <= boundaryValues[best]))
+                best = end;
+            if (best == n)
+                best = end;
+
+            splits.push_back(best);
+            begin = best;
+        }
+
+        return splits;
+    }
+
+    /**
+     * Saves and reports the local functions created by the automatic
+     * function splitting.
+     *
+     * @param splits the positions in the variable order where new local
+     *               functions were started
+     * @param varOperations the number of operations of each variable
+     * @param boundaryValues the number of values crossing each position
+     */
+    virtual void reportFunctionSplits(const std::vector<size_t>& splits,
+                                      const std::vector<size_t>& varOperations,
+                                      const std::vector<size_t>& boundaryValues) {
+        const size_t n = varOperations.size();
+
+        size_t begin = 0;
+        for (size_t f = 0; f <= splits.size(); f++) {
+            size_t end = f < splits.size() ? splits[f] : n;
+            size_t ops = 0;
+            for (size_t i = begin; i < end; i++) {
+                ops += varOperations[i];
+            }
+            _functionOperations.push_back(ops);
+            _functionBoundaryValues.push_back(begin == 0 ? 0 : boundaryValues[begin]);
+            begin = end;
+        }
+
+        if (_info->jobTimer != nullptr) {
+            size_t maxOps = *std::max_element(_functionOperations.begin(), _functionOperations.end());
+            size_t values = 0;
+            for (size_t v : _functionBoundaryValues) {
+                values += v;
+            }
+
+            std::ostringstream os;
+            os << "'" << _functionName << "' into " << _functionOperations.size() << " functions ("
+               << "max " << maxOps << " operations, " << values << " values across boundaries)";
+            _info->jobTimer->startingJob(os.str(), JobTimer::FUNCTION_PARTITION);
+            _info->jobTimer->finishedJob();
+        }
     }
 
     virtual void pushIndependentVariableName(Node& op) {
@@ -1818,11 +2161,24 @@ protected:
         printArrayStructInit(_ATOMIC_TY, *ty[p]); // also does indentation
         _ss.str("");
 
-        _streamStack << _indentation << "atomicFun.forward(atomicFun.libModel, "
-                     << atomicIndex << ", " << q << ", " << p << ", "
-                     << _ATOMIC_TX << ", &" << _ATOMIC_TY << "); // "
-                     << _info->atomicFunctionId2Name.at(id)
-                     << "\n";
+        const std::string& atomicName = _info->atomicFunctionId2Name.at(id);
+        if (_directAtomics.find(atomicName) != _directAtomics.end()) {
+            // a model in the same library (failures are reported by the model library)
+            _streamStack << _indentation << "if (!" << getDirectAtomicForwardName(atomicName) << "("
+                         << q << ", " << p << ", "
+                         << _ATOMIC_TX << ", &" << _ATOMIC_TY << ", " << _atomicArgName << "))\n"
+                         << _indentation << "   atomicFun.forward(atomicFun.libModel, "
+                         << atomicIndex << ", " << q << ", " << p << ", "
+                         << _ATOMIC_TX << ", &" << _ATOMIC_TY << "); // "
+                         << atomicName
+                         << "\n";
+        } else {
+            _streamStack << _indentation << "atomicFun.forward(atomicFun.libModel, "
+                         << atomicIndex << ", " << q << ", " << p << ", "
+                         << _ATOMIC_TX << ", &" << _ATOMIC_TY << "); // "
+                         << atomicName
+                         << "\n";
+        }
 
         /**
          * the values of ty are now changed
@@ -1866,11 +2222,24 @@ protected:
         printArrayStructInit(_ATOMIC_PX, *px[0]); // also does indentation
         _ss.str("");
 
-        _streamStack << _indentation << "atomicFun.reverse(atomicFun.libModel, "
-                     << atomicIndex << ", " << p << ", "
-                     << _ATOMIC_TX << ", &" << _ATOMIC_PX << ", " << _ATOMIC_PY << "); // "
-                     << _info->atomicFunctionId2Name.at(id)
-                     << "\n";
+        const std::string& atomicName = _info->atomicFunctionId2Name.at(id);
+        if (_directAtomics.find(atomicName) != _directAtomics.end()) {
+            // a model in the same library (failures are reported by the model library)
+            _streamStack << _indentation << "if (!" << getDirectAtomicReverseName(atomicName) << "("
+                         << p << ", "
+                         << _ATOMIC_TX << ", &" << _ATOMIC_PX << ", " << _ATOMIC_PY << ", " << _atomicArgName << "))\n"
+                         << _indentation << "   atomicFun.reverse(atomicFun.libModel, "
+                         << atomicIndex << ", " << p << ", "
+                         << _ATOMIC_TX << ", &" << _ATOMIC_PX << ", " << _ATOMIC_PY << "); // "
+                         << atomicName
+                         << "\n";
+        } else {
+            _streamStack << _indentation << "atomicFun.reverse(atomicFun.libModel, "
+                         << atomicIndex << ", " << p << ", "
+                         << _ATOMIC_TX << ", &" << _ATOMIC_PX << ", " << _ATOMIC_PY << "); // "
+                         << atomicName
+                         << "\n";
+        }
 
         /**
          * the values of px are now changed
@@ -2233,6 +2602,8 @@ const std::string LanguageC<Base>::_ATOMIC_PY = "apy"; // NOLINT(cert-err58-cpp)
 
 template<class Base>
 const std::string LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION = // NOLINT(cert-err58-cpp)
+"#ifndef CPPADCG_LANGC_ATOMICFUN_DEFINED\n"
+"#define CPPADCG_LANGC_ATOMICFUN_DEFINED\n"
 "typedef struct Array {\n"
 "    void* data;\n"
 "    " + U_INDEX_TYPE + " size;\n"
@@ -2255,7 +2626,8 @@ const std::string LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION = // NOLINT(cert-
 "                   const Array tx[],\n"
 "                   Array* px,\n"
 "                   const Array py[]);\n"
-"};";
+"};\n"
+"#endif";
 
 } // END cg namespace
 } // END CppAD namespace
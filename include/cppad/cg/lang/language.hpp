@@ -106,6 +106,10 @@ public:
      * executing the operation graph
      */
     const bool zeroDependents;
+    /**
+     * used to report progress (might be null)
+     */
+    JobTimer* jobTimer;
 public:
 
     LanguageGenerationData(const std::vector<Node *>& ind,
@@ -127,7 +131,8 @@ public:
                            const CodeHandlerVector<Base, size_t>& totalUseCount,
                            const CodeHandlerVector<Base, ScopeIDType>& scope,
                            IndexOperationNode<Base>& auxIterationIndexOp,
-                           bool zero) :
+                           bool zero,
+                           JobTimer* jobTimer = nullptr) :
         independent(ind),
         dependent(dep),
         minTemporaryVarID(minTempVID),
@@ -147,7 +152,8 @@ public:
         totalUseCount(totalUseCount),
         scope(scope),
         auxIterationIndexOp(auxIterationIndexOp),
-        zeroDependents(zero) {
+        zeroDependents(zero),
+        jobTimer(jobTimer) {
     }
 };
 
@@ -0,0 +1,78 @@
+#ifndef CPPAD_CG_ARRAY_ATOMIC_FUN_INCLUDED
+#define CPPAD_CG_ARRAY_ATOMIC_FUN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * An interface which can be implemented by atomic functions (derived from
+ * atomic_base) in order to be evaluated directly with the arrays provided
+ * by compiled models.
+ * This avoids the conversion of (possibly sparse) Taylor coefficients into
+ * dense CppAD vectors on every call from a compiled model.
+ *
+ * The Taylor coefficients are provided by order: tx[k] contains the
+ * coefficients of order k for all the independent variables and it can be
+ * either a dense array (with Array::size elements) or a sparse array (with
+ * Array::nnz elements whose indexes are in Array::idx).
+ */
+template<class Base>
+class ArrayAtomicFun {
+public:
+    /**
+     * Computes results during a forward mode sweep.
+     *
+     * @param q Lowest order for this forward mode calculation.
+     * @param p Highest order for this forward mode calculation.
+     * @param tx Independent variable Taylor coefficients for each order
+     *           (p + 1 arrays).
+     * @param ty Dependent variable Taylor coefficients of order p (a dense
+     *           array). Values must be assigned if p is zero, otherwise
+     *           they must be added to the existing values.
+     * @return <code>true</code> if evaluation succeeded, <code>false</code> otherwise.
+     */
+    virtual bool forwardArray(int q,
+                              int p,
+                              const Array tx[],
+                              Array& ty) = 0;
+
+    /**
+     * Computes results during a reverse mode sweep.
+     *
+     * @param p Order for this reverse mode calculation.
+     * @param tx Independent variable Taylor coefficients for each order
+     *           (p + 1 arrays).
+     * @param px Partial derivatives relative to the zero order independent
+     *           variable Taylor coefficients (a dense array).
+     *           Values must be assigned if p is zero, otherwise they must
+     *           be added to the existing values.
+     * @param py Dependent variable partial derivatives for each order
+     *           (p + 1 arrays).
+     * @return <code>true</code> if evaluation succeeded, <code>false</code> otherwise.
+     */
+    virtual bool reverseArray(int p,
+                              const Array tx[],
+                              Array& px,
+                              const Array py[]) = 0;
+
+    inline virtual ~ArrayAtomicFun() = default;
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -23,10 +23,16 @@ template<class Base>
 class AtomicExternalFunctionWrapper : public ExternalFunctionWrapper<Base> {
 private:
     atomic_base<Base>* atomic_;
+    /**
+     * The same atomic function if it can use the arrays directly
+     * (without copies into dense vectors)
+     */
+    ArrayAtomicFun<Base>* arrayAtomic_;
 public:
 
     inline AtomicExternalFunctionWrapper(atomic_base<Base>& atomic) :
-        atomic_(&atomic) {
+        atomic_(&atomic),
+        arrayAtomic_(dynamic_cast<ArrayAtomicFun<Base>*>(&atomic)) {
     }
 
     inline virtual ~AtomicExternalFunctionWrapper() = default;
@@ -36,6 +42,10 @@ public:
                  int p,
                  const Array tx[],
                  Array& ty) override {
+        if (arrayAtomic_ != nullptr) {
+            return arrayAtomic_->forwardArray(q, p, tx, ty);
+        }
+
         size_t m = ty.size;
         size_t n = tx[0].size;
 
@@ -60,6 +70,10 @@ public:
                  const Array tx[],
                  Array& px,
                  const Array py[]) override {
+        if (arrayAtomic_ != nullptr) {
+            return arrayAtomic_->reverseArray(p, tx, px, py);
+        }
+
         size_t m = py[0].size;
         size_t n = tx[0].size;
 
@@ -38,6 +38,55 @@ protected:
     std::vector<std::string> _linkFlags;
     bool _verbose;
     bool _saveToDiskFirst;
+    /**
+     * the maximum size (number of characters) of a unity translation unit
+     * (zero disables the grouping of source files)
+     */
+    size_t _unityBuildMaxSize;
+    /**
+     * the target time (in seconds) to compile all the sources until the
+     * next cleanup (zero disables the compile time budget)
+     */
+    double _compileTimeBudget;
+    /**
+     * the optimization flags used instead of the optimization flags in the
+     * compile flags for sources which do not fit in the compile time budget
+     */
+    std::vector<std::string> _reducedOptimizationFlags;
+    /**
+     * the estimated time (in seconds) to compile any source file
+     * (process start up)
+     */
+    double _compileTimeStartup;
+    /**
+     * the estimated time (in seconds) to parse each operation (statement)
+     */
+    double _compileTimePerOperation;
+    /**
+     * the coefficient of the super-linear term (operations^1.5) of the
+     * estimated time (in seconds) to optimize a source file
+     */
+    double _compileTimeOptimization;
+    /**
+     * the estimated time (in seconds) of the compilations performed since
+     * the last cleanup
+     */
+    double _estimatedCompileTime;
+    /**
+     * the flags used to compile each translation unit since the last
+     * cleanup (only registered when there is a compile time budget)
+     */
+    std::map<std::string, std::vector<std::string>> _unitCompileFlags;
+    /**
+     * whether or not to use link-time optimization across all the object
+     * files of a dynamic library
+     */
+    bool _linkTimeOptimization;
+    /**
+     * the number of parallel jobs used to optimize and generate code at link
+     * time (zero uses the number of hardware threads)
+     */
+    size_t _linkTimeOptimizationJobs;
 public:
 
     AbstractCCompiler(const std::string& compilerPath) :
@@ -45,7 +94,16 @@ public:
         _tmpFolder("cppadcg_tmp"),
         _sourcesFolder("cppadcg_sources"),
         _verbose(false),
-        _saveToDiskFirst(false) {
+        _saveToDiskFirst(false),
+        _unityBuildMaxSize(0),
+        _compileTimeBudget(0),
+        _reducedOptimizationFlags{"-O1"},
+        _compileTimeStartup(0.02),
+        _compileTimePerOperation(2e-5),
+        _compileTimeOptimization(2e-7),
+        _estimatedCompileTime(0),
+        _linkTimeOptimization(false),
+        _linkTimeOptimizationJobs(0) {
     }
 
     AbstractCCompiler(const AbstractCCompiler& orig) = delete;
@@ -135,6 +193,213 @@ public:
         _verbose = verbose;
     }
 
+    /**
+     * Provides the maximum size (number of characters) of the unity
+     * translation units created by concatenating small source files.
+     *
+     * @return the maximum size of a unity translation unit (zero if source
+     *         files are compiled individually)
+     */
+    size_t getUnityBuildMaxSize() const {
+        return _unityBuildMaxSize;
+    }
+
+    /**
+     * Defines the maximum size (number of characters) of the unity
+     * translation units. Source files smaller than this size are
+     * concatenated into larger translation units which are compiled
+     * together, reducing the number of compiler invocations for models
+     * with many small source files.
+     * Each unity translation unit is still compiled independently.
+     * Source files with file scope definitions which are not protected by
+     * a guard (e.g. static functions or type definitions) are always
+     * compiled individually.
+     *
+     * @param maxSize the maximum size of a unity translation unit (zero
+     *                compiles every source file individually)
+     */
+    void setUnityBuildMaxSize(size_t maxSize) {
+        _unityBuildMaxSize = maxSize;
+    }
+
+    /**
+     * Provides the target time to compile all the sources of a library.
+     *
+     * @return the compile time budget in seconds (zero if all sources are
+     *         compiled with the same flags)
+     */
+    double getCompileTimeBudget() const {
+        return _compileTimeBudget;
+    }
+
+    /**
+     * Defines the target time to compile all the sources of a library
+     * (all calls to compileSources() until the next cleanup).
+     * The compilation time of each translation unit is estimated from its
+     * number of operations and the largest ones, whose optimized
+     * compilation time grows faster than their size, are compiled with the
+     * reduced optimization flags until the estimated total compile time
+     * fits in the budget.
+     * Small translation units are the last ones to lose optimization.
+     *
+     * @param budget the compile time budget in seconds (zero compiles all
+     *               sources with the same flags)
+     */
+    void setCompileTimeBudget(double budget) {
+        _compileTimeBudget = budget;
+    }
+
+    /**
+     * Provides the optimization flags used for translation units which do
+     * not fit in the compile time budget.
+     */
+    const std::vector<std::string>& getReducedOptimizationFlags() const {
+        return _reducedOptimizationFlags;
+    }
+
+    /**
+     * Defines the optimization flags used for translation units which do
+     * not fit in the compile time budget.
+     * These flags replace the optimization level flags (-O*) in the
+     * compile flags.
+     *
+     * @param flags the reduced optimization flags (e.g. -O1 or
+     *              -O2 -fno-schedule-insns2)
+     */
+    void setReducedOptimizationFlags(const std::vector<std::string>& flags) {
+        _reducedOptimizationFlags = flags;
+    }
+
+    /**
+     * Provides the estimated time to compile any source file, used to
+     * distribute the compile time budget.
+     *
+     * @return the start up time in seconds
+     */
+    double getCompileTimeStartup() const {
+        return _compileTimeStartup;
+    }
+
+    /**
+     * Defines the estimated time to compile any source file (e.g. to
+     * start the compiler process), used to distribute the compile time
+     * budget.
+     * The default (0.02 s) is an order of magnitude estimate for GCC and
+     * it is not calibrated for any particular machine.
+     *
+     * @param time the start up time in seconds
+     */
+    void setCompileTimeStartup(double time) {
+        _compileTimeStartup = time;
+    }
+
+    /**
+     * Provides the estimated time to parse each operation of a source
+     * file, used to distribute the compile time budget.
+     *
+     * @return the time per operation in seconds
+     */
+    double getCompileTimePerOperation() const {
+        return _compileTimePerOperation;
+    }
+
+    /**
+     * Defines the estimated time to parse and generate code for each
+     * operation (statement) of a source file, which is spent with any
+     * optimization level.
+     * The default (2e-5 s) is an order of magnitude estimate and it is not
+     * calibrated for any particular machine.
+     *
+     * @param time the time per operation in seconds
+     */
+    void setCompileTimePerOperation(double time) {
+        _compileTimePerOperation = time;
+    }
+
+    /**
+     * Provides the coefficient of the super-linear term of the estimated
+     * optimization time, used to distribute the compile time budget.
+     */
+    double getCompileTimeOptimization() const {
+        return _compileTimeOptimization;
+    }
+
+    /**
+     * Defines the coefficient of the super-linear term of the estimated
+     * time spent by the full optimization of a source file with N
+     * operations (coefficient * N^1.5 seconds), which is not spent when
+     * the reduced optimization flags are used.
+     * The default (2e-7) is an order of magnitude estimate and it is not
+     * calibrated for any particular machine.
+     * All coefficients can be calibrated with a least squares fit of the
+     * measured compile times of generated sources with different numbers
+     * of operations.
+     *
+     * @param coefficient the coefficient in seconds
+     */
+    void setCompileTimeOptimization(double coefficient) {
+        _compileTimeOptimization = coefficient;
+    }
+
+    /**
+     * Whether or not link-time optimization is used when creating dynamic
+     * libraries.
+     */
+    bool isLinkTimeOptimization() const {
+        return _linkTimeOptimization;
+    }
+
+    /**
+     * Defines whether or not to use link-time optimization when creating
+     * dynamic libraries.
+     * Functions in different source files (e.g. the sparse forward mode
+     * functions used by the sparse Jacobian) can then be inlined into
+     * each other.
+     * The machine code is only generated when the library is built and
+     * therefore the optimization level of the library flags is used for
+     * all sources.
+     * Static libraries created from these object files require an archiver
+     * with support for link-time optimization (e.g. gcc-ar).
+     *
+     * @param lto whether or not to use link-time optimization
+     */
+    void setLinkTimeOptimization(bool lto) {
+        _linkTimeOptimization = lto;
+    }
+
+    /**
+     * Provides the number of parallel jobs used by the link-time
+     * optimization.
+     *
+     * @return the number of jobs (zero if the number of hardware threads
+     *         is used)
+     */
+    size_t getLinkTimeOptimizationJobs() const {
+        return _linkTimeOptimizationJobs;
+    }
+
+    /**
+     * Defines the number of parallel jobs used to optimize and generate
+     * the code of the partitions of a library at link time.
+     *
+     * @param jobs the number of jobs (zero uses the number of hardware
+     *             threads)
+     */
+    void setLinkTimeOptimizationJobs(size_t jobs) {
+        _linkTimeOptimizationJobs = jobs;
+    }
+
+    /**
+     * Provides the flags used to compile each translation unit since the
+     * last cleanup.
+     * Flags are only registered when a compile time budget is defined.
+     *
+     * @return maps the translation unit names to their compile flags
+     */
+    const std::map<std::string, std::vector<std::string>>& getUnitCompileFlags() const {
+        return _unitCompileFlags;
+    }
+
     /**
      * Compiles the provided C source code.
      *
@@ -161,16 +426,31 @@ public:
 
         system::createFolder(this->_tmpFolder);
 
+        for (const auto& s : sources) {
+            _sfiles.insert(s.first);
+        }
+
+        // the translation units to compile
+        std::list<std::string> unitySources;
+        std::map<std::string, const std::string*> units = createTranslationUnits(sources, unitySources);
+
+        // translation units compiled with reduced optimization
+        std::set<std::string> reduced;
+        std::vector<std::string> reducedFlags;
+        if (_compileTimeBudget > 0) {
+            reduced = selectReducedOptimization(units);
+            reducedFlags = createReducedCompileFlags();
+        }
+
         // determine the maximum file name length
         size_t maxsize = 0;
-        std::map<std::string, std::string>::const_iterator it;
-        for (it = sources.begin(); it != sources.end(); ++it) {
-            _sfiles.insert(it->first);
+        std::map<std::string, const std::string*>::const_iterator it;
+        for (it = units.begin(); it != units.end(); ++it) {
             std::string file = system::createPath(this->_tmpFolder, it->first + outputExtension);
             maxsize = std::max<size_t>(maxsize, file.size());
         }
 
-        size_t countWidth = std::ceil(std::log10(sources.size()));
+        size_t countWidth = std::ceil(std::log10(units.size()));
 
         size_t count = 0;
         if (timer != nullptr) {
@@ -189,7 +469,7 @@ public:
         }
 
         // compile each source code file into a different object file
-        for (it = sources.begin(); it != sources.end(); ++it) {
+        for (it = units.begin(); it != units.end(); ++it) {
             count++;
             std::string file = system::createPath(this->_tmpFolder, it->first + outputExtension);
             outputFiles.insert(file);
@@ -198,7 +478,7 @@ public:
 
             if (timer != nullptr || _verbose) {
                 os << "[" << std::setw(countWidth) << std::setfill(' ') << std::right << count
-                        << "/" << sources.size() << "]";
+                        << "/" << units.size() << "]";
             }
 
             if (timer != nullptr) {
@@ -215,19 +495,37 @@ public:
                 std::cout.fill(f); // restore fill character
             }
 
-            if (_saveToDiskFirst) {
-                // save a new source file to disk
-                std::ofstream sourceFile;
-                std::string srcfile = system::createPath(_sourcesFolder, it->first);
-                sourceFile.open(srcfile.c_str());
-                sourceFile << it->second;
-                sourceFile.close();
-
-                // compile the file
-                compileFile(srcfile, file, posIndepCode);
+            auto compile = [&]() {
+                if (_saveToDiskFirst) {
+                    // save a new source file to disk
+                    std::ofstream sourceFile;
+                    std::string srcfile = system::createPath(_sourcesFolder, it->first);
+                    sourceFile.open(srcfile.c_str());
+                    sourceFile << *it->second;
+                    sourceFile.close();
+
+                    // compile the file
+                    compileFile(srcfile, file, posIndepCode);
+                } else {
+                    // compile without saving the source code to disk
+                    compileSource(*it->second, file, posIndepCode);
+                }
+            };
+
+            if (reduced.find(it->first) != reduced.end()) {
+                _unitCompileFlags[it->first] = reducedFlags;
+                _compileFlags.swap(reducedFlags);
+                try {
+                    compile();
+                } catch (...) {
+                    _compileFlags.swap(reducedFlags);
+                    throw;
+                }
+                _compileFlags.swap(reducedFlags);
             } else {
-                 // compile without saving the source code to disk
-                compileSource(it->second, file, posIndepCode);
+                if (_compileTimeBudget > 0)
+                    _unitCompileFlags[it->first] = _compileFlags;
+                compile();
             }
 
             if (timer != nullptr) {
@@ -243,6 +541,77 @@ public:
 
     }
 
+    /**
+     * Compiles the source files written to a source file stream.
+     * Each file is compiled directly from disk (compressed files are
+     * extracted one at a time) so that the source code is never loaded
+     * into memory.
+     * Files which were already compiled (e.g. with compileStreamedFile()
+     * while the sources were generated) are skipped.
+     * Unity builds and the compile time budget are not applied to these
+     * files.
+     *
+     * @param stream the stream with the source files
+     * @param posIndepCode whether or not to create position-independent
+     *                     code for dynamic linking
+     */
+    virtual void compileSourceStream(SourceFileStream& stream,
+                                     bool posIndepCode,
+                                     JobTimer* timer = nullptr) {
+        std::vector<std::string> names;
+        for (const auto& f : stream.getFiles()) {
+            if (_sfiles.find(f.first) == _sfiles.end())
+                names.push_back(f.first);
+        }
+
+        for (size_t i = 0; i < names.size(); i++) {
+            if (timer != nullptr) {
+                std::ostringstream os;
+                os << "[" << (i + 1) << "/" << names.size() << "]";
+                timer->startingJob("'" + names[i] + "'", JobTypeHolder<>::COMPILING, os.str());
+            }
+
+            compileStreamedFile(stream, names[i], posIndepCode);
+
+            if (timer != nullptr) {
+                timer->finishedJob();
+            }
+        }
+    }
+
+    /**
+     * Compiles a single source file written to a source file stream.
+     * This method can be called from a thread which does not write to the
+     * stream, but calls to the compiler must not be concurrent.
+     *
+     * @param stream the stream with the source file
+     * @param name the source file name
+     * @param posIndepCode whether or not to create position-independent
+     *                     code for dynamic linking
+     */
+    virtual void compileStreamedFile(SourceFileStream& stream,
+                                     const std::string& name,
+                                     bool posIndepCode) {
+        system::createFolder(this->_tmpFolder);
+
+        std::string file = system::createPath(this->_tmpFolder, name + ".o");
+        _sfiles.insert(name);
+        _ofiles.insert(file);
+
+        if (_verbose) {
+            std::cout << "compiling '" << file << "'" << std::endl;
+        }
+
+        std::string srcfile = stream.extract(name);
+        try {
+            compileFile(srcfile, file, posIndepCode);
+        } catch (...) {
+            stream.release(name, srcfile);
+            throw;
+        }
+        stream.release(name, srcfile);
+    }
+
     /**
      * Creates a dynamic library from a set of object files
      *
@@ -259,6 +628,8 @@ public:
         }
         _ofiles.clear();
         _sfiles.clear();
+        _unitCompileFlags.clear();
+        _estimatedCompileTime = 0;
 
         remove(this->_tmpFolder.c_str());
     }
@@ -269,6 +640,309 @@ public:
 
 protected:
 
+    /**
+     * Determines the translation units which will be compiled.
+     * Small source files are grouped into unity translation units when
+     * a maximum unity translation unit size was defined.
+     *
+     * @param sources maps the names to the content of the source files
+     * @param unitySources where the content of the unity translation units
+     *                     is stored
+     * @return maps the names to the content of the translation units
+     */
+    virtual std::map<std::string, const std::string*> createTranslationUnits(const std::map<std::string, std::string>& sources,
+                                                                             std::list<std::string>& unitySources) const {
+        std::map<std::string, const std::string*> units;
+
+        std::vector<const std::pair<const std::string, std::string>*> group;
+        size_t groupSize = 0;
+
+        auto flushGroup = [&]() {
+            if (group.size() == 1) {
+                units[group[0]->first] = &group[0]->second;
+            } else if (group.size() > 1) {
+                std::string name = "cppadcg_unity" + std::to_string(unitySources.size()) + ".c";
+                while (sources.find(name) != sources.end()) {
+                    name = "_" + name;
+                }
+
+                unitySources.emplace_back();
+                std::string& unity = unitySources.back();
+                unity.reserve(groupSize + group.size() * 64);
+                for (const auto* s : group) {
+                    unity += "#line 1 \"" + s->first + "\"\n";
+                    unity += s->second;
+                    unity += "\n";
+                }
+                units[name] = &unity;
+            }
+            group.clear();
+            groupSize = 0;
+        };
+
+        for (const auto& s : sources) {
+            if (_unityBuildMaxSize == 0 ||
+                s.second.size() >= _unityBuildMaxSize ||
+                !isUnityCompatible(s.second)) {
+                units[s.first] = &s.second;
+                continue;
+            }
+
+            if (groupSize + s.second.size() > _unityBuildMaxSize) {
+                flushGroup();
+            }
+            group.push_back(&s);
+            groupSize += s.second.size();
+        }
+        flushGroup();
+
+        return units;
+    }
+
+    /**
+     * Determines which translation units are compiled with the reduced
+     * optimization flags so that the estimated compile time fits in the
+     * remaining compile time budget.
+     * The translation units with the largest estimated savings are
+     * selected first.
+     *
+     * @param units maps the names to the content of the translation units
+     * @return the names of the translation units to compile with reduced
+     *         optimization
+     */
+    virtual std::set<std::string> selectReducedOptimization(const std::map<std::string, const std::string*>& units) {
+        struct UnitCost {
+            const std::string* name;
+            double optimized;
+            double reduced;
+        };
+
+        std::vector<UnitCost> costs;
+        costs.reserve(units.size());
+        double total = 0;
+        for (const auto& u : units) {
+            UnitCost c{&u.first, estimateCompileTime(*u.second, false), estimateCompileTime(*u.second, true)};
+            total += c.optimized;
+            costs.push_back(c);
+        }
+
+        std::sort(costs.begin(), costs.end(), [](const UnitCost& a, const UnitCost& b) {
+            return a.optimized - a.reduced > b.optimized - b.reduced;
+        });
+
+        double budget = _compileTimeBudget - _estimatedCompileTime;
+
+        std::set<std::string> reduced;
+        for (const UnitCost& c : costs) {
+            if (total <= budget || c.optimized <= c.reduced)
+                break;
+            total -= c.optimized - c.reduced;
+            reduced.insert(*c.name);
+        }
+
+        _estimatedCompileTime += total;
+
+        return reduced;
+    }
+
+    /**
+     * Provides a rough estimate of the time required to compile a source
+     * file (see setCompileTimeStartup(), setCompileTimePerOperation(), and
+     * setCompileTimeOptimization()).
+     * The optimized compilation time of straight-line code grows
+     * super-linearly with the number of operations.
+     *
+     * @param source the content of the source file
+     * @param reduced whether or not the reduced optimization flags are used
+     * @return the estimated compile time in seconds
+     */
+    virtual double estimateCompileTime(const std::string& source,
+                                       bool reduced) const {
+        double ops = double(countOperations(source));
+
+        double time = _compileTimeStartup + _compileTimePerOperation * ops; // process start up and parsing
+        if (!reduced)
+            time += _compileTimeOptimization * ops * std::sqrt(ops);
+        return time;
+    }
+
+    /**
+     * Determines the number of operations in a source file.
+     * The generated code uses one statement per operation and therefore
+     * the number of statements is used.
+     *
+     * @param source the content of the source file
+     */
+    virtual size_t countOperations(const std::string& source) const {
+        return std::count(source.begin(), source.end(), ';');
+    }
+
+    /**
+     * Creates the compile flags used for translation units which are
+     * compiled with reduced optimization.
+     */
+    virtual std::vector<std::string> createReducedCompileFlags() const {
+        std::vector<std::string> flags;
+        for (const std::string& f : _compileFlags) {
+            if (f.compare(0, 2, "-O") != 0)
+                flags.push_back(f);
+        }
+        flags.insert(flags.end(), _reducedOptimizationFlags.begin(), _reducedOptimizationFlags.end());
+        return flags;
+    }
+
+    /**
+     * Determines the number of parallel jobs used by the link-time
+     * optimization.
+     */
+    size_t countLinkTimeOptimizationJobs() const {
+        if (_linkTimeOptimizationJobs > 0)
+            return _linkTimeOptimizationJobs;
+        return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    /**
+     * Determines whether or not a source file can be concatenated with
+     * other source files into the same translation unit.
+     * Source files with file scope type definitions (typedef, struct,
+     * union, and enum definitions), static declarations, or macro
+     * definitions can only be merged when those are protected by an
+     * include guard.
+     * Comments, string literals, and the contents of blocks are ignored
+     * and the declarations are detected independently of their
+     * formatting.
+     *
+     * @param source the content of the source file
+     */
+    static bool isUnityCompatible(const std::string& source) {
+        const size_t n = source.size();
+
+        std::string guardMacro; // the macro of a #ifndef which can be an include guard
+        std::vector<bool> conditionals; // whether or not each open #if is an include guard
+        size_t guards = 0;
+        size_t depth = 0; // block depth
+        int aggregate = 0; // 1 after struct/union/enum, 2 after its tag
+        bool lineStart = true;
+
+        auto isIdChar = [](char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        };
+
+        size_t i = 0;
+        while (i < n) {
+            char c = source[i];
+
+            if (c == '\n') {
+                lineStart = true;
+                i++;
+                continue;
+            } else if (std::isspace(static_cast<unsigned char>(c))) {
+                i++;
+                continue;
+            } else if (c == '/' && i + 1 < n && source[i + 1] == '/') {
+                i = source.find('\n', i);
+                if (i == std::string::npos)
+                    break;
+                continue;
+            } else if (c == '/' && i + 1 < n && source[i + 1] == '*') {
+                i = source.find("*/", i + 2);
+                if (i == std::string::npos)
+                    break;
+                i += 2;
+                continue;
+            }
+
+            if (c == '#' && lineStart) {
+                // preprocessor directive (possibly with line continuations)
+                size_t end = i;
+                while (end < n && (source[end] != '\n' || source[end - 1] == '\\'))
+                    end++;
+
+                std::istringstream directive(source.substr(i + 1, end - i - 1));
+                std::string name, arg, rest;
+                directive >> name >> arg >> rest;
+                i = end;
+
+                if (!guardMacro.empty()) {
+                    bool isGuard = name == "define" && arg == guardMacro && rest.empty();
+                    conditionals.push_back(isGuard);
+                    guardMacro.clear();
+                    if (isGuard) {
+                        guards++;
+                        continue;
+                    }
+                }
+
+                if (name == "ifndef") {
+                    guardMacro = arg;
+                    if (guardMacro.empty())
+                        conditionals.push_back(false);
+                } else if (name.compare(0, 2, "if") == 0) {
+                    conditionals.push_back(false);
+                } else if (name == "endif") {
+                    if (!conditionals.empty()) {
+                        if (conditionals.back())
+                            guards--;
+                        conditionals.pop_back();
+                    }
+                } else if (guards == 0 && (name == "define" || name == "undef")) {
+                    return false;
+                }
+                continue;
+            }
+
+            if (!guardMacro.empty()) {
+                // the #ifndef is not an include guard
+                conditionals.push_back(false);
+                guardMacro.clear();
+            }
+            lineStart = false;
+
+            if (c == '"' || c == '\'') {
+                // string or character literal
+                for (i++; i < n && source[i] != c; i++) {
+                    if (source[i] == '\\')
+                        i++;
+                }
+                i++;
+                aggregate = 0;
+                continue;
+            }
+
+            if (isIdChar(c)) {
+                size_t end = i;
+                while (end < n && isIdChar(source[end]))
+                    end++;
+
+                if (guards == 0 && depth == 0) {
+                    const std::string word = source.substr(i, end - i);
+                    if (word == "static" || word == "typedef") {
+                        return false;
+                    } else if (word == "struct" || word == "union" || word == "enum") {
+                        aggregate = 1;
+                    } else {
+                        aggregate = aggregate != 0 ? 2 : 0; // the tag
+                    }
+                }
+                i = end;
+                continue;
+            }
+
+            if (c == '{') {
+                if (aggregate != 0 && guards == 0 && depth == 0)
+                    return false; // type definition
+                depth++;
+            } else if (c == '}') {
+                if (depth > 0)
+                    depth--;
+            }
+            aggregate = 0;
+            i++;
+        }
+
+        return true;
+    }
+
     /**
      * Compiles a single source file into an object file.
      *
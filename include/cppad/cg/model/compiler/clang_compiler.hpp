@@ -100,6 +100,7 @@ public:
 
         std::vector<std::string> args;
         args.insert(args.end(), this->_compileLibFlags.begin(), this->_compileLibFlags.end());
+        addLinkTimeOptimizationFlags(args, true);
         args.push_back(linkerFlags); // Pass suitable options to linker
         args.push_back("-o"); // Output file name
         args.push_back(library); // Output file name
@@ -165,6 +166,7 @@ protected:
         args.push_back("-x");
         args.push_back("c"); // C source files
         args.insert(args.end(), this->_compileFlags.begin(), this->_compileFlags.end());
+        addLinkTimeOptimizationFlags(args, false);
         args.push_back("-c");
         args.push_back("-");
         if (posIndepCode) {
@@ -183,6 +185,7 @@ protected:
         args.push_back("-x");
         args.push_back("c"); // C source files
         args.insert(args.end(), this->_compileFlags.begin(), this->_compileFlags.end());
+        addLinkTimeOptimizationFlags(args, false);
         if (posIndepCode) {
             args.push_back("-fPIC"); // position-independent code for dynamic linking
         }
@@ -194,6 +197,26 @@ protected:
         system::callExecutable(this->_path, args);
     }
 
+    /**
+     * Adds the flags required for (thin) link-time optimization, if enabled.
+     * The linker must support LLVM bitcode (e.g. lld or gold with the LLVM
+     * plugin), which can be selected with a library flag such as
+     * -fuse-ld=lld.
+     *
+     * @param args the compiler arguments
+     * @param link whether or not the arguments are used to link a library
+     */
+    void addLinkTimeOptimizationFlags(std::vector<std::string>& args,
+                                      bool link) const {
+        if (!this->_linkTimeOptimization)
+            return;
+
+        args.push_back("-flto=thin");
+        if (link) {
+            args.push_back("-flto-jobs=" + std::to_string(this->countLinkTimeOptimizationJobs()));
+        }
+    }
+
 };
 
 } // END cg namespace
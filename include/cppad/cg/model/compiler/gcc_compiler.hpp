@@ -59,6 +59,7 @@ public:
 
         std::vector<std::string> args;
         args.insert(args.end(), this->_compileLibFlags.begin(), this->_compileLibFlags.end());
+        addLinkTimeOptimizationFlags(args, true);
         args.push_back(linkerFlags); // Pass suitable options to linker
         args.push_back("-o"); // Output file name
         args.push_back(library); // Output file name
@@ -96,6 +97,7 @@ protected:
         args.push_back("-x");
         args.push_back("c"); // C source files
         args.insert(args.end(), this->_compileFlags.begin(), this->_compileFlags.end());
+        addLinkTimeOptimizationFlags(args, false);
         args.push_back("-c");
         args.push_back("-");
         if (posIndepCode) {
@@ -114,6 +116,7 @@ protected:
         args.push_back("-x");
         args.push_back("c"); // C source files
         args.insert(args.end(), this->_compileFlags.begin(), this->_compileFlags.end());
+        addLinkTimeOptimizationFlags(args, false);
         if (posIndepCode) {
             args.push_back("-fPIC"); // position-independent code for dynamic linking
         }
@@ -125,6 +128,27 @@ protected:
         system::callExecutable(this->_path, args);
     }
 
+    /**
+     * Adds the flags required for link-time optimization, if enabled.
+     * Semantic interposition is disabled so that the exported functions of
+     * the library can still be inlined into each other.
+     *
+     * @param args the compiler arguments
+     * @param link whether or not the arguments are used to link a library
+     */
+    void addLinkTimeOptimizationFlags(std::vector<std::string>& args,
+                                      bool link) const {
+        if (!this->_linkTimeOptimization)
+            return;
+
+        if (link) {
+            args.push_back("-flto=" + std::to_string(this->countLinkTimeOptimizationJobs())); // parallel LTRANS
+        } else {
+            args.push_back("-flto");
+        }
+        args.push_back("-fno-semantic-interposition");
+    }
+
 };
 
 } // END cg namespace
@@ -131,20 +131,32 @@ public:
 
         const std::map<std::string, ModelCSourceGen < Base>*>&models = this->modelLibraryHelper_->getModels();
         try {
-            for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
+            {
+                // streamed sources are compiled while the other sources are generated
+                typename ModelLibraryProcessor<Base>::StreamedSourcesCompiler streamCompiler(*this->modelLibraryHelper_, compiler, true);
 
-                this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, true, this->modelLibraryHelper_);
-                this->modelLibraryHelper_->finishedJob();
+                for (const auto& p : models) {
+                    const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
+
+                    std::unique_lock<std::mutex> lock = streamCompiler.lock();
+                    this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
+                    compiler.compileSources(modelSources, true, this->modelLibraryHelper_);
+                    this->modelLibraryHelper_->finishedJob();
+                }
+
+                streamCompiler.finish();
             }
 
+            this->compileStreamedSources(compiler, true);
+
             const std::map<std::string, std::string>& sources = this->getLibrarySources();
             compiler.compileSources(sources, true, this->modelLibraryHelper_);
 
             const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
             compiler.compileSources(customSource, true, this->modelLibraryHelper_);
 
+            this->compileCompileFlagsSource(compiler, true);
+
             std::string libname = _libraryName;
             if (_customLibExtension != nullptr)
                 libname += *_customLibExtension;
@@ -167,6 +179,79 @@ public:
             return std::unique_ptr<DynamicLib<Base>> (nullptr);
     }
 
+    /**
+     * Creates a model which can be used immediately from a library built
+     * with a fast compiler (e.g. without optimizations) while the
+     * optimized library is built in a background thread.
+     * The evaluations are switched to the optimized library as soon as it
+     * is loaded.
+     *
+     * The fast library is created with the suffix "_fast" added to the
+     * library name.
+     * The optimized build uses a copy of the generated sources and shares
+     * the ownership of the optimized compiler, therefore this processor
+     * and the source generators can be used or destroyed before it
+     * finishes.
+     *
+     * @param modelName The name of the model to load
+     * @param fastCompiler The compiler used to create the library which
+     *                     is used until the optimized library is ready
+     * @param optimizedCompiler The compiler used to create the optimized
+     *                          library (it must not be used elsewhere until
+     *                          the optimized build finishes)
+     * @return the model
+     * @throws CGException if the model does not exist in the library
+     */
+    std::unique_ptr<TieredGenericModel<Base>> createTieredModel(const std::string& modelName,
+                                                                CCompiler<Base>& fastCompiler,
+                                                                std::shared_ptr<CCompiler<Base>> optimizedCompiler) {
+        CPPADCG_ASSERT_KNOWN(optimizedCompiler != nullptr, "Invalid compiler")
+
+        const std::string libraryName = _libraryName;
+
+        std::unique_ptr<DynamicLib<Base>> fastLib;
+        _libraryName = libraryName + "_fast";
+        try {
+            fastLib = createDynamicLibrary(fastCompiler);
+        } catch (...) {
+            _libraryName = libraryName;
+            throw;
+        }
+        _libraryName = libraryName;
+
+        /**
+         * the sources were already generated for the fast library
+         */
+        auto sources = std::make_shared<std::map<std::string, std::string>>();
+        for (const auto& p : this->modelLibraryHelper_->getModels()) {
+            const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
+            sources->insert(modelSources.begin(), modelSources.end());
+        }
+        this->processStreamedSources([&sources](const std::map<std::string, std::string>& streamed) {
+            sources->insert(streamed.begin(), streamed.end());
+        });
+        const std::map<std::string, std::string>& libSources = this->getLibrarySources();
+        sources->insert(libSources.begin(), libSources.end());
+        const std::map<std::string, std::string>& customSources = this->modelLibraryHelper_->getCustomSources();
+        sources->insert(customSources.begin(), customSources.end());
+
+        std::string libname = _libraryName;
+        if (_customLibExtension != nullptr)
+            libname += *_customLibExtension;
+        else
+            libname += system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+
+        std::map<std::string, std::string> options = _options;
+
+        auto builder = [optimizedCompiler, sources, libname, options]() {
+            return DynamicModelLibraryProcessor<Base>::createDynamicLibrary(*optimizedCompiler, *sources, libname, options);
+        };
+
+        return std::unique_ptr<TieredGenericModel<Base>>(new TieredGenericModel<Base>(std::move(fastLib),
+                                                                                      modelName,
+                                                                                      builder));
+    }
+
     /**
      * Compiles all models and generates a static library.
      * 
@@ -188,20 +273,32 @@ public:
 
         const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
         try {
-            for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
+            {
+                // streamed sources are compiled while the other sources are generated
+                typename ModelLibraryProcessor<Base>::StreamedSourcesCompiler streamCompiler(*this->modelLibraryHelper_, compiler, posIndepCode);
+
+                for (const auto& p : models) {
+                    const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
 
-                this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
-                this->modelLibraryHelper_->finishedJob();
+                    std::unique_lock<std::mutex> lock = streamCompiler.lock();
+                    this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
+                    compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
+                    this->modelLibraryHelper_->finishedJob();
+                }
+
+                streamCompiler.finish();
             }
 
+            this->compileStreamedSources(compiler, posIndepCode);
+
             const std::map<std::string, std::string>& sources = this->getLibrarySources();
             compiler.compileSources(sources, posIndepCode, this->modelLibraryHelper_);
 
             const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
             compiler.compileSources(customSource, posIndepCode, this->modelLibraryHelper_);
 
+            this->compileCompileFlagsSource(compiler, posIndepCode);
+
             std::string libname = _libraryName;
             if (_customLibExtension != nullptr)
                 libname += *_customLibExtension;
@@ -223,6 +320,51 @@ protected:
 
     virtual std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary();
 
+    /**
+     * Loads a dynamic library.
+     *
+     * @param library the path of the dynamic library (with the extension)
+     * @param options system dependent custom options
+     */
+    static std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary(const std::string& library,
+                                                                const std::map<std::string, std::string>& options);
+
+    /**
+     * Compiles previously generated sources into a dynamic library without
+     * using the source generators (e.g. from a background thread).
+     *
+     * @param compiler The compiler used to compile the sources and create
+     *                 the dynamic library
+     * @param sources maps the names to the content of the source files
+     * @param library the path of the dynamic library (with the extension)
+     * @param options system dependent custom options
+     * @return The loaded dynamic library
+     */
+    static std::unique_ptr<DynamicLib<Base>> createDynamicLibrary(CCompiler<Base>& compiler,
+                                                                  const std::map<std::string, std::string>& sources,
+                                                                  const std::string& library,
+                                                                  const std::map<std::string, std::string>& options) {
+        try {
+            compiler.compileSources(sources, true);
+
+            auto* cCompiler = dynamic_cast<AbstractCCompiler<Base>*>(&compiler);
+            if (cCompiler != nullptr && !cCompiler->getUnitCompileFlags().empty()) {
+                std::map<std::string, std::string> flagsSource;
+                flagsSource[ModelLibraryCSourceGen<Base>::FUNCTION_COMPILEFLAGS + ".c"] =
+                        ModelLibraryCSourceGen<Base>::createCompileFlagsSource(cCompiler->getUnitCompileFlags());
+                compiler.compileSources(flagsSource, true);
+            }
+
+            compiler.buildDynamic(library);
+        } catch (...) {
+            compiler.cleanup();
+            throw;
+        }
+        compiler.cleanup();
+
+        return loadDynamicLibrary(library, options);
+    }
+
 };
 
 } // END cg namespace
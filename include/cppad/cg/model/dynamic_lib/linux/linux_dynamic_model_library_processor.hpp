@@ -21,13 +21,19 @@ namespace cg {
 
 template<class Base>
 std::unique_ptr<DynamicLib<Base>> DynamicModelLibraryProcessor<Base>::loadDynamicLibrary() {
+    return loadDynamicLibrary(_libraryName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION, _options);
+}
+
+template<class Base>
+std::unique_ptr<DynamicLib<Base>> DynamicModelLibraryProcessor<Base>::loadDynamicLibrary(const std::string& library,
+                                                                                         const std::map<std::string, std::string>& options) {
     std::unique_ptr<DynamicLib<Base>> lib;
-    const auto it = _options.find("dlOpenMode");
-    if (it == _options.end()) {
-        lib.reset(new LinuxDynamicLib<Base>(_libraryName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
+    const auto it = options.find("dlOpenMode");
+    if (it == options.end()) {
+        lib.reset(new LinuxDynamicLib<Base>(library));
     } else {
         int dlOpenMode = std::stoi(it->second);
-        lib.reset(new LinuxDynamicLib<Base>(_libraryName + system::SystemInfo<>::DYNAMIC_LIB_EXTENSION, dlOpenMode));
+        lib.reset(new LinuxDynamicLib<Base>(library, dlOpenMode));
     }
     return lib;
 }
@@ -0,0 +1,550 @@
+#ifndef CPPAD_CG_TIERED_GENERIC_MODEL_INCLUDED
+#define CPPAD_CG_TIERED_GENERIC_MODEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A model which is initially evaluated using a library that is fast to
+ * build (e.g. compiled without optimizations) while an optimized library
+ * is built in a background thread.
+ * Once the optimized library is ready, the evaluations are switched
+ * atomically to the optimized model.
+ *
+ * Atomic functions, external models, and dynamic parameters defined in
+ * this model are also defined in the optimized model before the switch.
+ * The initial library is only released when this object is destroyed so
+ * that evaluations running during the switch remain valid.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class TieredGenericModel : public GenericModel<Base> {
+public:
+    using LibraryBuilder = std::function<std::unique_ptr<DynamicLib<Base>>()>;
+protected:
+    /**
+     * the model name
+     */
+    const std::string _name;
+    /**
+     * the library which is fast to build
+     */
+    std::unique_ptr<DynamicLib<Base>> _baseLib;
+    /**
+     * the optimized library (null until it is ready)
+     */
+    std::unique_ptr<DynamicLib<Base>> _optimizedLib;
+    /**
+     * the model from the library which is fast to build
+     */
+    std::unique_ptr<GenericModel<Base>> _baseModel;
+    /**
+     * the model from the optimized library (null until it is ready)
+     */
+    std::unique_ptr<GenericModel<Base>> _optimizedModel;
+    /**
+     * the model currently used for evaluations
+     */
+    std::atomic<GenericModel<Base>*> _model;
+    /**
+     * protects the model configuration and the state of the optimized build
+     */
+    mutable std::mutex _mutex;
+    /**
+     * notifies the end of the optimized build
+     */
+    std::condition_variable _buildFinishedCond;
+    /**
+     * registered atomic functions
+     */
+    std::vector<atomic_base<Base>*> _atomics;
+    /**
+     * registered external models
+     */
+    std::vector<GenericModel<Base>*> _externalModels;
+    /**
+     * the last dynamic parameters defined
+     */
+    std::vector<Base> _dynamic;
+    /**
+     * whether or not the optimized build has finished (successfully or not)
+     */
+    bool _buildFinished;
+    /**
+     * the error which occurred while building the optimized library
+     */
+    std::exception_ptr _buildError;
+    /**
+     * the thread which builds the optimized library
+     */
+    std::thread _builder;
+public:
+
+    /**
+     * Creates a new tiered model and starts building the optimized
+     * library in a background thread.
+     *
+     * @param baseLibrary the library which is fast to build
+     * @param modelName the model name
+     * @param optimizedBuilder the function which creates the optimized
+     *                         library (called in a background thread)
+     * @throws CGException if the model does not exist in the library
+     */
+    TieredGenericModel(std::unique_ptr<DynamicLib<Base>> baseLibrary,
+                       std::string modelName,
+                       LibraryBuilder optimizedBuilder) :
+        _name(std::move(modelName)),
+        _baseLib(std::move(baseLibrary)),
+        _model(nullptr),
+        _buildFinished(false) {
+        CPPADCG_ASSERT_KNOWN(_baseLib != nullptr, "Invalid library")
+
+        _baseModel = _baseLib->model(_name);
+        if (_baseModel == nullptr)
+            throw CGException("Model '", _name, "' not found in the dynamic library");
+        _model = _baseModel.get();
+
+        _builder = std::thread([this, optimizedBuilder]() {
+            buildOptimized(optimizedBuilder);
+        });
+    }
+
+    TieredGenericModel(const TieredGenericModel&) = delete;
+    TieredGenericModel& operator=(const TieredGenericModel&) = delete;
+
+    /**
+     * Waits for the optimized build to finish.
+     */
+    virtual ~TieredGenericModel() {
+        if (_builder.joinable())
+            _builder.join();
+    }
+
+    /**
+     * Whether or not the evaluations are already using the optimized
+     * library.
+     */
+    inline bool isOptimized() const {
+        return _model.load(std::memory_order_acquire) != _baseModel.get();
+    }
+
+    /**
+     * Whether or not the optimized build has finished (successfully or not).
+     */
+    inline bool isBuildFinished() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _buildFinished;
+    }
+
+    /**
+     * Blocks until the optimized build finishes.
+     *
+     * @throws the exception thrown while building the optimized library
+     */
+    inline void waitForOptimized() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _buildFinishedCond.wait(lock, [this] { return _buildFinished; });
+        if (_buildError)
+            std::rethrow_exception(_buildError);
+    }
+
+    /**
+     * Provides the library currently used for evaluations.
+     */
+    inline DynamicLib<Base>& getCurrentLibrary() const {
+        return isOptimized() ? *_optimizedLib : *_baseLib;
+    }
+
+    const std::string& getName() const override {
+        return _name;
+    }
+
+    bool isJacobianSparsityAvailable() override {
+        return model().isJacobianSparsityAvailable();
+    }
+
+    SparsityPattern JacobianSparsityPattern() override {
+        return model().JacobianSparsityPattern();
+    }
+
+    std::vector<std::set<size_t> > JacobianSparsitySet() override {
+        return model().JacobianSparsitySet();
+    }
+
+    std::vector<bool> JacobianSparsityBool() override {
+        return model().JacobianSparsityBool();
+    }
+
+    void JacobianSparsity(std::vector<size_t>& equations,
+                          std::vector<size_t>& variables) override {
+        model().JacobianSparsity(equations, variables);
+    }
+
+    bool isHessianSparsityAvailable() override {
+        return model().isHessianSparsityAvailable();
+    }
+
+    SparsityPattern HessianSparsityPattern() override {
+        return model().HessianSparsityPattern();
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet() override {
+        return model().HessianSparsitySet();
+    }
+
+    std::vector<bool> HessianSparsityBool() override {
+        return model().HessianSparsityBool();
+    }
+
+    void HessianSparsity(std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        model().HessianSparsity(rows, cols);
+    }
+
+    bool isEquationHessianSparsityAvailable() override {
+        return model().isEquationHessianSparsityAvailable();
+    }
+
+    SparsityPattern HessianSparsityPattern(size_t i) override {
+        return model().HessianSparsityPattern(i);
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
+        return model().HessianSparsitySet(i);
+    }
+
+    std::vector<bool> HessianSparsityBool(size_t i) override {
+        return model().HessianSparsityBool(i);
+    }
+
+    void HessianSparsity(size_t i,
+                         std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        model().HessianSparsity(i, rows, cols);
+    }
+
+    void JacobianSparsityCSR(std::vector<size_t>& rowStart,
+                             std::vector<size_t>& cols) override {
+        model().JacobianSparsityCSR(rowStart, cols);
+    }
+
+    void JacobianSparsityCSC(std::vector<size_t>& colStart,
+                             std::vector<size_t>& rows) override {
+        model().JacobianSparsityCSC(colStart, rows);
+    }
+
+    void HessianSparsityCSR(std::vector<size_t>& rowStart,
+                            std::vector<size_t>& cols) override {
+        model().HessianSparsityCSR(rowStart, cols);
+    }
+
+    void HessianSparsityCSC(std::vector<size_t>& colStart,
+                            std::vector<size_t>& rows) override {
+        model().HessianSparsityCSC(colStart, rows);
+    }
+
+    size_t Domain() const override {
+        return model().Domain();
+    }
+
+    size_t Range() const override {
+        return model().Range();
+    }
+
+    size_t DynamicParameterSize() const override {
+        return model().DynamicParameterSize();
+    }
+
+    void setDynamicParameters(ArrayView<const Base> p) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _dynamic.assign(p.data(), p.data() + p.size());
+        model().setDynamicParameters(p);
+    }
+
+    ArrayView<const Base> getDynamicParameters() const override {
+        return model().getDynamicParameters();
+    }
+
+    const std::vector<std::string>& getAtomicFunctionNames() override {
+        return model().getAtomicFunctionNames();
+    }
+
+    bool addAtomicFunction(atomic_base<Base>& atomic) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        bool added = model().addAtomicFunction(atomic);
+        if (added)
+            _atomics.push_back(&atomic);
+        return added;
+    }
+
+    bool addExternalModel(GenericModel<Base>& atomic) override {
+        std::lock_guard<std::mutex> lock(_mutex);
+        bool added = model().addExternalModel(atomic);
+        if (added)
+            _externalModels.push_back(&atomic);
+        return added;
+    }
+
+    bool isForwardZeroAvailable() override {
+        return model().isForwardZeroAvailable();
+    }
+
+    using GenericModel<Base>::ForwardZero;
+
+    void ForwardZero(const CppAD::vector<bool>& vx,
+                     CppAD::vector<bool>& vy,
+                     ArrayView<const Base> tx,
+                     ArrayView<Base> ty) override {
+        model().ForwardZero(vx, vy, tx, ty);
+    }
+
+    void ForwardZero(ArrayView<const Base> x,
+                     ArrayView<Base> dep) override {
+        model().ForwardZero(x, dep);
+    }
+
+    void ForwardZero(const std::vector<const Base*>& x,
+                     ArrayView<Base> dep) override {
+        model().ForwardZero(x, dep);
+    }
+
+    bool isForwardZeroIncrementalAvailable() override {
+        return model().isForwardZeroIncrementalAvailable();
+    }
+
+    void ForwardZeroIncremental(ArrayView<const Base> x,
+                                ArrayView<const size_t> changed,
+                                ArrayView<Base> dep) override {
+        model().ForwardZeroIncremental(x, changed, dep);
+    }
+
+    bool isJacobianAvailable() override {
+        return model().isJacobianAvailable();
+    }
+
+    using GenericModel<Base>::Jacobian;
+
+    void Jacobian(ArrayView<const Base> x,
+                  ArrayView<Base> jac) override {
+        model().Jacobian(x, jac);
+    }
+
+    bool isHessianAvailable() override {
+        return model().isHessianAvailable();
+    }
+
+    using GenericModel<Base>::Hessian;
+
+    void Hessian(ArrayView<const Base> x,
+                 ArrayView<const Base> w,
+                 ArrayView<Base> hess) override {
+        model().Hessian(x, w, hess);
+    }
+
+    bool isForwardOneAvailable() override {
+        return model().isForwardOneAvailable();
+    }
+
+    using GenericModel<Base>::ForwardOne;
+
+    void ForwardOne(ArrayView<const Base> tx,
+                    ArrayView<Base> ty) override {
+        model().ForwardOne(tx, ty);
+    }
+
+    bool isSparseForwardOneAvailable() override {
+        return model().isSparseForwardOneAvailable();
+    }
+
+    void ForwardOne(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> ty1) override {
+        model().ForwardOne(x, tx1Nnz, idx, tx1, ty1);
+    }
+
+    bool isReverseOneAvailable() override {
+        return model().isReverseOneAvailable();
+    }
+
+    bool isSparseReverseOneAvailable() override {
+        return model().isSparseReverseOneAvailable();
+    }
+
+    using GenericModel<Base>::ReverseOne;
+
+    void ReverseOne(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        model().ReverseOne(tx, ty, px, py);
+    }
+
+    void ReverseOne(ArrayView<const Base> x,
+                    ArrayView<Base> px,
+                    size_t pyNnz, const size_t idx[], const Base py[]) override {
+        model().ReverseOne(x, px, pyNnz, idx, py);
+    }
+
+    bool isReverseTwoAvailable() override {
+        return model().isReverseTwoAvailable();
+    }
+
+    bool isSparseReverseTwoAvailable() override {
+        return model().isSparseReverseTwoAvailable();
+    }
+
+    using GenericModel<Base>::ReverseTwo;
+
+    void ReverseTwo(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        model().ReverseTwo(tx, ty, px, py);
+    }
+
+    void ReverseTwo(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> px2,
+                    ArrayView<const Base> py2) override {
+        model().ReverseTwo(x, tx1Nnz, idx, tx1, px2, py2);
+    }
+
+    bool isSparseJacobianAvailable() override {
+        return model().isSparseJacobianAvailable();
+    }
+
+    using GenericModel<Base>::SparseJacobian;
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac) override {
+        model().SparseJacobian(x, jac);
+    }
+
+    void SparseJacobian(const std::vector<Base>& x,
+                        std::vector<Base>& jac,
+                        std::vector<size_t>& row,
+                        std::vector<size_t>& col) override {
+        model().SparseJacobian(x, jac, row, col);
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        model().SparseJacobian(x, jac, row, col);
+    }
+
+    void SparseJacobian(const std::vector<const Base*>& x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        model().SparseJacobian(x, jac, row, col);
+    }
+
+    bool isSparseHessianAvailable() override {
+        return model().isSparseHessianAvailable();
+    }
+
+    using GenericModel<Base>::SparseHessian;
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess) override {
+        model().SparseHessian(x, w, hess);
+    }
+
+    void SparseHessian(const std::vector<Base>& x,
+                       const std::vector<Base>& w,
+                       std::vector<Base>& hess,
+                       std::vector<size_t>& row,
+                       std::vector<size_t>& col) override {
+        model().SparseHessian(x, w, hess, row, col);
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        model().SparseHessian(x, w, hess, row, col);
+    }
+
+    void SparseHessian(const std::vector<const Base*>& x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        model().SparseHessian(x, w, hess, row, col);
+    }
+
+protected:
+
+    /**
+     * Provides the model currently used for evaluations.
+     */
+    inline GenericModel<Base>& model() const {
+        return *_model.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Builds the optimized library, defines the same atomic functions,
+     * external models and dynamic parameters as the current model, and
+     * switches the evaluations to the optimized model.
+     */
+    virtual void buildOptimized(const LibraryBuilder& optimizedBuilder) {
+        try {
+            std::unique_ptr<DynamicLib<Base>> lib = optimizedBuilder();
+            if (lib == nullptr)
+                throw CGException("Failed to create the optimized library for model '", _name, "'");
+
+            std::unique_ptr<GenericModel<Base>> optimized = lib->model(_name);
+            if (optimized == nullptr)
+                throw CGException("Model '", _name, "' not found in the optimized dynamic library");
+
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            for (atomic_base<Base>* atomic : _atomics) {
+                optimized->addAtomicFunction(*atomic);
+            }
+            for (GenericModel<Base>* external : _externalModels) {
+                optimized->addExternalModel(*external);
+            }
+            if (!_dynamic.empty()) {
+                optimized->setDynamicParameters(ArrayView<const Base>(_dynamic));
+            }
+            optimized->setAtomicEvalForwardOne4CppAD(this->isAtomicEvalForwardOne4CppAD());
+
+            _optimizedLib = std::move(lib);
+            _optimizedModel = std::move(optimized);
+            _model.store(_optimizedModel.get(), std::memory_order_release);
+
+            _buildFinished = true;
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _buildError = std::current_exception();
+            _buildFinished = true;
+        }
+
+        _buildFinishedCond.notify_all();
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -41,6 +41,10 @@ protected:
     const std::string _name;
     size_t _m;
     size_t _n;
+    /// the number of dynamic parameters
+    size_t _np;
+    /// the current values of the dynamic parameters
+    std::vector<Base> _dynamic;
     std::vector<const Base*> _in;
     std::vector<const Base*> _inHess;
     std::vector<Base*> _out;
@@ -49,8 +53,18 @@ protected:
     std::vector<ExternalFunctionWrapper<Base>* > _atomic;
     size_t _missingAtomicFunctions;
     CppAD::vector<Base> _tx, _ty, _px, _py;
+    // partitions which must be re-evaluated by the incremental forward zero
+    std::vector<size_t> _changedPartitions;
     // original model function
     void (*_zero)(Base const*const*, Base * const*, LangCAtomicFun);
+    // original model function for a partition of the dependents
+    int (*_zeroPartition)(unsigned long, Base const *const *, Base * const *, LangCAtomicFun);
+    // dependents in each partition
+    void (*_zeroPartitionSparsity)(unsigned long, unsigned long const**, unsigned long*);
+    // partitions which depend on each independent variable
+    void (*_zeroIndepPartitions)(unsigned long, unsigned long const**, unsigned long*);
+    // number of operations of each partition followed by the number of operations of the full model
+    void (*_zeroPartitionCost)(unsigned long const**, unsigned long*);
     // first order forward mode
     int (*_forwardOne)(Base const tx[], Base ty[], LangCAtomicFun);
     // first order reverse mode
@@ -100,6 +114,8 @@ public:
             _name(std::move(other._name)),
             _m(other._m),
             _n(other._n),
+            _np(other._np),
+            _dynamic(std::move(other._dynamic)),
             _in(std::move(other._in)),
             _inHess(std::move(other._inHess)),
             _out(std::move(other._out)),
@@ -108,6 +124,10 @@ public:
             _atomic(std::move(other._atomic)),
             _missingAtomicFunctions(other._missingAtomicFunctions),
             _zero(other._zero),
+            _zeroPartition(other._zeroPartition),
+            _zeroPartitionSparsity(other._zeroPartitionSparsity),
+            _zeroIndepPartitions(other._zeroIndepPartitions),
+            _zeroPartitionCost(other._zeroPartitionCost),
             _forwardOne(other._forwardOne),
             _reverseOne(other._reverseOne),
             _reverseTwo(other._reverseTwo),
@@ -177,7 +197,7 @@ public:
         return s;
     }
 
-    std::vector<std::set<size_t> > JacobianSparsitySet() override {
+    SparsityPattern JacobianSparsityPattern() override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_jacobianSparsity != nullptr, "No Jacobian sparsity function defined in the dynamic library")
 
@@ -185,12 +205,11 @@ public:
         unsigned long nnz;
         (*_jacobianSparsity)(&row, &col, &nnz);
 
-        std::set<size_t> set_type;
-        std::vector<std::set<size_t> > s;
-
-        loadSparsity(set_type, s, _m, _n, row, col, nnz);
+        return SparsityPattern(_m, _n, row, col, nnz);
+    }
 
-        return s;
+    std::vector<std::set<size_t> > JacobianSparsitySet() override {
+        return JacobianSparsityPattern().toSets();
     }
 
     void JacobianSparsity(std::vector<size_t>& equations,
@@ -230,7 +249,7 @@ public:
         return s;
     }
 
-    std::vector<std::set<size_t> > HessianSparsitySet() override {
+    SparsityPattern HessianSparsityPattern() override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_hessianSparsity != nullptr, "No Hessian sparsity function defined in the dynamic library")
 
@@ -238,12 +257,11 @@ public:
         unsigned long nnz;
         (*_hessianSparsity)(&row, &col, &nnz);
 
-        std::set<size_t> set_type;
-        std::vector<std::set<size_t> > s;
-
-        loadSparsity(set_type, s, _n, _n, row, col, nnz);
+        return SparsityPattern(_n, _n, row, col, nnz);
+    }
 
-        return s;
+    std::vector<std::set<size_t> > HessianSparsitySet() override {
+        return HessianSparsityPattern().toSets();
     }
 
     void HessianSparsity(std::vector<size_t>& rows,
@@ -282,7 +300,7 @@ public:
         return s;
     }
 
-    std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
+    SparsityPattern HessianSparsityPattern(size_t i) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_hessianSparsity2 != nullptr, "No Hessian sparsity function defined in the dynamic library")
 
@@ -290,12 +308,11 @@ public:
         unsigned long nnz;
         (*_hessianSparsity2)(i, &row, &col, &nnz);
 
-        std::set<size_t> set_type;
-        std::vector<std::set<size_t> > s;
-
-        loadSparsity(set_type, s, _n, _n, row, col, nnz);
+        return SparsityPattern(_n, _n, row, col, nnz);
+    }
 
-        return s;
+    std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
+        return HessianSparsityPattern(i).toSets();
     }
 
     void HessianSparsity(size_t i, std::vector<size_t>& rows,
@@ -326,6 +343,22 @@ public:
         return _m;
     }
 
+    /// number of dynamic parameters
+
+    size_t DynamicParameterSize() const override {
+        return _np;
+    }
+
+    void setDynamicParameters(ArrayView<const Base> p) override {
+        CPPADCG_ASSERT_KNOWN(p.size() == _np, "Invalid dynamic parameter array size")
+
+        std::copy(p.data(), p.data() + _np, _dynamic.begin());
+    }
+
+    ArrayView<const Base> getDynamicParameters() const override {
+        return ArrayView<const Base>(_dynamic);
+    }
+
     bool isForwardZeroAvailable() override {
         return _zero != nullptr;
     }
@@ -337,7 +370,7 @@ public:
                      ArrayView<Base> dep) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
@@ -353,13 +386,14 @@ public:
                      ArrayView<Base> dep) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == x.size(), "The number of independent variable arrays is invalid")
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == x.size(), "The number of independent variable arrays is invalid")
         CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
+        std::copy(x.begin(), x.end(), _in.begin());
         _out[0] = dep.data();
 
-        (*_zero)(&x[0], &_out[0], _atomicFuncArg);
+        (*_zero)(&_in[0], &_out[0], _atomicFuncArg);
     }
 
     void ForwardZero(const CppAD::vector<bool>& vx,
@@ -368,7 +402,7 @@ public:
                      ArrayView<Base> ty) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_zero != nullptr, "No zero order forward function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(tx.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(ty.size() == _m, "Invalid dependent array size")
@@ -394,6 +428,83 @@ public:
         }
     }
 
+    bool isForwardZeroIncrementalAvailable() override {
+        return _zeroPartition != nullptr && _zeroPartitionSparsity != nullptr && _zeroIndepPartitions != nullptr;
+    }
+
+    void ForwardZeroIncremental(ArrayView<const Base> x,
+                                ArrayView<const size_t> changed,
+                                ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        CPPADCG_ASSERT_KNOWN(_zeroPartition != nullptr, "No incremental zero order forward function defined in the dynamic library")
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
+                             " please use the variable size methods")
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size")
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
+
+        /**
+         * determine the affected partitions
+         */
+        unsigned long const* pos;
+        size_t nnz = 0;
+
+        _changedPartitions.clear();
+        for (size_t j : changed) {
+            CPPADCG_ASSERT_KNOWN(j < _n, "Invalid independent variable index")
+            (*_zeroIndepPartitions)(j, &pos, &nnz);
+            _changedPartitions.insert(_changedPartitions.end(), pos, pos + nnz);
+        }
+
+        if (_changedPartitions.empty())
+            return; //nothing to do
+
+        std::sort(_changedPartitions.begin(), _changedPartitions.end());
+        _changedPartitions.erase(std::unique(_changedPartitions.begin(), _changedPartitions.end()),
+                                 _changedPartitions.end());
+
+        /**
+         * the temporaries shared by several partitions are evaluated in
+         * each partition: use the full model if it is cheaper
+         */
+        if (_zero != nullptr && _zeroPartitionCost != nullptr) {
+            unsigned long const* cost;
+            size_t nCost = 0;
+            (*_zeroPartitionCost)(&cost, &nCost);
+
+            size_t changedCost = 0;
+            for (size_t k : _changedPartitions) {
+                changedCost += cost[k];
+            }
+
+            if (changedCost >= cost[nCost - 1]) {
+                ForwardZero(x, dep);
+                return;
+            }
+        }
+
+        /**
+         * re-evaluate only the affected partitions
+         */
+        _ty.resize(_m);
+        Base* compressed = &_ty[0];
+
+        _in[0] = x.data();
+        _out[0] = compressed;
+
+        for (size_t k : _changedPartitions) {
+            (*_zeroPartitionSparsity)(k, &pos, &nnz);
+
+            int ret = (*_zeroPartition)(k, &_in[0], &_out[0], _atomicFuncArg);
+
+            CPPADCG_ASSERT_KNOWN(ret == 0, "Incremental zero order forward mode failed.") // generic failure
+
+            for (size_t e = 0; e < nnz; e++) {
+                dep[pos[e]] = compressed[e];
+            }
+        }
+    }
+
     bool isJacobianAvailable() override {
         return _jacobian != nullptr;
     }
@@ -403,7 +514,7 @@ public:
                   ArrayView<Base> jac) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_jacobian != nullptr, "No Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian array size")
@@ -426,7 +537,7 @@ public:
                  ArrayView<Base> hess) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_hessian != nullptr, "No Hessian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
@@ -580,7 +691,7 @@ public:
 
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_reverseTwo != nullptr, "No sparse reverse two function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1")
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1")
         CPPADCG_ASSERT_KNOWN(tx.size() >= k1 * _n, "Invalid tx size")
         CPPADCG_ASSERT_KNOWN(ty.size() >= k1 * _m, "Invalid ty size")
         CPPADCG_ASSERT_KNOWN(px.size() >= k1 * _n, "Invalid px size")
@@ -649,7 +760,7 @@ public:
                         ArrayView<Base> jac) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian size")
@@ -682,7 +793,7 @@ public:
                         std::vector<size_t>& col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -711,7 +822,7 @@ public:
                         size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
@@ -738,7 +849,7 @@ public:
                         size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_sparseJacobian != nullptr, "No sparse Jacobian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == x.size(), "The number of independent variable arrays is invalid")
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == x.size(), "The number of independent variable arrays is invalid")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
         unsigned long const* drow;
@@ -750,9 +861,10 @@ public:
         *col = dcol;
 
         if (nnz > 0) {
+            std::copy(x.begin(), x.end(), _in.begin());
             _out[0] = jac.data();
 
-            (*_sparseJacobian)(&x[0], &_out[0], _atomicFuncArg);
+            (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
         }
     }
 
@@ -770,7 +882,7 @@ public:
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
         // CPPADCG_ASSERT_KNOWN(hess.size() == _n * _n, "Invalid Hessian size")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -803,7 +915,7 @@ public:
         CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -834,7 +946,7 @@ public:
                        size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == 1, "The number of independent variable arrays is higher than 1,"
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == 1, "The number of independent variable arrays is higher than 1,"
                              " please use the variable size methods")
         CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
@@ -863,7 +975,7 @@ public:
                        size_t const** col) override {
         CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
         CPPADCG_ASSERT_KNOWN(_sparseHessian != nullptr, "No sparse Hessian function defined in the dynamic library")
-        CPPADCG_ASSERT_KNOWN(_in.size() == x.size(), "The number of independent variable arrays is invalid")
+        CPPADCG_ASSERT_KNOWN(indepArrayCount() == x.size(), "The number of independent variable arrays is invalid")
         CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
@@ -876,7 +988,7 @@ public:
 
         if (nnz > 0) {
             std::copy(x.begin(), x.end(), _inHess.begin());
-            _inHess.back() = w.data(); // the index might not be 1
+            _inHess[x.size()] = w.data(); // the index might not be 1
             _out[0] = hess.data();
 
             (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
@@ -895,9 +1007,14 @@ protected:
         _name(std::move(name)),
         _m(0),
         _n(0),
+        _np(0),
         _atomicFuncArg{nullptr}, // not really required
         _missingAtomicFunctions(0),
         _zero(nullptr),
+        _zeroPartition(nullptr),
+        _zeroPartitionSparsity(nullptr),
+        _zeroIndepPartitions(nullptr),
+        _zeroPartitionCost(nullptr),
         _forwardOne(nullptr),
         _reverseOne(nullptr),
         _reverseTwo(nullptr),
@@ -946,9 +1063,26 @@ protected:
         unsigned int outSize = 0;
         (*infoFunc)(&dynamicLibBaseName, &_m, &_n, &inSize, &outSize);
 
-        _in.resize(inSize);
-        _inHess.resize(inSize + 1);
+        /**
+         * Dynamic parameters (provided as the last input array)
+         */
+        void (*dynamicInfoFunc)(unsigned long*);
+        dynamicInfoFunc = reinterpret_cast<decltype(dynamicInfoFunc)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_DYNAMIC_INFO, false));
+        unsigned long np = 0;
+        if (dynamicInfoFunc != nullptr) {
+            (*dynamicInfoFunc)(&np);
+        }
+        _np = np;
+        _dynamic.resize(_np);
+
+        size_t dynSize = _np > 0 ? 1 : 0;
+        _in.resize(inSize + dynSize);
+        _inHess.resize(inSize + 1 + dynSize);
         _out.resize(outSize);
+        if (_np > 0) {
+            _in.back() = _dynamic.data();
+            _inHess.back() = _dynamic.data();
+        }
 
         CPPADCG_ASSERT_KNOWN(local == std::string(dynamicLibBaseName),
                              (std::string("Invalid data type in dynamic library. Expected '") + local
@@ -963,6 +1097,10 @@ protected:
 
     virtual void loadFunctions() {
         _zero = reinterpret_cast<decltype(_zero)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO, false));
+        _zeroPartition = reinterpret_cast<decltype(_zeroPartition)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_PARTITION, false));
+        _zeroPartitionSparsity = reinterpret_cast<decltype(_zeroPartitionSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_PARTITION_SPARSITY, false));
+        _zeroIndepPartitions = reinterpret_cast<decltype(_zeroIndepPartitions)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_INDEP_PARTITIONS, false));
+        _zeroPartitionCost = reinterpret_cast<decltype(_zeroPartitionCost)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_PARTITION_COST, false));
         _forwardOne = reinterpret_cast<decltype(_forwardOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_FORWARD_ONE, false));
         _reverseOne = reinterpret_cast<decltype(_reverseOne)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_ONE, false));
         _reverseTwo = reinterpret_cast<decltype(_reverseTwo)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO, false));
@@ -981,6 +1119,8 @@ protected:
         _hessianSparsity2 = reinterpret_cast<decltype(_hessianSparsity2)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY2, false));
         _atomicFunctions = reinterpret_cast<decltype(_atomicFunctions)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES, true));
 
+        CPPADCG_ASSERT_KNOWN((_zeroPartition == nullptr) == (_zeroPartitionSparsity == nullptr), "Missing functions in the dynamic library")
+        CPPADCG_ASSERT_KNOWN((_zeroPartition == nullptr) == (_zeroIndepPartitions == nullptr), "Missing functions in the dynamic library")
         CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOneSparsity == nullptr), "Missing functions in the dynamic library")
         CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOne == nullptr), "Missing functions in the dynamic library")
         CPPADCG_ASSERT_KNOWN((_sparseReverseOne == nullptr) == (_reverseOneSparsity == nullptr), "Missing functions in the dynamic library")
@@ -1053,6 +1193,10 @@ protected:
     virtual void modelLibraryClosed() {
         _isLibraryReady = false;
         _zero = nullptr;
+        _zeroPartition = nullptr;
+        _zeroPartitionSparsity = nullptr;
+        _zeroIndepPartitions = nullptr;
+        _zeroPartitionCost = nullptr;
         _forwardOne = nullptr;
         _reverseOne = nullptr;
         _reverseTwo = nullptr;
@@ -1071,6 +1215,14 @@ protected:
         _hessianSparsity2 = nullptr;
     }
 
+    /**
+     * Provides the number of independent variable arrays which must be
+     * provided by the user (excludes the dynamic parameter array).
+     */
+    inline size_t indepArrayCount() const {
+        return _np > 0 ? _in.size() - 1 : _in.size();
+    }
+
 private:
 
     template<class ExtFunc, class Wrapper>
@@ -1098,6 +1250,7 @@ private:
                              const Array tx[],
                              Array* ty) {
         auto* libModel = static_cast<FunctorGenericModel<Base>*> (libModelIn);
+        libModel->checkAtomicIndex(atomicIndex, "forward", p);
         ExternalFunctionWrapper<Base>* externalFunc = libModel->_atomic[atomicIndex];
 
         return externalFunc->forward(*libModel, q, p, tx, *ty);
@@ -1110,10 +1263,25 @@ private:
                              Array* px,
                              const Array py[]) {
         auto* libModel = static_cast<FunctorGenericModel<Base>*> (libModelIn);
+        libModel->checkAtomicIndex(atomicIndex, "reverse", p);
         ExternalFunctionWrapper<Base>* externalFunc = libModel->_atomic[atomicIndex];
 
         return externalFunc->reverse(*libModel, p, tx, *px, py);
     }
+
+    /**
+     * Atomic functions which are models in the same library are called
+     * directly and they are placed after the atomic functions provided to
+     * this model; they only reach this model when a direct call fails.
+     */
+    inline void checkAtomicIndex(int atomicIndex,
+                                 const char* mode,
+                                 int p) const {
+        if (atomicIndex < 0 || size_t(atomicIndex) >= _atomic.size()) {
+            throw CGException("Failed to evaluate the ", mode, " mode (p=", p, ") of the atomic function with index ",
+                              atomicIndex, " in model '", _name, "': the atomic model called directly does not provide this mode");
+        }
+    }
 #ifdef CPPAD_CG_SYSTEM_LINUX
     friend class LinuxDynamicLib<Base>;
 #endif
@@ -29,6 +29,7 @@ class FunctorModelLibrary : public ModelLibrary<Base> {
 protected:
     std::set<std::string> _modelNames;
     unsigned long _version; // API version
+    std::map<std::string, std::string> _compileFlags; // flags used to compile each translation unit
     void (*_onClose)();
     void (*_setThreadPoolDisabled)(int);
     int (*_isThreadPoolDisabled)();
@@ -47,6 +48,7 @@ public:
     inline FunctorModelLibrary(FunctorModelLibrary&& other) noexcept:
             _modelNames(std::move(other._modelNames)),
             _version(other._version),
+            _compileFlags(std::move(other._compileFlags)),
             _onClose(other._onClose),
             _setThreadPoolDisabled(other._setThreadPoolDisabled),
             _isThreadPoolDisabled(other._isThreadPoolDisabled),
@@ -90,6 +92,17 @@ public:
         return _version;
     }
 
+    /**
+     * Provides the flags used to compile each translation unit of the
+     * model library when they were selected using a compile time budget.
+     *
+     * @return maps the translation unit names to their compile flags
+     *         (empty if all translation units used the same flags)
+     */
+    virtual const std::map<std::string, std::string>& getCompileFlags() const {
+        return _compileFlags;
+    }
+
     /**
      * Provides a pointer to a function in the model library.
      *
@@ -231,6 +244,22 @@ protected:
             _modelNames.insert(model_names[i]);
         }
 
+        /**
+         * Load the flags used to compile each translation unit
+         */
+        void (*compileFlagsFunc)(char const *const**, char const *const**, int*);
+        compileFlagsFunc = reinterpret_cast<decltype(compileFlagsFunc)> (loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_COMPILEFLAGS, false));
+        if (compileFlagsFunc != nullptr) {
+            char const*const* unit_names = nullptr;
+            char const*const* unit_flags = nullptr;
+            int unit_count;
+            (*compileFlagsFunc)(&unit_names, &unit_flags, &unit_count);
+
+            for (int i = 0; i < unit_count; i++) {
+                _compileFlags[unit_names[i]] = unit_flags[i];
+            }
+        }
+
         /**
          * Load the the on close function
          */
@@ -62,6 +62,13 @@ public:
      */
     virtual bool isJacobianSparsityAvailable() = 0;
 
+    /**
+     * Provides the Jacobian sparsity pattern in a compressed format.
+     *
+     * @return The sparsity
+     */
+    virtual SparsityPattern JacobianSparsityPattern() = 0;
+
     // Jacobian sparsity
     virtual std::vector<std::set<size_t> > JacobianSparsitySet() = 0;
     virtual std::vector<bool> JacobianSparsityBool() = 0;
@@ -77,6 +84,14 @@ public:
      */
     virtual bool isHessianSparsityAvailable() = 0;
 
+    /**
+     * Provides the sparsity of the sum of the hessian for each dependent
+     * variable in a compressed format.
+     *
+     * @return The sparsity
+     */
+    virtual SparsityPattern HessianSparsityPattern() = 0;
+
     /**
      * Provides the sparsity of the sum of the hessian for each dependent 
      * variable.
@@ -97,6 +112,15 @@ public:
      */
     virtual bool isEquationHessianSparsityAvailable() = 0;
 
+    /**
+     * Provides the sparsity of the hessian for a dependent variable in a
+     * compressed format.
+     *
+     * @param i The index of the dependent variable
+     * @return The sparsity
+     */
+    virtual SparsityPattern HessianSparsityPattern(size_t i) = 0;
+
     /**
      * Provides the sparsity of the hessian for a dependent variable.
      * 
@@ -121,6 +145,83 @@ public:
                                  std::vector<size_t>& rows,
                                  std::vector<size_t>& cols) = 0;
 
+    /**
+     * Provides the indexes of the sparse Jacobian in the compressed sparse
+     * row format.
+     * The model must have been generated with the SparseMatrixLayout::CSR
+     * layout for the sparse Jacobian (or with elements in an equivalent
+     * order) so that SparseJacobian() can write directly into the values
+     * array of the CSR matrix.
+     *
+     * @param rowStart The position of the first element of each row
+     *                 (size Range() + 1)
+     * @param cols The column index of each element
+     */
+    virtual void JacobianSparsityCSR(std::vector<size_t>& rowStart,
+                                     std::vector<size_t>& cols) {
+        std::vector<size_t> rows;
+        JacobianSparsity(rows, cols);
+        if (!compressSparsityIndexes(Range(), rows, cols, rowStart))
+            throw CGException("The sparse Jacobian elements of model '", getName(), "' are not in the CSR order");
+    }
+
+    /**
+     * Provides the indexes of the sparse Jacobian in the compressed sparse
+     * column format.
+     * The model must have been generated with the SparseMatrixLayout::CSC
+     * layout for the sparse Jacobian (or with elements in an equivalent
+     * order).
+     *
+     * @param colStart The position of the first element of each column
+     *                 (size Domain() + 1)
+     * @param rows The row index of each element
+     */
+    virtual void JacobianSparsityCSC(std::vector<size_t>& colStart,
+                                     std::vector<size_t>& rows) {
+        std::vector<size_t> cols;
+        JacobianSparsity(rows, cols);
+        if (!compressSparsityIndexes(Domain(), cols, rows, colStart))
+            throw CGException("The sparse Jacobian elements of model '", getName(), "' are not in the CSC order");
+    }
+
+    /**
+     * Provides the indexes of the sparse Hessian in the compressed sparse
+     * row format.
+     * The model must have been generated with the SparseMatrixLayout::CSR
+     * layout for the sparse Hessian (or with elements in an equivalent
+     * order).
+     *
+     * @param rowStart The position of the first element of each row
+     *                 (size Domain() + 1)
+     * @param cols The column index of each element
+     */
+    virtual void HessianSparsityCSR(std::vector<size_t>& rowStart,
+                                    std::vector<size_t>& cols) {
+        std::vector<size_t> rows;
+        HessianSparsity(rows, cols);
+        if (!compressSparsityIndexes(Domain(), rows, cols, rowStart))
+            throw CGException("The sparse Hessian elements of model '", getName(), "' are not in the CSR order");
+    }
+
+    /**
+     * Provides the indexes of the sparse Hessian in the compressed sparse
+     * column format.
+     * The model must have been generated with the SparseMatrixLayout::CSC
+     * layout for the sparse Hessian (or with elements in an equivalent
+     * order).
+     *
+     * @param colStart The position of the first element of each column
+     *                 (size Domain() + 1)
+     * @param rows The row index of each element
+     */
+    virtual void HessianSparsityCSC(std::vector<size_t>& colStart,
+                                    std::vector<size_t>& rows) {
+        std::vector<size_t> cols;
+        HessianSparsity(rows, cols);
+        if (!compressSparsityIndexes(Domain(), cols, rows, colStart))
+            throw CGException("The sparse Hessian elements of model '", getName(), "' are not in the CSC order");
+    }
+
     /**
      * Provides the number of independent variables.
      * 
@@ -135,6 +236,35 @@ public:
      */
     virtual size_t Range() const = 0;
 
+    /**
+     * Provides the number of CppAD dynamic parameters of the model.
+     * Dynamic parameters are provided to the compiled code through a
+     * separate array and, unlike other constants, their values can be
+     * changed without generating and compiling the model again.
+     *
+     * @return The number of dynamic parameters (zero if the model was
+     *         taped without dynamic parameters)
+     */
+    virtual size_t DynamicParameterSize() const = 0;
+
+    /**
+     * Defines the values of the dynamic parameters used by all subsequent
+     * evaluations of this model (similar to ADFun::new_dynamic).
+     * The values are copied.
+     *
+     * @param p The dynamic parameter values (must have
+     *          DynamicParameterSize() elements)
+     */
+    virtual void setDynamicParameters(ArrayView<const Base> p) = 0;
+
+    /**
+     * Provides the values of the dynamic parameters currently used by this
+     * model.
+     *
+     * @return The current dynamic parameter values
+     */
+    virtual ArrayView<const Base> getDynamicParameters() const = 0;
+
     /**
      * The names of the atomic functions required by this model.
      * All external/atomic functions must be provided before using
@@ -268,6 +398,49 @@ public:
     virtual void ForwardZero(const std::vector<const Base*> &x,
                              ArrayView<Base> dep) = 0;
 
+    /**
+     * Evaluates the dependent model variables (zero-order) for new values
+     * of the dynamic parameters.
+     * The dynamic parameter values are kept for subsequent evaluations.
+     *
+     * @param x The independent variable vector
+     * @param p The dynamic parameter vector
+     * @param dep The dependent variable vector
+     */
+    virtual void ForwardZero(ArrayView<const Base> x,
+                             ArrayView<const Base> p,
+                             ArrayView<Base> dep) {
+        setDynamicParameters(p);
+        ForwardZero(x, dep);
+    }
+
+    /**
+     * Determines whether or not the incremental model evaluation
+     * (zero-order forward mode) can be requested.
+     *
+     * @return true if it is possible to incrementally evaluate the model
+     */
+    virtual bool isForwardZeroIncrementalAvailable() = 0;
+
+    /**
+     * Updates the dependent model variables (zero-order) after a change in
+     * only some of the independent variables.
+     * Only the dependents affected by the changed independent variables are
+     * re-evaluated while all other values in dep are kept.
+     * Therefore, dep must contain the result of a previous evaluation for
+     * the same dynamic parameters.
+     * This method considers that the generic model was prepared with a
+     * single array for the independent variables (the default behavior).
+     *
+     * @param x The (new) independent variable vector
+     * @param changed The indexes of the independent variables which changed
+     *                since the evaluation which provided the values in dep
+     * @param dep The dependent variable vector
+     */
+    virtual void ForwardZeroIncremental(ArrayView<const Base> x,
+                                        ArrayView<const size_t> changed,
+                                        ArrayView<Base> dep) = 0;
+
     /***********************************************************************
      *                        Dense Jacobian
      **********************************************************************/
@@ -320,6 +493,22 @@ public:
     virtual void Jacobian(ArrayView<const Base> x,
                           ArrayView<Base> jac) = 0;
 
+    /**
+     * Calculates the dense Jacobian for new values of the dynamic
+     * parameters.
+     * The dynamic parameter values are kept for subsequent evaluations.
+     *
+     * @param x The independent variable vector
+     * @param p The dynamic parameter vector
+     * @param jac The values of the dense Jacobian
+     */
+    virtual void Jacobian(ArrayView<const Base> x,
+                          ArrayView<const Base> p,
+                          ArrayView<Base> jac) {
+        setDynamicParameters(p);
+        Jacobian(x, jac);
+    }
+
     /***********************************************************************
      *                        Dense Hessian
      **********************************************************************/
@@ -401,6 +590,24 @@ public:
                          ArrayView<const Base> w,
                          ArrayView<Base> hess) = 0;
 
+    /**
+     * Determines the dense weighted sum of the Hessians for new values of
+     * the dynamic parameters.
+     * The dynamic parameter values are kept for subsequent evaluations.
+     *
+     * @param x The independent variables
+     * @param w The equation multipliers
+     * @param p The dynamic parameters
+     * @param hess The values of the dense hessian
+     */
+    virtual void Hessian(ArrayView<const Base> x,
+                         ArrayView<const Base> w,
+                         ArrayView<const Base> p,
+                         ArrayView<Base> hess) {
+        setDynamicParameters(p);
+        Hessian(x, w, hess);
+    }
+
     /***********************************************************************
      *                        Forward one
      **********************************************************************/
@@ -752,6 +959,26 @@ public:
                                 size_t const** row,
                                 size_t const** col) = 0;
 
+    /**
+     * Calculates a Jacobian using sparse methods for new values of the
+     * dynamic parameters and saves it into a sparse format.
+     * The dynamic parameter values are kept for subsequent evaluations.
+     *
+     * @param x independent variable array (must have n elements)
+     * @param p dynamic parameter array
+     * @param jac The values of the sparse Jacobian in the order provided by row and col
+     * @param row The row indices of the Jacobian values
+     * @param col The column indices of the Jacobian values
+     */
+    virtual void SparseJacobian(ArrayView<const Base> x,
+                                ArrayView<const Base> p,
+                                ArrayView<Base> jac,
+                                size_t const** row,
+                                size_t const** col) {
+        setDynamicParameters(p);
+        SparseJacobian(x, jac, row, col);
+    }
+
     /**
      * Determines the sparse Jacobian using a variable number of independent 
      * variable arrays. This method can be useful if the generic model was
@@ -855,6 +1082,29 @@ public:
                                size_t const** row,
                                size_t const** col) = 0;
 
+    /**
+     * Determines the sparse weighted sum of the Hessians for new values of
+     * the dynamic parameters.
+     * The dynamic parameter values are kept for subsequent evaluations.
+     *
+     * @param x The independent variables
+     * @param w The equation multipliers
+     * @param p The dynamic parameters
+     * @param hess The values of the sparse hessian in the order provided by
+     *             row and col
+     * @param row The row indices of the hessian values
+     * @param col The column indices of the hessian values
+     */
+    virtual void SparseHessian(ArrayView<const Base> x,
+                               ArrayView<const Base> w,
+                               ArrayView<const Base> p,
+                               ArrayView<Base> hess,
+                               size_t const** row,
+                               size_t const** col) {
+        setDynamicParameters(p);
+        SparseHessian(x, w, hess, row, col);
+    }
+
     /**
      * Determines the sparse weighted sum of the Hessians using a variable
      * number of independent variable arrays.
@@ -0,0 +1,702 @@
+#ifndef CPPAD_CG_BYTECODE_FUNCTION_INCLUDED
+#define CPPAD_CG_BYTECODE_FUNCTION_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * The operations supported by the bytecode interpreter
+ */
+enum class BytecodeOp : uint8_t {
+    Assign,
+    Abs,
+    Acos,
+    Acosh,
+    Add,
+    Asin,
+    Asinh,
+    Atan,
+    Atanh,
+    ComLt,
+    ComLe,
+    ComEq,
+    ComGe,
+    ComGt,
+    ComNe,
+    Cosh,
+    Cos,
+    Div,
+    Erf,
+    Erfc,
+    Exp,
+    Expm1,
+    Log,
+    Log1p,
+    Mul,
+    Pow,
+    Sign,
+    Sinh,
+    Sin,
+    Sqrt,
+    Sub,
+    Tanh,
+    Tan,
+    UnMinus
+};
+
+/**
+ * A compact representation of an operation graph from a CodeHandler which
+ * can be evaluated by a simple interpreter (no compiler is required).
+ *
+ * The operations are stored in a linear sequence of opcodes and each
+ * operation uses a flat list of register indexes (the result register
+ * followed by the argument registers).
+ * The register file is allocated only once and it contains the independent
+ * variables, followed by the constants and the temporary values.
+ * Registers of temporary values are reused once they are no longer needed.
+ *
+ * Only scalar operations are supported (no atomic functions, loops,
+ * arrays, or conditional blocks).
+ * The base type must be supported by the functions in <cmath>.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class BytecodeFunction {
+protected:
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+protected:
+    /**
+     * The number of independent variables
+     */
+    size_t nIndep_;
+    /**
+     * The number of fixed registers (independent variables and constants)
+     */
+    size_t nFixed_;
+    /**
+     * The operation codes
+     */
+    std::vector<BytecodeOp> ops_;
+    /**
+     * The result and argument registers of each operation
+     */
+    std::vector<uint32_t> args_;
+    /**
+     * The register holding each dependent variable
+     */
+    std::vector<uint32_t> dep_;
+    /**
+     * The register file (preallocated)
+     */
+    std::vector<Base> registers_;
+public:
+
+    /**
+     * Creates the bytecode for a set of dependent variables.
+     *
+     * @param handler The code handler which owns the operation graph and
+     *                the independent variables
+     * @param dependent The dependent variables
+     * @throws CGException if the graph contains unsupported operations
+     */
+    inline BytecodeFunction(CodeHandler<Base>& handler,
+                            ArrayView<const CG<Base> > dependent) :
+        nIndep_(handler.getIndependentVariableSize()),
+        nFixed_(nIndep_) {
+        compile(handler, dependent);
+    }
+
+    BytecodeFunction(const BytecodeFunction& orig) = default;
+    BytecodeFunction(BytecodeFunction&& orig) noexcept = default;
+
+    inline virtual ~BytecodeFunction() = default;
+
+    /**
+     * @return the number of independent variables
+     */
+    inline size_t getIndependentSize() const {
+        return nIndep_;
+    }
+
+    /**
+     * @return the number of dependent variables
+     */
+    inline size_t getDependentSize() const {
+        return dep_.size();
+    }
+
+    /**
+     * @return the number of operations executed in each evaluation
+     */
+    inline size_t getOperationCount() const {
+        return ops_.size();
+    }
+
+    /**
+     * @return the total number of registers (independent variables,
+     *         constants and temporary values)
+     */
+    inline size_t getRegisterCount() const {
+        return registers_.size();
+    }
+
+    /**
+     * Evaluates the dependent variables.
+     *
+     * @param indep The values of the independent variables (the arrays are
+     *              placed one after the other in the same order used to
+     *              create the independent variables in the code handler)
+     * @param dep The values of the dependent variables
+     */
+    inline void evaluate(std::initializer_list<ArrayView<const Base> > indep,
+                         ArrayView<Base> dep) {
+        Base* r = registers_.data();
+        size_t j = 0;
+        for (const ArrayView<const Base>& x : indep) {
+            CPPADCG_ASSERT_KNOWN(j + x.size() <= nIndep_, "Invalid independent array size")
+            std::copy(x.data(), x.data() + x.size(), r + j);
+            j += x.size();
+        }
+        CPPADCG_ASSERT_KNOWN(j == nIndep_, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(dep.size() == dep_.size(), "Invalid dependent array size")
+
+        run();
+
+        for (size_t i = 0; i < dep_.size(); ++i) {
+            dep[i] = r[dep_[i]];
+        }
+    }
+
+    inline void evaluate(ArrayView<const Base> indep,
+                         ArrayView<Base> dep) {
+        evaluate({indep}, dep);
+    }
+
+protected:
+
+    /**
+     * The interpreter loop
+     */
+    inline void run() {
+        Base* r = registers_.data();
+        const uint32_t* a = args_.data();
+
+        for (BytecodeOp op : ops_) {
+            switch (op) {
+                case BytecodeOp::Assign:
+                    r[a[0]] = r[a[1]];
+                    a += 2;
+                    break;
+                case BytecodeOp::Abs:
+                    r[a[0]] = std::abs(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Acos:
+                    r[a[0]] = std::acos(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Acosh:
+                    r[a[0]] = std::acosh(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Add:
+                    r[a[0]] = r[a[1]] + r[a[2]];
+                    a += 3;
+                    break;
+                case BytecodeOp::Asin:
+                    r[a[0]] = std::asin(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Asinh:
+                    r[a[0]] = std::asinh(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Atan:
+                    r[a[0]] = std::atan(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Atanh:
+                    r[a[0]] = std::atanh(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::ComLt:
+                    r[a[0]] = r[a[1]] < r[a[2]] ? r[a[3]] : r[a[4]];
+                    a += 5;
+                    break;
+                case BytecodeOp::ComLe:
+                    r[a[0]] = r[a[1]] <= r[a[2]] ? r[a[3]] : r[a[4]];
+                    a += 5;
+                    break;
+                case BytecodeOp::ComEq:
+                    r[a[0]] = r[a[1]] == r[a[2]] ? r[a[3]] : r[a[4]];
+                    a += 5;
+                    break;
+                case BytecodeOp::ComGe:
+                    r[a[0]] = r[a[1]] >= r[a[2]] ? r[a[3]] : r[a[4]];
+                    a += 5;
+                    break;
+                case BytecodeOp::ComGt:
+                    r[a[0]] = r[a[1]] > r[a[2]] ? r[a[3]] : r[a[4]];
+                    a += 5;
+                    break;
+                case BytecodeOp::ComNe:
+                    r[a[0]] = r[a[1]] != r[a[2]] ? r[a[3]] : r[a[4]];
+                    a += 5;
+                    break;
+                case BytecodeOp::Cosh:
+                    r[a[0]] = std::cosh(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Cos:
+                    r[a[0]] = std::cos(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Div:
+                    r[a[0]] = r[a[1]] / r[a[2]];
+                    a += 3;
+                    break;
+                case BytecodeOp::Erf:
+                    r[a[0]] = std::erf(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Erfc:
+                    r[a[0]] = std::erfc(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Exp:
+                    r[a[0]] = std::exp(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Expm1:
+                    r[a[0]] = std::expm1(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Log:
+                    r[a[0]] = std::log(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Log1p:
+                    r[a[0]] = std::log1p(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Mul:
+                    r[a[0]] = r[a[1]] * r[a[2]];
+                    a += 3;
+                    break;
+                case BytecodeOp::Pow:
+                    r[a[0]] = std::pow(r[a[1]], r[a[2]]);
+                    a += 3;
+                    break;
+                case BytecodeOp::Sign: {
+                    const Base& v = r[a[1]];
+                    r[a[0]] = v > Base(0) ? Base(1) : (v == Base(0) ? Base(0) : Base(-1));
+                    a += 2;
+                    break;
+                }
+                case BytecodeOp::Sinh:
+                    r[a[0]] = std::sinh(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Sin:
+                    r[a[0]] = std::sin(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Sqrt:
+                    r[a[0]] = std::sqrt(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Sub:
+                    r[a[0]] = r[a[1]] - r[a[2]];
+                    a += 3;
+                    break;
+                case BytecodeOp::Tanh:
+                    r[a[0]] = std::tanh(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::Tan:
+                    r[a[0]] = std::tan(r[a[1]]);
+                    a += 2;
+                    break;
+                case BytecodeOp::UnMinus:
+                    r[a[0]] = -r[a[1]];
+                    a += 2;
+                    break;
+            }
+        }
+    }
+
+    /**
+     * Determines the operation code and the number of arguments of a node.
+     *
+     * @return the number of arguments
+     * @throws CGException if the operation is not supported
+     */
+    static inline size_t translate(const Node& node,
+                                   BytecodeOp& op) {
+        switch (node.getOperationType()) {
+            case CGOpCode::Assign:
+                op = BytecodeOp::Assign;
+                return 1;
+            case CGOpCode::Abs:
+                op = BytecodeOp::Abs;
+                return 1;
+            case CGOpCode::Acos:
+                op = BytecodeOp::Acos;
+                return 1;
+            case CGOpCode::Acosh:
+                op = BytecodeOp::Acosh;
+                return 1;
+            case CGOpCode::Add:
+                op = BytecodeOp::Add;
+                return 2;
+            case CGOpCode::Asin:
+                op = BytecodeOp::Asin;
+                return 1;
+            case CGOpCode::Asinh:
+                op = BytecodeOp::Asinh;
+                return 1;
+            case CGOpCode::Atan:
+                op = BytecodeOp::Atan;
+                return 1;
+            case CGOpCode::Atanh:
+                op = BytecodeOp::Atanh;
+                return 1;
+            case CGOpCode::ComLt:
+                op = BytecodeOp::ComLt;
+                return 4;
+            case CGOpCode::ComLe:
+                op = BytecodeOp::ComLe;
+                return 4;
+            case CGOpCode::ComEq:
+                op = BytecodeOp::ComEq;
+                return 4;
+            case CGOpCode::ComGe:
+                op = BytecodeOp::ComGe;
+                return 4;
+            case CGOpCode::ComGt:
+                op = BytecodeOp::ComGt;
+                return 4;
+            case CGOpCode::ComNe:
+                op = BytecodeOp::ComNe;
+                return 4;
+            case CGOpCode::Cosh:
+                op = BytecodeOp::Cosh;
+                return 1;
+            case CGOpCode::Cos:
+                op = BytecodeOp::Cos;
+                return 1;
+            case CGOpCode::Div:
+                op = BytecodeOp::Div;
+                return 2;
+            case CGOpCode::Erf:
+                op = BytecodeOp::Erf;
+                return 1;
+            case CGOpCode::Erfc:
+                op = BytecodeOp::Erfc;
+                return 1;
+            case CGOpCode::Exp:
+                op = BytecodeOp::Exp;
+                return 1;
+            case CGOpCode::Expm1:
+                op = BytecodeOp::Expm1;
+                return 1;
+            case CGOpCode::Log:
+                op = BytecodeOp::Log;
+                return 1;
+            case CGOpCode::Log1p:
+                op = BytecodeOp::Log1p;
+                return 1;
+            case CGOpCode::Mul:
+                op = BytecodeOp::Mul;
+                return 2;
+            case CGOpCode::Pow:
+                op = BytecodeOp::Pow;
+                return 2;
+            case CGOpCode::Sign:
+                op = BytecodeOp::Sign;
+                return 1;
+            case CGOpCode::Sinh:
+                op = BytecodeOp::Sinh;
+                return 1;
+            case CGOpCode::Sin:
+                op = BytecodeOp::Sin;
+                return 1;
+            case CGOpCode::Sqrt:
+                op = BytecodeOp::Sqrt;
+                return 1;
+            case CGOpCode::Sub:
+                op = BytecodeOp::Sub;
+                return 2;
+            case CGOpCode::Tanh:
+                op = BytecodeOp::Tanh;
+                return 1;
+            case CGOpCode::Tan:
+                op = BytecodeOp::Tan;
+                return 1;
+            case CGOpCode::UnMinus:
+                op = BytecodeOp::UnMinus;
+                return 1;
+            default:
+                throw CGException("Unable to interpret operations of type ", node.getOperationType());
+        }
+    }
+
+    static inline Node* resolveAlias(Node* node) {
+        while (node->getOperationType() == CGOpCode::Alias) {
+            CPPADCG_ASSERT_UNKNOWN(node->getArguments().size() == 1)
+            node = node->getArguments()[0].getOperation();
+            CPPADCG_ASSERT_UNKNOWN(node != nullptr)
+        }
+        return node;
+    }
+
+    /**
+     * A language which does not generate any source code and which only
+     * saves the evaluation order determined by the code handler.
+     * Every operation creates a new variable so that the order contains
+     * all the operations.
+     */
+    class EvaluationOrderLanguage : public Language<Base> {
+    public:
+        std::vector<Node*> order;
+    protected:
+
+        void generateSourceCode(std::ostream& out,
+                                std::unique_ptr<LanguageGenerationData<Base> > info) override {
+            order = info->variableOrder;
+        }
+
+        bool createsNewVariable(const Node& op,
+                                size_t totalUseCount,
+                                size_t opCount) const override {
+            return true;
+        }
+
+        bool requiresVariableArgument(enum CGOpCode op,
+                                      size_t argIndex) const override {
+            return false;
+        }
+
+        bool requiresVariableDependencies() const override {
+            return false;
+        }
+    };
+
+    /**
+     * Creates the bytecode.
+     *
+     * The operations are placed in the evaluation order determined by the
+     * code handler for source code generation (which also reorders
+     * operations to reduce the number of temporary variables).
+     * Temporary values are first associated with a virtual register (one
+     * per operation) which are then mapped to a reduced number of registers
+     * based on the last operation using each value.
+     * Identical constants share the same register.
+     */
+    inline void compile(CodeHandler<Base>& handler,
+                        ArrayView<const CG<Base> > dependent) {
+        const int64_t notVisited = std::numeric_limits<int64_t>::min();
+
+        for (size_t i = 0; i < dependent.size(); ++i) {
+            const Node* root = dependent[i].getOperationNode();
+            CPPADCG_ASSERT_KNOWN(root == nullptr || root->getCodeHandler() == &handler,
+                                 "All dependent variables must belong to the same code handler")
+        }
+
+        /**
+         * the evaluation order
+         */
+        std::vector<CG<Base> > dep(dependent.data(), dependent.data() + dependent.size());
+
+        EvaluationOrderLanguage lang;
+        LangCDefaultVariableNameGenerator<Base> nameGen;
+        std::ostringstream code;
+        handler.generateCode(code, lang, dep, nameGen);
+
+        /**
+         * the constants (the same register is used for equal values)
+         */
+        std::vector<Base> constants;
+        std::map<std::pair<Base, bool>, int64_t> constantRef;
+
+        auto constantReg = [&](const Base& value) -> int64_t {
+            if (value != value) {
+                // NaN
+                constants.push_back(value);
+                return int64_t(nIndep_ + constants.size() - 1);
+            }
+            // distinguish between 0 and -0
+            auto it = constantRef.emplace(std::make_pair(value, bool(std::signbit(value))), int64_t(nIndep_ + constants.size()));
+            if (it.second)
+                constants.push_back(value);
+            return it.first->second;
+        };
+
+        // references to registers: non-negative values are fixed registers
+        // and negative values (-k - 1) are the result of the operation k
+        CodeHandlerVector<Base, int64_t> ref(handler);
+        ref.adjustSize();
+        ref.fill(notVisited);
+
+        auto nodeRef = [&](Node* node) -> int64_t {
+            node = resolveAlias(node);
+            if (node->getOperationType() == CGOpCode::Inv)
+                return int64_t(handler.getIndependentVariableIndex(*node));
+            CPPADCG_ASSERT_UNKNOWN(ref[*node] != notVisited)
+            return ref[*node];
+        };
+
+        std::vector<int64_t> rawArgs;
+
+        auto argRef = [&](const Arg& a) -> int64_t {
+            if (a.getOperation() == nullptr) {
+                return constantReg(*a.getParameter());
+            }
+            return nodeRef(a.getOperation());
+        };
+
+        for (Node* node : lang.order) {
+            if (node->getOperationType() == CGOpCode::Alias)
+                continue; // arguments are resolved where they are used
+
+            BytecodeOp op;
+            size_t nArgs = translate(*node, op);
+            const std::vector<Arg>& args = node->getArguments();
+            if (args.size() != nArgs) {
+                throw CGException("Invalid number of arguments for an operation of type ", node->getOperationType());
+            }
+
+            int64_t k = int64_t(ops_.size());
+            ops_.push_back(op);
+            rawArgs.push_back(-k - 1);
+            for (const Arg& a : args) {
+                rawArgs.push_back(argRef(a));
+            }
+            ref[*node] = -k - 1;
+        }
+
+        std::vector<int64_t> depRef(dependent.size());
+        for (size_t i = 0; i < dependent.size(); ++i) {
+            Node* root = dependent[i].getOperationNode();
+            if (root == nullptr) {
+                depRef[i] = constantReg(dependent[i].getValue());
+            } else {
+                depRef[i] = nodeRef(root);
+            }
+        }
+
+        nFixed_ = nIndep_ + constants.size();
+
+        /**
+         * determine the last use of each temporary value
+         */
+        const size_t nOps = ops_.size();
+        const size_t keep = std::numeric_limits<size_t>::max();
+        std::vector<size_t> lastUse(nOps, 0);
+
+        size_t pos = 0;
+        for (size_t k = 0; k < nOps; ++k) {
+            size_t nArgs = arity(ops_[k]);
+            for (size_t e = 1; e <= nArgs; ++e) {
+                int64_t r = rawArgs[pos + e];
+                if (r < 0)
+                    lastUse[-r - 1] = k;
+            }
+            pos += nArgs + 1;
+        }
+        for (int64_t r : depRef) {
+            if (r < 0)
+                lastUse[-r - 1] = keep;
+        }
+
+        /**
+         * assign registers to temporary values
+         */
+        std::vector<uint32_t> reg(nOps);
+        std::vector<uint32_t> freeRegs;
+        size_t nRegisters = nFixed_;
+
+        auto toRegister = [&](int64_t r) -> uint32_t {
+            return r >= 0 ? uint32_t(r) : reg[-r - 1];
+        };
+
+        args_.resize(rawArgs.size());
+        pos = 0;
+        for (size_t k = 0; k < nOps; ++k) {
+            size_t nArgs = arity(ops_[k]);
+            for (size_t e = 1; e <= nArgs; ++e) {
+                args_[pos + e] = toRegister(rawArgs[pos + e]);
+            }
+
+            // release registers which are no longer needed (once)
+            for (size_t e = 1; e <= nArgs; ++e) {
+                int64_t r = rawArgs[pos + e];
+                if (r < 0 && lastUse[-r - 1] == k) {
+                    lastUse[-r - 1] = keep - 1; // already released
+                    freeRegs.push_back(reg[-r - 1]);
+                }
+            }
+
+            if (freeRegs.empty()) {
+                CPPADCG_ASSERT_KNOWN(nRegisters < std::numeric_limits<uint32_t>::max(), "Too many registers")
+                reg[k] = uint32_t(nRegisters++);
+            } else {
+                reg[k] = freeRegs.back();
+                freeRegs.pop_back();
+            }
+            args_[pos] = reg[k];
+
+            pos += nArgs + 1;
+        }
+
+        dep_.resize(depRef.size());
+        for (size_t i = 0; i < depRef.size(); ++i) {
+            dep_[i] = toRegister(depRef[i]);
+        }
+
+        registers_.resize(nRegisters);
+        std::copy(constants.begin(), constants.end(), registers_.begin() + nIndep_);
+    }
+
+    static inline size_t arity(BytecodeOp op) {
+        switch (op) {
+            case BytecodeOp::Add:
+            case BytecodeOp::Div:
+            case BytecodeOp::Mul:
+            case BytecodeOp::Pow:
+            case BytecodeOp::Sub:
+                return 2;
+            case BytecodeOp::ComLt:
+            case BytecodeOp::ComLe:
+            case BytecodeOp::ComEq:
+            case BytecodeOp::ComGe:
+            case BytecodeOp::ComGt:
+            case BytecodeOp::ComNe:
+                return 4;
+            default:
+                return 1;
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,727 @@
+#ifndef CPPAD_CG_INTERPRETED_MODEL_INCLUDED
+#define CPPAD_CG_INTERPRETED_MODEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A model which is evaluated by an interpreter instead of compiled source
+ * code.
+ *
+ * The operation graph of each requested function (zero order forward mode,
+ * Jacobian, Hessian, ...) is only created the first time it is used and
+ * then translated into a BytecodeFunction.
+ * This avoids the compilation step which can take a long time for large
+ * models and is useful while developing a model or for models which are
+ * evaluated only a few times.
+ *
+ * The original CppAD tape must remain available while this model is used.
+ * Dynamic parameters and atomic functions are not supported.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class InterpretedModel : public GenericModel<Base> {
+public:
+    using CGBase = CG<Base>;
+protected:
+    /**
+     * The original model
+     */
+    ADFun<CGBase>& fun_;
+    /**
+     * The model name
+     */
+    const std::string name_;
+    /**
+     * Number of independent variables
+     */
+    const size_t n_;
+    /**
+     * Number of dependent variables
+     */
+    const size_t m_;
+    /**
+     * The interpreted functions (created when first used)
+     */
+    std::unique_ptr<BytecodeFunction<Base> > zero_;
+    std::unique_ptr<BytecodeFunction<Base> > jacobian_;
+    std::unique_ptr<BytecodeFunction<Base> > hessian_;
+    std::unique_ptr<BytecodeFunction<Base> > forwardOne_;
+    std::unique_ptr<BytecodeFunction<Base> > reverseOne_;
+    std::unique_ptr<BytecodeFunction<Base> > reverseTwo_;
+    std::unique_ptr<BytecodeFunction<Base> > sparseJacobian_;
+    std::unique_ptr<BytecodeFunction<Base> > sparseHessian_;
+    /**
+     * Sparsity patterns (determined when first used)
+     */
+    SparsityPattern jacSparsity_;
+    SparsityPattern hessSparsity_;
+    std::vector<SparsityPattern> hessSparsities_;
+    /**
+     * Row-major indexes of the elements in the sparsity patterns
+     */
+    std::vector<size_t> jacRow_;
+    std::vector<size_t> jacCol_;
+    std::vector<size_t> hessRow_;
+    std::vector<size_t> hessCol_;
+    /**
+     * Auxiliary arrays
+     */
+    std::vector<Base> tmpIn_;
+    std::vector<Base> tmpIn2_;
+    std::vector<Base> tmpOut_;
+    const std::vector<std::string> atomicNames_;
+public:
+
+    /**
+     * Creates a new interpreted model.
+     *
+     * @param fun The original model (it must outlive this object)
+     * @param name The model name
+     */
+    inline InterpretedModel(ADFun<CGBase>& fun,
+                            std::string name) :
+        fun_(fun),
+        name_(std::move(name)),
+        n_(fun.Domain()),
+        m_(fun.Range()) {
+        if (fun.size_dyn_ind() > 0) {
+            throw CGException("Interpreted models do not support dynamic parameters");
+        }
+    }
+
+    InterpretedModel(const InterpretedModel&) = delete;
+    InterpretedModel& operator=(const InterpretedModel&) = delete;
+
+    inline virtual ~InterpretedModel() = default;
+
+    const std::string& getName() const override {
+        return name_;
+    }
+
+    const std::vector<std::string>& getAtomicFunctionNames() override {
+        return atomicNames_;
+    }
+
+    bool addAtomicFunction(atomic_base<Base>& atomic) override {
+        return false;
+    }
+
+    bool addExternalModel(GenericModel<Base>& atomic) override {
+        return false;
+    }
+
+    // Jacobian sparsity
+    bool isJacobianSparsityAvailable() override {
+        return true;
+    }
+
+    SparsityPattern JacobianSparsityPattern() override {
+        return getJacobianSparsity();
+    }
+
+    std::vector<std::set<size_t> > JacobianSparsitySet() override {
+        return getJacobianSparsity().toSets();
+    }
+
+    std::vector<bool> JacobianSparsityBool() override {
+        return getJacobianSparsity().toBool();
+    }
+
+    void JacobianSparsity(std::vector<size_t>& equations,
+                          std::vector<size_t>& variables) override {
+        getJacobianSparsity();
+        equations = jacRow_;
+        variables = jacCol_;
+    }
+
+    // Hessian sparsity
+    bool isHessianSparsityAvailable() override {
+        return true;
+    }
+
+    SparsityPattern HessianSparsityPattern() override {
+        return getHessianSparsity();
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet() override {
+        return getHessianSparsity().toSets();
+    }
+
+    std::vector<bool> HessianSparsityBool() override {
+        return getHessianSparsity().toBool();
+    }
+
+    void HessianSparsity(std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        getHessianSparsity();
+        rows = hessRow_;
+        cols = hessCol_;
+    }
+
+    bool isEquationHessianSparsityAvailable() override {
+        return true;
+    }
+
+    SparsityPattern HessianSparsityPattern(size_t i) override {
+        return getHessianSparsity(i);
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
+        return getHessianSparsity(i).toSets();
+    }
+
+    std::vector<bool> HessianSparsityBool(size_t i) override {
+        return getHessianSparsity(i).toBool();
+    }
+
+    void HessianSparsity(size_t i,
+                         std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        getHessianSparsity(i).toIndexes(rows, cols);
+    }
+
+    size_t Domain() const override {
+        return n_;
+    }
+
+    size_t Range() const override {
+        return m_;
+    }
+
+    size_t DynamicParameterSize() const override {
+        return 0;
+    }
+
+    void setDynamicParameters(ArrayView<const Base> p) override {
+        CPPADCG_ASSERT_KNOWN(p.size() == 0, "Invalid dynamic parameter array size")
+    }
+
+    ArrayView<const Base> getDynamicParameters() const override {
+        return ArrayView<const Base>();
+    }
+
+    bool isForwardZeroAvailable() override {
+        return true;
+    }
+
+    using GenericModel<Base>::ForwardZero;
+
+    void ForwardZero(ArrayView<const Base> x,
+                     ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == n_, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(dep.size() == m_, "Invalid dependent array size")
+
+        getForwardZero().evaluate(x, dep);
+    }
+
+    void ForwardZero(const std::vector<const Base*>& x,
+                     ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is invalid")
+
+        ForwardZero(ArrayView<const Base>(x[0], n_), dep);
+    }
+
+    void ForwardZero(const CppAD::vector<bool>& vx,
+                     CppAD::vector<bool>& vy,
+                     ArrayView<const Base> tx,
+                     ArrayView<Base> ty) override {
+        ForwardZero(tx, ty);
+
+        if (vx.size() > 0) {
+            CPPADCG_ASSERT_KNOWN(vx.size() >= n_, "Invalid vx size")
+            CPPADCG_ASSERT_KNOWN(vy.size() >= m_, "Invalid vy size")
+            const SparsityPattern& jacSparsity = getJacobianSparsity();
+            for (size_t i = 0; i < m_; i++) {
+                for (const size_t* j = jacSparsity.begin(i); j != jacSparsity.end(i); ++j) {
+                    if (vx[*j]) {
+                        vy[i] = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    bool isForwardZeroIncrementalAvailable() override {
+        return false;
+    }
+
+    void ForwardZeroIncremental(ArrayView<const Base> x,
+                                ArrayView<const size_t> changed,
+                                ArrayView<Base> dep) override {
+        throw CGException("Incremental zero order forward mode is not available for interpreted models");
+    }
+
+    bool isJacobianAvailable() override {
+        return true;
+    }
+
+    void Jacobian(ArrayView<const Base> x,
+                  ArrayView<Base> jac) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == n_, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(jac.size() == m_ * n_, "Invalid Jacobian array size")
+
+        if (jacobian_ == nullptr) {
+            jacobian_ = createFunction({n_}, [this](const std::vector<std::vector<CGBase> >& in) {
+                return fun_.Jacobian(in[0]);
+            });
+        }
+
+        jacobian_->evaluate(x, jac);
+    }
+
+    bool isHessianAvailable() override {
+        return true;
+    }
+
+    void Hessian(ArrayView<const Base> x,
+                 ArrayView<const Base> w,
+                 ArrayView<Base> hess) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == n_, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == m_, "Invalid multiplier array size")
+        CPPADCG_ASSERT_KNOWN(hess.size() == n_ * n_, "Invalid Hessian size")
+
+        if (hessian_ == nullptr) {
+            hessian_ = createFunction({n_, m_}, [this](const std::vector<std::vector<CGBase> >& in) {
+                return fun_.Hessian(in[0], in[1]);
+            });
+        }
+
+        hessian_->evaluate({x, w}, hess);
+    }
+
+    bool isForwardOneAvailable() override {
+        return true;
+    }
+
+    void ForwardOne(ArrayView<const Base> tx,
+                    ArrayView<Base> ty) override {
+        const size_t k = 1;
+
+        CPPADCG_ASSERT_KNOWN(tx.size() >= (k + 1) * n_, "Invalid tx size")
+        CPPADCG_ASSERT_KNOWN(ty.size() >= (k + 1) * m_, "Invalid ty size")
+
+        tmpIn_.resize(n_);
+        tmpIn2_.resize(n_);
+        for (size_t j = 0; j < n_; j++) {
+            tmpIn_[j] = tx[j * (k + 1)];
+            tmpIn2_[j] = tx[j * (k + 1) + 1];
+        }
+
+        tmpOut_.resize(m_);
+        getForwardOne().evaluate({ArrayView<const Base>(tmpIn_), ArrayView<const Base>(tmpIn2_)}, tmpOut_);
+
+        for (size_t i = 0; i < m_; i++) {
+            ty[i * (k + 1) + 1] = tmpOut_[i];
+        }
+    }
+
+    bool isSparseForwardOneAvailable() override {
+        return true;
+    }
+
+    void ForwardOne(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> ty1) override {
+        CPPADCG_ASSERT_KNOWN(x.size() >= n_, "Invalid x size")
+        CPPADCG_ASSERT_KNOWN(ty1.size() >= m_, "Invalid ty1 size")
+
+        std::fill(ty1.data(), ty1.data() + m_, Base(0));
+        if (tx1Nnz == 0)
+            return; //nothing to do
+
+        tmpIn_.assign(n_, Base(0));
+        for (size_t ej = 0; ej < tx1Nnz; ej++) {
+            tmpIn_[idx[ej]] = tx1[ej];
+        }
+
+        getForwardOne().evaluate({ArrayView<const Base>(x.data(), n_), ArrayView<const Base>(tmpIn_)},
+                                 ArrayView<Base>(ty1.data(), m_));
+    }
+
+    bool isReverseOneAvailable() override {
+        return true;
+    }
+
+    void ReverseOne(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        CPPADCG_ASSERT_KNOWN(tx.size() >= n_, "Invalid tx size")
+        CPPADCG_ASSERT_KNOWN(ty.size() >= m_, "Invalid ty size")
+        CPPADCG_ASSERT_KNOWN(px.size() >= n_, "Invalid px size")
+        CPPADCG_ASSERT_KNOWN(py.size() >= m_, "Invalid py size")
+
+        getReverseOne().evaluate({ArrayView<const Base>(tx.data(), n_), ArrayView<const Base>(py.data(), m_)},
+                                 ArrayView<Base>(px.data(), n_));
+    }
+
+    bool isSparseReverseOneAvailable() override {
+        return true;
+    }
+
+    void ReverseOne(ArrayView<const Base> x,
+                    ArrayView<Base> px,
+                    size_t pyNnz, const size_t idx[], const Base py[]) override {
+        CPPADCG_ASSERT_KNOWN(x.size() >= n_, "Invalid x size")
+        CPPADCG_ASSERT_KNOWN(px.size() >= n_, "Invalid px size")
+
+        std::fill(px.data(), px.data() + n_, Base(0));
+        if (pyNnz == 0)
+            return; //nothing to do
+
+        tmpIn_.assign(m_, Base(0));
+        for (size_t ei = 0; ei < pyNnz; ei++) {
+            tmpIn_[idx[ei]] = py[ei];
+        }
+
+        getReverseOne().evaluate({ArrayView<const Base>(x.data(), n_), ArrayView<const Base>(tmpIn_)},
+                                 ArrayView<Base>(px.data(), n_));
+    }
+
+    bool isReverseTwoAvailable() override {
+        return true;
+    }
+
+    void ReverseTwo(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        const size_t k = 1;
+        const size_t k1 = k + 1;
+
+        CPPADCG_ASSERT_KNOWN(tx.size() >= k1 * n_, "Invalid tx size")
+        CPPADCG_ASSERT_KNOWN(ty.size() >= k1 * m_, "Invalid ty size")
+        CPPADCG_ASSERT_KNOWN(px.size() >= k1 * n_, "Invalid px size")
+        CPPADCG_ASSERT_KNOWN(py.size() >= k1 * m_, "Invalid py size")
+
+        tmpIn_.resize(n_);
+        tmpIn2_.resize(n_ + m_);
+        for (size_t j = 0; j < n_; j++) {
+            tmpIn_[j] = tx[j * k1];
+            tmpIn2_[j] = tx[j * k1 + 1];
+        }
+        for (size_t i = 0; i < m_; i++) {
+            CPPADCG_ASSERT_KNOWN(py[i * k1] == Base(0), "Second-order reverse mode failed: py[2*i] (i=0...m) must be zero.")
+            tmpIn2_[n_ + i] = py[i * k1 + 1];
+        }
+
+        tmpOut_.resize(n_);
+        getReverseTwo().evaluate({ArrayView<const Base>(tmpIn_),
+                                  ArrayView<const Base>(tmpIn2_.data(), n_),
+                                  ArrayView<const Base>(tmpIn2_.data() + n_, m_)}, tmpOut_);
+
+        for (size_t j = 0; j < n_; j++) {
+            px[j * k1] = tmpOut_[j];
+        }
+    }
+
+    bool isSparseReverseTwoAvailable() override {
+        return true;
+    }
+
+    void ReverseTwo(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> px2,
+                    ArrayView<const Base> py2) override {
+        CPPADCG_ASSERT_KNOWN(x.size() >= n_, "Invalid x size")
+        CPPADCG_ASSERT_KNOWN(px2.size() >= n_, "Invalid px2 size")
+        CPPADCG_ASSERT_KNOWN(py2.size() >= m_, "Invalid py2 size")
+
+        std::fill(px2.data(), px2.data() + n_, Base(0));
+        if (tx1Nnz == 0)
+            return; //nothing to do
+
+        tmpIn_.assign(n_, Base(0));
+        for (size_t ej = 0; ej < tx1Nnz; ej++) {
+            tmpIn_[idx[ej]] = tx1[ej];
+        }
+
+        getReverseTwo().evaluate({ArrayView<const Base>(x.data(), n_),
+                                  ArrayView<const Base>(tmpIn_),
+                                  ArrayView<const Base>(py2.data(), m_)},
+                                 ArrayView<Base>(px2.data(), n_));
+    }
+
+    bool isSparseJacobianAvailable() override {
+        return true;
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == n_, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(jac.size() == m_ * n_, "Invalid Jacobian size")
+
+        tmpOut_.resize(getJacobianSparsity().nnz());
+        getSparseJacobian().evaluate(x, tmpOut_);
+
+        jac.fill(Base(0));
+        for (size_t e = 0; e < jacRow_.size(); e++) {
+            jac[jacRow_[e] * n_ + jacCol_[e]] = tmpOut_[e];
+        }
+    }
+
+    void SparseJacobian(const std::vector<Base>& x,
+                        std::vector<Base>& jac,
+                        std::vector<size_t>& row,
+                        std::vector<size_t>& col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == n_, "Invalid independent array size")
+
+        jac.resize(getJacobianSparsity().nnz());
+        getSparseJacobian().evaluate(x, jac);
+
+        row = jacRow_;
+        col = jacCol_;
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == n_, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(getJacobianSparsity().nnz() == jac.size(), "Invalid number of non-zero elements in Jacobian")
+
+        getSparseJacobian().evaluate(x, jac);
+
+        *row = jacRow_.data();
+        *col = jacCol_.data();
+    }
+
+    void SparseJacobian(const std::vector<const Base*>& x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is invalid")
+
+        SparseJacobian(ArrayView<const Base>(x[0], n_), jac, row, col);
+    }
+
+    bool isSparseHessianAvailable() override {
+        return true;
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == n_, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == m_, "Invalid multiplier array size")
+        CPPADCG_ASSERT_KNOWN(hess.size() == n_ * n_, "Invalid Hessian size")
+
+        tmpOut_.resize(getHessianSparsity().nnz());
+        getSparseHessian().evaluate({x, w}, tmpOut_);
+
+        hess.fill(Base(0));
+        for (size_t e = 0; e < hessRow_.size(); e++) {
+            hess[hessRow_[e] * n_ + hessCol_[e]] = tmpOut_[e];
+        }
+    }
+
+    void SparseHessian(const std::vector<Base>& x,
+                       const std::vector<Base>& w,
+                       std::vector<Base>& hess,
+                       std::vector<size_t>& row,
+                       std::vector<size_t>& col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == n_, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == m_, "Invalid multiplier array size")
+
+        hess.resize(getHessianSparsity().nnz());
+        getSparseHessian().evaluate({ArrayView<const Base>(x), ArrayView<const Base>(w)}, hess);
+
+        row = hessRow_;
+        col = hessCol_;
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == n_, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == m_, "Invalid multiplier array size")
+        CPPADCG_ASSERT_KNOWN(getHessianSparsity().nnz() == hess.size(), "Invalid number of non-zero elements in Hessian")
+
+        getSparseHessian().evaluate({x, w}, hess);
+
+        *row = hessRow_.data();
+        *col = hessCol_.data();
+    }
+
+    void SparseHessian(const std::vector<const Base*>& x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is invalid")
+
+        SparseHessian(ArrayView<const Base>(x[0], n_), w, hess, row, col);
+    }
+
+protected:
+
+    /**
+     * Creates the operation graph of a function and translates it into
+     * bytecode.
+     *
+     * @param sizes the size of each independent variable array
+     * @param eval creates the dependent variables from the independent
+     *             variables
+     */
+    template<class Eval>
+    inline std::unique_ptr<BytecodeFunction<Base> > createFunction(const std::vector<size_t>& sizes,
+                                                                   Eval eval) {
+        CodeHandler<Base> handler;
+
+        std::vector<std::vector<CGBase> > indep(sizes.size());
+        for (size_t a = 0; a < sizes.size(); a++) {
+            indep[a].resize(sizes[a]);
+            handler.makeVariables(indep[a]);
+        }
+
+        const std::vector<CGBase> dep = eval(indep);
+
+        return std::unique_ptr<BytecodeFunction<Base> >(new BytecodeFunction<Base>(handler, dep));
+    }
+
+    inline BytecodeFunction<Base>& getForwardZero() {
+        if (zero_ == nullptr) {
+            zero_ = createFunction({n_}, [this](const std::vector<std::vector<CGBase> >& in) {
+                return fun_.Forward(0, in[0]);
+            });
+        }
+        return *zero_;
+    }
+
+    inline BytecodeFunction<Base>& getForwardOne() {
+        if (forwardOne_ == nullptr) {
+            forwardOne_ = createFunction({n_, n_}, [this](const std::vector<std::vector<CGBase> >& in) {
+                fun_.Forward(0, in[0]);
+                return fun_.Forward(1, in[1]);
+            });
+        }
+        return *forwardOne_;
+    }
+
+    inline BytecodeFunction<Base>& getReverseOne() {
+        if (reverseOne_ == nullptr) {
+            reverseOne_ = createFunction({n_, m_}, [this](const std::vector<std::vector<CGBase> >& in) {
+                fun_.Forward(0, in[0]);
+                return fun_.Reverse(1, in[1]);
+            });
+        }
+        return *reverseOne_;
+    }
+
+    inline BytecodeFunction<Base>& getReverseTwo() {
+        if (reverseTwo_ == nullptr) {
+            reverseTwo_ = createFunction({n_, n_, m_}, [this](const std::vector<std::vector<CGBase> >& in) {
+                fun_.Forward(0, in[0]);
+                fun_.Forward(1, in[1]);
+
+                std::vector<CGBase> py(2 * m_);
+                for (size_t i = 0; i < m_; i++) {
+                    py[2 * i] = Base(0);
+                    py[2 * i + 1] = in[2][i];
+                }
+                const std::vector<CGBase> px = fun_.Reverse(2, py);
+
+                std::vector<CGBase> px2(n_);
+                for (size_t j = 0; j < n_; j++) {
+                    px2[j] = px[2 * j];
+                }
+                return px2;
+            });
+        }
+        return *reverseTwo_;
+    }
+
+    inline BytecodeFunction<Base>& getSparseJacobian() {
+        if (sparseJacobian_ == nullptr) {
+            getJacobianSparsity();
+            sparseJacobian_ = createFunction({n_}, [this](const std::vector<std::vector<CGBase> >& in) {
+                const CppAD::sparse_rc<std::vector<size_t> > pattern = jacSparsity_.toSparseRc();
+                CppAD::sparse_rcv<std::vector<size_t>, std::vector<CGBase> > subset(pattern);
+
+                CppAD::sparse_jac_work work;
+                if (estimateBestJacobianADMode(jacRow_, jacCol_)) {
+                    size_t groupMax = 1; // a single direction per forward sweep
+                    fun_.sparse_jac_for(groupMax, in[0], subset, pattern, "cppad", work);
+                } else {
+                    fun_.sparse_jac_rev(in[0], subset, pattern, "cppad", work);
+                }
+
+                return subset.val();
+            });
+        }
+        return *sparseJacobian_;
+    }
+
+    inline BytecodeFunction<Base>& getSparseHessian() {
+        if (sparseHessian_ == nullptr) {
+            getHessianSparsity();
+            sparseHessian_ = createFunction({n_, m_}, [this](const std::vector<std::vector<CGBase> >& in) {
+                const CppAD::sparse_rc<std::vector<size_t> > pattern = hessSparsity_.toSparseRc();
+                CppAD::sparse_rcv<std::vector<size_t>, std::vector<CGBase> > subset(pattern);
+
+                CppAD::sparse_hes_work work;
+                fun_.sparse_hes(in[0], in[1], subset, pattern, "cppad.symmetric", work);
+
+                return subset.val();
+            });
+        }
+        return *sparseHessian_;
+    }
+
+    inline const SparsityPattern& getJacobianSparsity() {
+        if (jacSparsity_.rows() == 0 && m_ > 0) {
+            jacSparsity_ = jacobianSparsityPattern(fun_);
+            jacSparsity_.toIndexes(jacRow_, jacCol_);
+        }
+        return jacSparsity_;
+    }
+
+    inline const SparsityPattern& getHessianSparsity() {
+        if (hessSparsity_.rows() == 0 && n_ > 0) {
+            hessSparsity_ = hessianSparsityPattern(fun_);
+            hessSparsity_.toIndexes(hessRow_, hessCol_);
+        }
+        return hessSparsity_;
+    }
+
+    inline const SparsityPattern& getHessianSparsity(size_t i) {
+        CPPADCG_ASSERT_KNOWN(i < m_, "Invalid equation index")
+
+        if (hessSparsities_.empty()) {
+            hessSparsities_.resize(m_);
+        }
+
+        if (hessSparsities_[i].rows() == 0 && n_ > 0) {
+            std::vector<bool> selectRange(m_, false);
+            selectRange[i] = true;
+            hessSparsities_[i] = hessianSparsityPattern(fun_, std::vector<bool>(), selectRange,
+                                                        isBitsetSparsityPreferable(n_));
+        }
+        return hessSparsities_[i];
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -91,6 +91,10 @@ protected:
                 this->modelLibraryHelper_->finishedJob();
             }
 
+            this->processStreamedSources([&](const std::map<std::string, std::string>& sources) {
+                clang.generateLLVMBitCode(sources, this->modelLibraryHelper_);
+            });
+
             const std::map<std::string, std::string>& sources = this->getLibrarySources();
             clang.generateLLVMBitCode(sources, this->modelLibraryHelper_);
 
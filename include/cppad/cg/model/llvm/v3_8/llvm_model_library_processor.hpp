@@ -112,6 +112,10 @@ public:
             createLlvmModules(modelSources);
         }
 
+        this->processStreamedSources([this](const std::map<std::string, std::string>& sources) {
+            createLlvmModules(sources);
+        });
+
         const std::map<std::string, std::string>& sources = this->getLibrarySources();
         createLlvmModules(sources);
 
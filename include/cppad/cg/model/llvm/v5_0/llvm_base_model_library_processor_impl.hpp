@@ -31,6 +31,11 @@ class LlvmBaseModelLibraryProcessorImpl : public LlvmBaseModelLibraryProcessor<B
 protected:
     const std::string _version;
     std::vector<std::string> _includePaths;
+    /**
+     * whether or not to optimize the module with all the functions
+     * (e.g. inlining across source files) before the JIT compilation
+     */
+    bool _linkTimeOptimization;
     std::shared_ptr<llvm::LLVMContext> _context; // must be deleted after _linker and _module (it must come first)
     std::unique_ptr<llvm::Linker> _linker;
     std::unique_ptr<llvm::Module> _module;
@@ -44,7 +49,8 @@ public:
     LlvmBaseModelLibraryProcessorImpl(ModelLibraryCSourceGen<Base>& librarySourceGen,
                                       std::string version) :
         LlvmBaseModelLibraryProcessor<Base>(librarySourceGen),
-            _version(std::move(version)) {
+            _version(std::move(version)),
+            _linkTimeOptimization(false) {
     }
 
     virtual ~LlvmBaseModelLibraryProcessorImpl() = default;
@@ -70,6 +76,25 @@ public:
         return _includePaths;
     }
 
+    /**
+     * Defines whether or not to optimize the module with all the functions
+     * of the library before the JIT compilation.
+     * Functions created from different source files (e.g. the sparse
+     * forward mode functions used by the sparse Jacobian) can then be
+     * inlined into each other.
+     */
+    inline void setLinkTimeOptimization(bool lto) {
+        _linkTimeOptimization = lto;
+    }
+
+    /**
+     * Whether or not the module with all the functions of the library is
+     * optimized before the JIT compilation.
+     */
+    inline bool isLinkTimeOptimization() const {
+        return _linkTimeOptimization;
+    }
+
     /**
      *
      * @return a model library
@@ -94,6 +119,10 @@ public:
             createLlvmModules(modelSources);
         }
 
+        this->processStreamedSources([this](const std::map<std::string, std::string>& sources) {
+            createLlvmModules(sources);
+        });
+
         const std::map<std::string, std::string>& sources = this->getLibrarySources();
         createLlvmModules(sources);
 
@@ -102,7 +131,7 @@ public:
 
         llvm::InitializeNativeTarget();
 
-        std::unique_ptr<LlvmModelLibrary<Base>> lib(new LlvmModelLibraryImpl<Base>(std::move(_module), _context));
+        std::unique_ptr<LlvmModelLibrary<Base>> lib(new LlvmModelLibraryImpl<Base>(std::move(_module), _context, _linkTimeOptimization));
 
         this->modelLibraryHelper_->finishedJob();
 
@@ -179,7 +208,7 @@ public:
             llvm::InitializeNativeTarget();
 
             // voila
-            lib.reset(new LlvmModelLibraryImpl<Base>(std::move(linkerModule), _context));
+            lib.reset(new LlvmModelLibraryImpl<Base>(std::move(linkerModule), _context, _linkTimeOptimization));
 
         } catch (...) {
             clang.cleanup();
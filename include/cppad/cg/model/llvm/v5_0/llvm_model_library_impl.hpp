@@ -35,12 +35,25 @@ protected:
     std::unique_ptr<llvm::legacy::FunctionPassManager> _fpm;
 public:
 
+    /**
+     * Creates a JIT evaluated model library.
+     *
+     * @param module the module with all the model functions
+     * @param context the LLVM context of the module
+     * @param linkTimeOptimization whether or not to optimize the whole
+     *                             module, including inlining across
+     *                             functions, before the JIT compilation
+     */
     LlvmModelLibraryImpl(std::unique_ptr<llvm::Module> module,
-                         std::shared_ptr<llvm::LLVMContext> context) :
+                         std::shared_ptr<llvm::LLVMContext> context,
+                         bool linkTimeOptimization = false) :
         _module(module.get()),
         _context(context) {
         using namespace llvm;
 
+        if (linkTimeOptimization)
+            optimizeModule(*module);
+
         // Create the JIT.  This takes ownership of the module.
         std::string errStr;
         _executionEngine.reset(EngineBuilder(std::move(module))
@@ -84,6 +97,20 @@ public:
         //_fpm.add(new DataLayoutPass());
     }
 
+    /**
+     * Runs the interprocedural optimizations (e.g. inlining) on the whole
+     * module. Functions are not internalized so that they can still be
+     * loaded by name.
+     */
+    static void optimizeModule(llvm::Module& module) {
+        llvm::legacy::PassManager mpm;
+        llvm::PassManagerBuilder builder;
+        builder.OptLevel = 2;
+        builder.Inliner = llvm::createFunctionInliningPass(builder.OptLevel, 0, false);
+        builder.populateModulePassManager(mpm);
+        mpm.run(module);
+    }
+
     void* loadFunction(const std::string& functionName, bool required = true) override {
         llvm::Function* func = _module->getFunction(functionName);
         if (func == nullptr) {
@@ -42,6 +42,10 @@ class ModelCSourceGen {
     using TapeVarType = std::pair<size_t, size_t>; // tape independent -> reference orig independent (temporaries only)
 public:
     static const std::string FUNCTION_FORWAD_ZERO;
+    static const std::string FUNCTION_FORWARD_ZERO_PARTITION;
+    static const std::string FUNCTION_FORWARD_ZERO_PARTITION_SPARSITY;
+    static const std::string FUNCTION_FORWARD_ZERO_INDEP_PARTITIONS;
+    static const std::string FUNCTION_FORWARD_ZERO_PARTITION_COST;
     static const std::string FUNCTION_JACOBIAN;
     static const std::string FUNCTION_HESSIAN;
     static const std::string FUNCTION_FORWARD_ONE;
@@ -59,6 +63,7 @@ public:
     static const std::string FUNCTION_REVERSE_ONE_SPARSITY;
     static const std::string FUNCTION_REVERSE_TWO_SPARSITY;
     static const std::string FUNCTION_INFO;
+    static const std::string FUNCTION_DYNAMIC_INFO;
     static const std::string FUNCTION_ATOMIC_FUNC_NAMES;
 protected:
     static const std::string CONST;
@@ -113,7 +118,7 @@ protected:
          * Calculated sparsity from the model
          * (may differ from the requested sparsity)
          */
-        SparsitySetType sparsity;
+        SparsityPattern sparsity;
         // rows (in a custom order)
         std::vector<size_t> rows;
         // columns (in a custom order)
@@ -174,6 +179,12 @@ protected:
     /// generate source code for the zero order model evaluation
     bool _zero;
     bool _zeroEvaluated;
+    /**
+     * generate source code for the incremental zero order model evaluation
+     * (only the dependents affected by a change in some independent
+     * variables are re-evaluated)
+     */
+    bool _zeroIncremental;
     /// generate source code for a dense Jacobian
     bool _jacobian;
     /// generate source code for a dense Hessian
@@ -198,6 +209,12 @@ protected:
      * one functions when _sparseJacobian is true
      */
     bool _sparseJacobianReusesOne;
+    /**
+     * whether or not the sparse Jacobian should be evaluated by groups of
+     * structurally orthogonal columns/rows (coloring) when _sparseJacobian
+     * is true
+     */
+    bool _sparseJacobianColoring;
     /**
      * whether or not the sparse Hessian should reuse the reverse two
      * functions when _sparseHessian is true
@@ -209,11 +226,23 @@ protected:
      */
     Position _custom_jac;
     LocalSparsityInfo _jacSparsity;
+    /**
+     * The order of the elements in the sparse Jacobian
+     */
+    SparseMatrixLayout _jacLayout;
     /**
      * Custom Hessian element indexes
      */
     Position _custom_hess;
     LocalSparsityInfo _hessSparsity;
+    /**
+     * The order of the elements in the sparse Hessian
+     */
+    SparseMatrixLayout _hessLayout;
+    /**
+     * The elements of the sparse Hessian which are provided
+     */
+    MatrixTriangle _hessTriangle;
     /**
      * Hessian sparsity from the model for each equation
      */
@@ -222,6 +251,11 @@ protected:
      * The order of the atomic functions
      */
     std::vector<std::string> _atomicFunctions;
+    /**
+     * The atomic functions which are models in the same library and
+     * which are called directly (without the LangCAtomicFun structure)
+     */
+    std::set<std::string> _directAtomicFunctions;
     /**
      * Maps each atomic function ID to information regarding how the atomic function is used
      */
@@ -238,10 +272,30 @@ protected:
      * the maximum number of operations per variable assignment
      */
     size_t _maxOperationsPerAssignment;
+    /**
+     * the target number of operations per function when the functions are
+     * split automatically (zero disables the automatic splitting)
+     */
+    size_t _maxOperationsPerFunc;
     /**
      *
      */
     std::vector<std::set<size_t> > _relatedDepCandidates;
+    /**
+     * whether or not to determine the related dependent candidates
+     * automatically when none are provided
+     */
+    bool _autoRelatedDependents;
+    /**
+     * estimated number of operations which were not unrolled in the
+     * generated source code due to the use of loops
+     */
+    size_t _loopOperationSavings;
+    /**
+     * the number of threads used to compare dependents during loop
+     * detection (zero means the number of hardware threads)
+     */
+    size_t _loopDetectionThreads;
     /**
      * Maps the column groups of each loop model to the set of columns
      * (loop->group->{columns->{compressed forward 1 position} })
@@ -280,6 +334,15 @@ protected:
      * Generated source code (maps file names to content)
      */
     std::map<std::string, std::string> _sources;
+    /**
+     * Writes the generated source files to disk instead of keeping them in
+     * memory (optional)
+     */
+    SourceFileStream* _sourceStream;
+    /**
+     * Whether or not the source code was already generated
+     */
+    bool _sourcesGenerated;
 public:
 
     /**
@@ -299,6 +362,7 @@ public:
         _multiThreading(true),
         _zero(true),
         _zeroEvaluated(false),
+        _zeroIncremental(false),
         _jacobian(false),
         _hessian(false),
         _sparseJacobian(false),
@@ -308,12 +372,22 @@ public:
         _reverseOne(false),
         _reverseTwo(false),
         _sparseJacobianReusesOne(true),
+        _sparseJacobianColoring(false),
         _sparseHessianReusesRev2(true),
         _jacMode(JacobianADMode::Automatic),
+        _jacLayout(SparseMatrixLayout::Custom),
+        _hessLayout(SparseMatrixLayout::Custom),
+        _hessTriangle(MatrixTriangle::Full),
         _atomicsInfo(nullptr),
         _maxAssignPerFunc(20000),
         _maxOperationsPerAssignment(1000),
-        _jobTimer(nullptr) {
+        _maxOperationsPerFunc(0),
+        _autoRelatedDependents(false),
+        _loopOperationSavings(0),
+        _loopDetectionThreads(1),
+        _jobTimer(nullptr),
+        _sourceStream(nullptr),
+        _sourcesGenerated(false) {
 
         CPPADCG_ASSERT_KNOWN(!_name.empty(), "Model name cannot be empty")
         CPPADCG_ASSERT_KNOWN((_name[0] >= 'a' && _name[0] <= 'z') ||
@@ -367,6 +441,96 @@ public:
         return _relatedDepCandidates;
     }
 
+    /**
+     * Whether or not the groups of related dependents used to detect loops
+     * are determined automatically when none are provided with
+     * setRelatedDependents().
+     *
+     * @return true if related dependents are determined automatically
+     */
+    inline bool isAutomaticRelatedDependents() const {
+        return _autoRelatedDependents;
+    }
+
+    /**
+     * Defines whether or not the groups of related dependents used to detect
+     * loops are determined automatically when none are provided with
+     * setRelatedDependents().
+     * Dependents are grouped by the structure of their expressions and only
+     * those groups which really share the same expression pattern are
+     * converted into loops.
+     * Automatic loop detection is not performed for models with dynamic
+     * parameters or with the incremental zero order forward mode.
+     *
+     * @param automatic true to determine related dependents automatically
+     */
+    inline void setAutomaticRelatedDependents(bool automatic) {
+        _autoRelatedDependents = automatic;
+    }
+
+    /**
+     * Provides the number of threads used to compare the expressions of
+     * related dependents during loop detection.
+     *
+     * @return the number of threads (zero means the number of concurrent
+     *         threads supported by the hardware)
+     */
+    inline size_t getLoopDetectionThreads() const {
+        return _loopDetectionThreads;
+    }
+
+    /**
+     * Defines the number of threads used to compare the expressions of
+     * related dependents during loop detection.
+     * Different groups of related dependents are processed in parallel and
+     * the generated source code does not depend on the number of threads.
+     *
+     * @param threads the number of threads (zero means the number of
+     *                concurrent threads supported by the hardware)
+     */
+    inline void setLoopDetectionThreads(size_t threads) {
+        _loopDetectionThreads = threads;
+    }
+
+    /**
+     * Provides the loops detected in the model.
+     * Only available after the source code has been generated.
+     *
+     * @return the loop models
+     */
+    inline const std::set<LoopModel<Base>*>& getLoops() const {
+        return _loopTapes;
+    }
+
+    /**
+     * Provides an estimate of the number of operations which did not have to
+     * be unrolled in the zero order model because of the detected loops
+     * (the operations in each loop iteration times the number of repeated
+     * iterations).
+     * Only available after the source code has been generated.
+     *
+     * @return the estimated number of operations saved by loops
+     */
+    inline size_t getEstimatedLoopSavings() const {
+        return _loopOperationSavings;
+    }
+
+    /**
+     * Provides the number of CppAD dynamic parameters in the taped model.
+     * Dynamic parameters are not hard-coded in the generated source code,
+     * instead they are provided to the generated functions through an
+     * additional (last) input array.
+     * Dynamic parameters are currently only supported by the zero order
+     * forward mode, the dense and sparse Jacobians, and the dense and sparse
+     * Hessians (without loops and without reusing the forward one, reverse
+     * one, and reverse two functions).
+     *
+     * @return the number of dynamic parameters
+     */
+    inline size_t getDynamicParameterSize() const {
+        return _fun.size_dyn_ind();
+    }
+
     /**
      * Provides the maximum precision used to print constant values in the
      * generated source code
@@ -387,6 +551,30 @@ public:
         _parameterPrecision = p;
     }
 
+    /**
+     * Provides the names of the atomic functions which are called directly
+     * from the generated source code because they are models compiled into
+     * the same library.
+     *
+     * @return the names of the atomic functions
+     */
+    inline const std::set<std::string>& getDirectAtomicFunctions() const {
+        return _directAtomicFunctions;
+    }
+
+    /**
+     * Defines the atomic functions which are called directly from the
+     * generated source code instead of through the atomic function
+     * structure provided by the model library.
+     * These atomic functions must be models compiled into the same library.
+     * This is usually defined by the ModelLibraryCSourceGen.
+     *
+     * @param names the names of the atomic functions
+     */
+    inline void setDirectAtomicFunctions(const std::set<std::string>& names) {
+        _directAtomicFunctions = names;
+    }
+
     /**
      * Returns whether or not multithreading directives can be generated to
      * parallelize the sparse Jacobian and sparse Hessian evaluation.
@@ -655,6 +843,37 @@ public:
         _sparseJacobianReusesOne = reuse;
     }
 
+    /**
+     * Determines whether or not the sparse Jacobian is evaluated using
+     * one function for each group of structurally orthogonal columns
+     * (forward mode) or rows (reverse mode).
+     *
+     * @return true if coloring is used to generate the sparse Jacobian
+     */
+    inline bool isSparseJacobianColoring() const {
+        return _sparseJacobianColoring;
+    }
+
+    /**
+     * Defines whether or not the sparse Jacobian is evaluated using
+     * one function for each group of structurally orthogonal columns
+     * (forward mode) or rows (reverse mode) determined with a greedy
+     * distance-2 coloring.
+     * Each function computes a compressed Jacobian-vector product (forward)
+     * or vector-Jacobian product (reverse) which is then scattered into
+     * the sparse Jacobian.
+     * This can greatly reduce the number of generated functions when
+     * compared with the reuse of the forward one or reverse one functions
+     * (one function per column or row), and it takes precedence over it.
+     * It is not used for models with loops and the generated code is
+     * not multithreaded.
+     *
+     * @param coloring true to use coloring to generate the sparse Jacobian
+     */
+    inline void setSparseJacobianColoring(bool coloring) {
+        _sparseJacobianColoring = coloring;
+    }
+
     /**
      * Determines whether or not to generate source-code for a function
      * that evaluates the original model.
@@ -677,6 +896,41 @@ public:
         _zero = create;
     }
 
+    /**
+     * Determines whether or not to generate source-code for the incremental
+     * evaluation of the original model.
+     * The dependent variables are partitioned according to the independent
+     * variables they depend on and a function is created for each
+     * partition. Only the partitions affected by the independent variables
+     * which changed since a previous evaluation need to be re-evaluated.
+     *
+     * @return true if source-code for the incremental evaluation of the
+     *         original model should be created, false otherwise
+     */
+    inline bool isCreateForwardZeroIncremental() const {
+        return _zeroIncremental;
+    }
+
+    /**
+     * Defines whether or not to generate source-code for the incremental
+     * evaluation of the original model.
+     * The dependent variables are partitioned according to the independent
+     * variables they depend on and a function is created for each
+     * partition. Only the partitions affected by the independent variables
+     * which changed since a previous evaluation need to be re-evaluated.
+     * The temporary variables shared by several partitions are computed
+     * again in each partition, therefore, if the source-code for the
+     * original model is also created, the full model is evaluated instead
+     * whenever the affected partitions require at least as many operations.
+     * Models with loops are not supported.
+     *
+     * @param create true if source-code for the incremental evaluation of
+     *               the original model should be created, false otherwise
+     */
+    inline void setCreateForwardZeroIncremental(bool create) {
+        _zeroIncremental = create;
+    }
+
     /**
      * Determines whether or not to generate source-code for the
      * first-order forward mode that is used for the evaluation of the
@@ -765,7 +1019,7 @@ public:
      *         mode is enabled, false otherwise.
      */
     inline bool isCreateReverseTwo() const {
-        return _reverseOne;
+        return _reverseTwo;
     }
 
     /**
@@ -851,6 +1105,73 @@ public:
         _custom_hess = Position(elements);
     }
 
+    /**
+     * Provides the order of the elements in the sparse Jacobian.
+     *
+     * @return the layout of the sparse Jacobian
+     */
+    inline SparseMatrixLayout getSparseJacobianLayout() const {
+        return _jacLayout;
+    }
+
+    /**
+     * Defines the order of the elements in the sparse Jacobian so that the
+     * generated code can write directly into the arrays used by a linear
+     * solver (e.g. CSR or CSC).
+     * With SparseMatrixLayout::Custom (default) the elements are provided in
+     * the order defined by setCustomSparseJacobianElements() or, if no
+     * custom elements were defined, in a row-major order.
+     * Other layouts sort the elements (including custom elements).
+     * The element indexes are available through
+     * GenericModel::JacobianSparsity() and the compressed indexes through
+     * GenericModel::JacobianSparsityCSR() or
+     * GenericModel::JacobianSparsityCSC().
+     *
+     * @param layout the layout of the sparse Jacobian
+     */
+    inline void setSparseJacobianLayout(SparseMatrixLayout layout) {
+        _jacLayout = layout;
+    }
+
+    /**
+     * Provides the order of the elements in the sparse Hessian.
+     *
+     * @return the layout of the sparse Hessian
+     */
+    inline SparseMatrixLayout getSparseHessianLayout() const {
+        return _hessLayout;
+    }
+
+    /**
+     * Provides which elements of the (symmetric) sparse Hessian are
+     * generated.
+     *
+     * @return the generated triangle of the sparse Hessian
+     */
+    inline MatrixTriangle getSparseHessianTriangle() const {
+        return _hessTriangle;
+    }
+
+    /**
+     * Defines the order of the elements in the sparse Hessian so that the
+     * generated code can write directly into the arrays used by a linear
+     * solver (e.g. a lower triangle in the CSC format).
+     * With SparseMatrixLayout::Custom (default) the elements are provided in
+     * the order defined by setCustomSparseHessianElements() or, if no
+     * custom elements were defined, in a row-major order.
+     * Other layouts sort the elements (including custom elements).
+     *
+     * @param layout the layout of the sparse Hessian
+     * @param triangle the elements of the Hessian to generate; elements
+     *                 outside this triangle (including custom elements)
+     *                 are replaced by their symmetric element
+     */
+    inline void setSparseHessianLayout(SparseMatrixLayout layout,
+                                       MatrixTriangle triangle = MatrixTriangle::Full) {
+        _hessLayout = layout;
+        _hessTriangle = triangle;
+    }
+
     /**
      * The maximum number of assignment per generated function.
      * Zero means it is disabled (no limit).
@@ -896,6 +1217,64 @@ public:
         _maxOperationsPerAssignment = maxOperationsPerAssignment;
     }
 
+    /**
+     * The target number of operations per generated function used by the
+     * automatic function splitting.
+     *
+     * @return The maximum number of operations per file/function (zero if
+     *         the automatic function splitting is disabled)
+     */
+    inline size_t getMaxOperationsPerFunc() const {
+        return _maxOperationsPerFunc;
+    }
+
+    /**
+     * Enables the automatic function splitting.
+     * Instead of starting a new function/file after a fixed number of
+     * assignments, the split points are selected from the dependencies
+     * between variables in order to reduce the number of values passed
+     * between functions, while keeping the number of operations of each
+     * function close to the provided limit.
+     * The chosen partition is reported through the job timer.
+     * Zero means it is disabled (the maximum number of assignments per
+     * function is used instead).
+     *
+     * @param maxOperationsPerFunc The target number of operations per file/function
+     */
+    inline void setMaxOperationsPerFunc(size_t maxOperationsPerFunc) {
+        _maxOperationsPerFunc = maxOperationsPerFunc;
+    }
+
+    /**
+     * Provides the stream where the generated source files are written.
+     *
+     * @return the source file stream (null if the sources are kept in
+     *         memory)
+     */
+    inline SourceFileStream* getSourceStream() const {
+        return _sourceStream;
+    }
+
+    /**
+     * Defines a stream where each source file is written as soon as it is
+     * generated, instead of keeping all the sources in memory until they
+     * are compiled.
+     * The peak memory used by the source code is then limited to a single
+     * source file (see setMaxAssignmentsPerFunction() and
+     * setMaxOperationsPerFunc() to limit the size of each file).
+     * The streamed files are not included in the sources returned by
+     * getSources(); DynamicModelLibraryProcessor compiles them directly
+     * from the stream.
+     * The stream must only be deleted after this object and it must be
+     * defined before the source code is generated.
+     *
+     * @param sourceStream the source file stream (null to keep the sources
+     *                     in memory)
+     */
+    inline void setSourceStream(SourceFileStream* sourceStream) {
+        _sourceStream = sourceStream;
+    }
+
     inline virtual ~ModelCSourceGen() {
         delete _funNoLoops;
         delete _atomicsInfo;
@@ -928,22 +1307,57 @@ protected:
     virtual void generateSources(MultiThreadingType multiThreadingType,
                                  JobTimer* timer = nullptr);
 
+    /**
+     * Saves a new source file in the source file stream or in memory.
+     *
+     * @param name the source file name
+     * @param source the source file content
+     */
+    inline void saveSource(const std::string& name,
+                           const std::string& source) {
+        if (_sourceStream != nullptr) {
+            _sourceStream->write(name, source);
+        } else {
+            _sources[name] = source;
+        }
+    }
+
     virtual void generateLoops();
 
     virtual void generateInfoSource();
 
+    virtual void generateDynamicInfoSource();
+
     virtual void generateAtomicFuncNames();
 
     virtual bool isAtomicsUsed();
 
     virtual const std::map<size_t, AtomicUseInfo<Base> >& getAtomicsInfo();
 
+    /**
+     * Creates the variables for the CppAD dynamic parameters in a code
+     * handler and defines them as the new dynamic parameter values of the
+     * tape. They must be created after all other independent variables
+     * (and multipliers) of the handler.
+     *
+     * @param handler The operation graph handler
+     * @return the dynamic parameters (empty if the model has none)
+     */
+    virtual std::vector<CGBase> makeDynamicParameters(CodeHandler<Base>& handler);
+
     /***********************************************************************
      * zero order (the original model)
      **********************************************************************/
 
     virtual void generateZeroSource();
 
+    /**
+     * Generates the functions for the evaluation of each partition of the
+     * dependent variables and the relations between partitions and
+     * independent variables.
+     */
+    virtual void generateZeroIncrementalSources();
+
     /**
      * Generates the operation graph for the zero order model with loops
      */
@@ -963,6 +1377,14 @@ protected:
     virtual void generateSparseJacobianForRevSource(bool forward,
                                                     MultiThreadingType multiThreadingType);
 
+    /**
+     * Generates a sparse Jacobian which calls a function for each group of
+     * structurally orthogonal columns (forward mode) or rows (reverse mode).
+     *
+     * @param forward whether or not to use forward mode
+     */
+    virtual void generateSparseJacobianColoredSource(bool forward);
+
     virtual std::string generateSparseJacobianForRevSingleThreadSource(const std::string& functionName,
                                                                        std::map<size_t, CompressedVectorInfo> jacInfo,
                                                                        size_t maxCompressedSize,
@@ -1170,7 +1592,7 @@ protected:
 
 
     inline static std::map<size_t, std::map<size_t, CG<Base> > > generateLoopFor1Jac(ADFun<CGBase>& fun,
-                                                                                     const SparsitySetType& sparsity,
+                                                                                     const SparsityPattern& sparsity,
                                                                                      const SparsitySetType& evalSparsity,
                                                                                      const std::vector<CGBase>& xl,
                                                                                      bool constainsAtomics);
@@ -1194,7 +1616,7 @@ protected:
                                              std::vector<CG<Base> >& jacRow);
 
     inline static std::vector<std::map<size_t, CGBase> > generateLoopRev1Jac(ADFun<CGBase>& fun,
-                                                                             const SparsitySetType& sparsity,
+                                                                             const SparsityPattern& sparsity,
                                                                              const SparsitySetType& evalSparsity,
                                                                              const std::vector<CGBase>& xl,
                                                                              bool constainsAtomics);
@@ -1229,10 +1651,39 @@ protected:
 
     virtual void determineJacobianSparsity();
 
+    /**
+     * Evaluates the elements of the Jacobian (in the order defined by
+     * _jacSparsity.rows and _jacSparsity.cols) using CppAD.
+     *
+     * @param x the independent variables
+     * @param forward whether to use forward mode (or reverse mode)
+     * @param jac the Jacobian elements
+     */
+    virtual void evalSparseJacobian(const std::vector<CGBase>& x,
+                                    bool forward,
+                                    std::vector<CGBase>& jac);
+
     virtual void generateJacobianSparsitySource();
 
     virtual void determineHessianSparsity();
 
+    /**
+     * Evaluates elements of the weighted sum of the Hessians using CppAD.
+     *
+     * @param x the independent variables
+     * @param w the weights (multipliers) of the Hessians of each equation
+     * @param rows the row indexes of the elements to evaluate
+     * @param cols the column indexes of the elements to evaluate
+     * @param coloring the CppAD coloring method
+     * @param hess the Hessian elements
+     */
+    virtual void evalSparseHessian(const std::vector<CGBase>& x,
+                                   const std::vector<CGBase>& w,
+                                   const std::vector<size_t>& rows,
+                                   const std::vector<size_t>& cols,
+                                   const std::string& coloring,
+                                   std::vector<CGBase>& hess);
+
     /**
      * Determines groups of rows from a sparsity pattern which do not share
      * the same columns
@@ -1243,7 +1694,7 @@ protected:
      * @return the colors
      */
     inline std::vector<ModelCSourceGen<Base>::Color> colorByRow(const std::set<size_t>& columns,
-                                                                const SparsitySetType& sparsity);
+                                                                const SparsityPattern& sparsity);
 
     virtual void generateHessianSparsitySource();
 
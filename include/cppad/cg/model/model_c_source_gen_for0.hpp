@@ -35,6 +35,9 @@ void ModelCSourceGen<Base>::generateZeroSource() {
         }
     }
 
+    // dynamic parameters
+    makeDynamicParameters(handler);
+
     std::vector<CGBase> dep;
 
     if (_loopTapes.empty()) {
@@ -50,14 +53,153 @@ void ModelCSourceGen<Base>::generateZeroSource() {
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+    langC.setSourceStream(_sourceStream);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     langC.setGenerateFunction(_name + "_" + FUNCTION_FORWAD_ZERO);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
+    LangCDefaultDynamicParamVarNameGenerator<Base> nameGenDyn(nameGen.get(), indVars.size());
+    VariableNameGenerator<Base>& nameGenP = _fun.size_dyn_ind() > 0 ? nameGenDyn : *nameGen;
+
+    handler.generateCode(code, langC, dep, nameGenP, _atomicFunctions, jobName);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateZeroIncrementalSources() {
+    const std::string jobName = "model (incremental zero-order forward)";
+
+    startingJob("'" + jobName + "'", JobTimer::GRAPH);
+
+    size_t n = _fun.Domain();
+
+    CodeHandler<Base> handler;
+    handler.setJobTimer(_jobTimer);
+
+    std::vector<CGBase> indVars(n);
+    handler.makeVariables(indVars);
+    if (_x.size() > 0) {
+        for (size_t i = 0; i < indVars.size(); i++) {
+            indVars[i].setValue(_x[i]);
+        }
+    }
+
+    // dynamic parameters
+    makeDynamicParameters(handler);
+
+    std::vector<CGBase> dep = _fun.Forward(0, indVars);
+
+    /**
+     * group the dependents which depend on the same independent variables
+     * (dependents which do not depend on any independent variable never
+     *  have to be re-evaluated)
+     */
+    std::vector<std::set<size_t> > depIndeps = handler.findIndependentDependencies(dep);
+
+    std::map<std::set<size_t>, std::vector<size_t> > groups;
+    for (size_t i = 0; i < dep.size(); i++) {
+        std::set<size_t>& indeps = depIndeps[i];
+        indeps.erase(indeps.lower_bound(n), indeps.end()); // ignore dynamic parameters
+        if (!indeps.empty()) {
+            groups[indeps].push_back(i);
+        }
+    }
+
+    // elements[partition]{equations}
+    std::map<size_t, std::vector<size_t> > elements;
+    // indepPartitions[var]{partitions}
+    std::map<size_t, std::vector<size_t> > indepPartitions;
+
+    /**
+     * the number of operations of each partition followed by the number of
+     * operations of the full model (shared temporaries are evaluated by
+     * every partition which uses them)
+     */
+    std::vector<size_t> cost;
+    cost.reserve(groups.size() + 1);
+
+    size_t k = 0;
+    for (const auto& it : groups) {
+        elements[k] = it.second;
+        for (size_t j : it.first) {
+            indepPartitions[j].push_back(k);
+        }
+
+        std::vector<CGBase> depPart(it.second.size());
+        for (size_t e = 0; e < it.second.size(); e++) {
+            depPart[e] = dep[it.second[e]];
+        }
+        cost.push_back(handler.countOperations(depPart));
+
+        k++;
+    }
+
+    cost.push_back(handler.countOperations(dep));
+
+    finishedJob();
+
+    /**
+     * Generate one function for each partition
+     */
+    startingJob("'" + jobName + "'", JobTimer::SOURCE_GENERATION);
+
+    for (const auto& it : elements) {
+        const std::vector<size_t>& rows = it.second;
+
+        std::vector<CGBase> depPart(rows.size());
+        for (size_t e = 0; e < rows.size(); e++) {
+            depPart[e] = dep[rows[e]];
+        }
+
+        _cache.str("");
+        _cache << "model (incremental zero-order forward, partition " << it.first << ")";
+        const std::string subJobName = _cache.str();
+
+        LanguageC<Base> langC(_baseTypeName);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+        langC.setSourceStream(_sourceStream);
+        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setDirectAtomicFunctions(_directAtomicFunctions);
+        _cache.str("");
+        _cache << _name << "_" << FUNCTION_FORWARD_ZERO_PARTITION << "_part" << it.first;
+        langC.setGenerateFunction(_cache.str());
+
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
+        LangCDefaultDynamicParamVarNameGenerator<Base> nameGenDyn(nameGen.get(), n);
+        VariableNameGenerator<Base>& nameGenP = _fun.size_dyn_ind() > 0 ? nameGenDyn : *nameGen;
+
+        handler.generateCode(code, langC, depPart, nameGenP, _atomicFunctions, subJobName);
+    }
+
+    finishedJob();
+
+    _cache.str("");
+
+    generateGlobalDirectionalFunctionSource(FUNCTION_FORWARD_ZERO_PARTITION,
+                                            "part",
+                                            FUNCTION_FORWARD_ZERO_PARTITION_SPARSITY,
+                                            elements);
+
+    /**
+     * the partitions affected by each independent variable
+     */
+    generateSparsity1DSource2(_name + "_" + FUNCTION_FORWARD_ZERO_INDEP_PARTITIONS, indepPartitions);
+    saveSource(_name + "_" + FUNCTION_FORWARD_ZERO_INDEP_PARTITIONS + ".c", _cache.str());
+    _cache.str("");
 
-    handler.generateCode(code, langC, dep, *nameGen, _atomicFunctions, jobName);
+    /**
+     * the cost of each partition (used to decide when the full model
+     * should be evaluated instead)
+     */
+    generateSparsity1DSource(_name + "_" + FUNCTION_FORWARD_ZERO_PARTITION_COST, cost);
+    saveSource(_name + "_" + FUNCTION_FORWARD_ZERO_PARTITION_COST + ".c", _cache.str());
+    _cache.str("");
 }
 
 
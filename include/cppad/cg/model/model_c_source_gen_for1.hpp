@@ -115,8 +115,11 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
 
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+        langC.setSourceStream(_sourceStream);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setDirectAtomicFunctions(_directAtomicFunctions);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -157,8 +160,7 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
 
     vector<CGBase> jacFlat(_jacSparsity.rows.size());
 
-    CppAD::sparse_jacobian_work work; // temporary structure for CPPAD
-    _fun.SparseJacobianForward(x, _jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols, jacFlat, work);
+    evalSparseJacobian(x, true, jacFlat);
 
     /**
      * organize results
@@ -202,8 +204,11 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
 
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+        langC.setSourceStream(_sourceStream);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setDirectAtomicFunctions(_directAtomicFunctions);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -316,7 +321,7 @@ void ModelCSourceGen<Base>::generateForwardOneSources() {
             "   free(txPos);\n"
             "   return 0;\n"
             "}\n";
-    _sources[model_function + ".c"] = _cache.str();
+    saveSource(model_function + ".c", _cache.str());
     _cache.str("");
 }
 
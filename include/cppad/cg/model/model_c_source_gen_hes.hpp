@@ -51,6 +51,9 @@ void ModelCSourceGen<Base>::generateHessianSource() {
         }
     }
 
+    // dynamic parameters
+    makeDynamicParameters(handler);
+
     vector<CGBase> hess = _fun.Hessian(indVars, w);
 
     // make use of the symmetry of the Hessian in order to reduce operations
@@ -64,15 +67,20 @@ void ModelCSourceGen<Base>::generateHessianSource() {
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+    langC.setSourceStream(_sourceStream);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     langC.setGenerateFunction(_name + "_" + FUNCTION_HESSIAN);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
+    LangCDefaultDynamicParamVarNameGenerator<Base> nameGenDyn(&nameGenHess, n + m);
+    VariableNameGenerator<Base>& nameGenP = _fun.size_dyn_ind() > 0 ? nameGenDyn : static_cast<VariableNameGenerator<Base>&>(nameGenHess);
 
-    handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    handler.generateCode(code, langC, hess, nameGenP, _atomicFunctions, jobName);
 }
 
 template<class Base>
@@ -181,15 +189,16 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
         }
     }
 
+    // dynamic parameters
+    makeDynamicParameters(handler);
+
     vector<CGBase> hess(_hessSparsity.rows.size());
     if (_loopTapes.empty()) {
-        CppAD::sparse_hessian_work work;
         // "cppad.symmetric" may have missing values for functions using atomic 
         // functions which only provide half of the elements 
         // (some values could be zeroed)
-        work.color_method = "cppad.general";
         vector<CGBase> lowerHess(lowerHessRows.size());
-        _fun.SparseHessian(indVars, w, _hessSparsity.sparsity, lowerHessRows, lowerHessCols, lowerHess, work);
+        evalSparseHessian(indVars, w, lowerHessRows, lowerHessCols, "cppad.general", lowerHess);
 
         for (size_t i = 0; i < lowerHessOrder.size(); i++) {
             hess[lowerHessOrder[i]] = lowerHess[i];
@@ -212,15 +221,20 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+    langC.setSourceStream(_sourceStream);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_HESSIAN);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
+    LangCDefaultDynamicParamVarNameGenerator<Base> nameGenDyn(&nameGenHess, n + m);
+    VariableNameGenerator<Base>& nameGenP = _fun.size_dyn_ind() > 0 ? nameGenDyn : static_cast<VariableNameGenerator<Base>&>(nameGenHess);
 
-    handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    handler.generateCode(code, langC, hess, nameGenP, _atomicFunctions, jobName);
 }
 
 template<class Base>
@@ -294,9 +308,9 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceFromRev2(MultiThreadingTy
     string rev2Suffix = "indep";
 
     if (!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
-        _sources[functionName + ".c"] = generateSparseHessianRev2SingleThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix);
+        saveSource(functionName + ".c", generateSparseHessianRev2SingleThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix));
     } else {
-        _sources[functionName + ".c"] = generateSparseHessianRev2MultiThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix, multiThreadingType);
+        saveSource(functionName + ".c", generateSparseHessianRev2MultiThreadSource(functionName, hessInfo, maxCompressedSize, functionRev2, rev2Suffix, multiThreadingType));
     }
     _cache.str("");
 }
@@ -527,8 +541,7 @@ void ModelCSourceGen<Base>::determineSecondOrderElements4Eval(std::vector<size_t
     for (size_t e = 0; e < _hessSparsity.rows.size(); e++) {
         size_t i = _hessSparsity.rows[e];
         size_t j = _hessSparsity.cols[e];
-        if (_hessSparsity.sparsity[i].find(j) == _hessSparsity.sparsity[i].end() &&
-                _hessSparsity.sparsity[j].find(i) != _hessSparsity.sparsity[j].end()) {
+        if (!_hessSparsity.sparsity.contains(i, j) && _hessSparsity.sparsity.contains(j, i)) {
             // only the symmetric value is available
             // (it can be caused by atomic functions which may only be providing a partial hessian)
             evalRows.push_back(j);
@@ -542,27 +555,20 @@ void ModelCSourceGen<Base>::determineSecondOrderElements4Eval(std::vector<size_t
 
 template<class Base>
 void ModelCSourceGen<Base>::determineHessianSparsity() {
-    if (_hessSparsity.sparsity.size() > 0) {
+    if (_hessSparsity.sparsity.rows() > 0) {
         return;
     }
 
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
+    bool internalBool = isBitsetSparsityPreferable(n);
+
     /**
      * sparsity for the sum of the hessians of all equations
      */
-    SparsitySetType r(n); // identity matrix
-    for (size_t j = 0; j < n; j++)
-        r[j].insert(j);
-    SparsitySetType jac = _fun.ForSparseJac(n, r);
-
-    SparsitySetType s(1);
-    for (size_t i = 0; i < m; i++) {
-        s[0].insert(i);
-    }
-    _hessSparsity.sparsity = _fun.RevSparseHes(n, s, false);
-    //printSparsityPattern(_hessSparsity.sparsity, "hessian");
+    std::vector<bool> selectRange(m, true);
+    _hessSparsity.sparsity = hessianSparsityPattern(_fun, std::vector<bool>(), selectRange, internalBool);
 
     if (_hessianByEquation || _reverseTwo) {
         /**
@@ -573,73 +579,67 @@ void ModelCSourceGen<Base>::determineHessianSparsity() {
         if (_custom_hess.defined) {
             customVarsInHess.insert(_custom_hess.row.begin(), _custom_hess.row.end());
             customVarsInHess.insert(_custom_hess.col.begin(), _custom_hess.col.end());
-
-            r = SparsitySetType(n); //clear r
-            for (size_t j : customVarsInHess) {
-                r[j].insert(j);
-            }
-            jac = _fun.ForSparseJac(n, r);
         }
 
         /**
-         * Coloring
+         * Coloring (the jacobian sparsity is shared with the jacobian source generation)
          */
-        const std::vector<Color> colors = colorByRow(customVarsInHess, jac);
+        determineJacobianSparsity();
+        const std::vector<Color> colors = colorByRow(customVarsInHess, _jacSparsity.sparsity);
 
         /**
          * For each individual equation
          */
-        _hessSparsities.resize(m);
-        for (size_t i = 0; i < m; i++) {
-            _hessSparsities[i].sparsity.resize(n);
-        }
+        std::vector<std::vector<size_t> > eqRows(m), eqCols(m);
 
         for (size_t c = 0; c < colors.size(); c++) {
             const Color& color = colors[c];
 
-            // first-order
-            r = SparsitySetType(n); //clear r
+            // first-order and second-order
+            std::vector<bool> selectDomain(n, false);
             for (size_t j : color.forbiddenRows) {
-                r[j].insert(j);
+                selectDomain[j] = true;
             }
-            _fun.ForSparseJac(n, r);
 
-            // second-order
-            s[0].clear();
-            const std::set<size_t>& equations = color.rows;
-            for (size_t i : equations) {
-                s[0].insert(i);
+            selectRange.assign(m, false);
+            for (size_t i : color.rows) {
+                selectRange[i] = true;
             }
 
-            SparsitySetType sparsityc = _fun.RevSparseHes(n, s, false);
+            SparsityPattern sparsityc = hessianSparsityPattern(_fun, selectDomain, selectRange, internalBool);
 
             /**
              * Retrieve the individual hessians for each equation
              */
             const std::map<size_t, size_t>& var2Eq = color.column2Row;
             for (size_t j : color.forbiddenRows) { //used variables
-                if (sparsityc[j].size() > 0) {
+                if (sparsityc.rowSize(j) > 0) {
                     size_t i = var2Eq.at(j);
-                    _hessSparsities[i].sparsity[j].insert(sparsityc[j].begin(),
-                                                          sparsityc[j].end());
+                    for (const size_t* k = sparsityc.begin(j); k != sparsityc.end(j); ++k) {
+                        eqRows[i].push_back(j);
+                        eqCols[i].push_back(*k);
+                    }
                 }
             }
 
         }
 
+        _hessSparsities.resize(m);
         for (size_t i = 0; i < m; i++) {
             LocalSparsityInfo& hessSparsitiesi = _hessSparsities[i];
+            hessSparsitiesi.sparsity = SparsityPattern(n, n, eqRows[i], eqCols[i]);
+            std::vector<size_t>().swap(eqRows[i]); // release memory
+            std::vector<size_t>().swap(eqCols[i]);
 
             if (!_custom_hess.defined) {
-                generateSparsityIndexes(hessSparsitiesi.sparsity,
-                                        hessSparsitiesi.rows, hessSparsitiesi.cols);
+                hessSparsitiesi.sparsity.toIndexes(hessSparsitiesi.rows, hessSparsitiesi.cols);
 
             } else {
                 size_t nnz = _custom_hess.row.size();
                 for (size_t e = 0; e < nnz; e++) {
                     size_t i1 = _custom_hess.row[e];
                     size_t i2 = _custom_hess.col[e];
-                    if (hessSparsitiesi.sparsity[i1].find(i2) != hessSparsitiesi.sparsity[i1].end()) {
+                    if (hessSparsitiesi.sparsity.contains(i1, i2)) {
                         hessSparsitiesi.rows.push_back(i1);
                         hessSparsitiesi.cols.push_back(i2);
                     }
@@ -650,13 +650,25 @@ void ModelCSourceGen<Base>::determineHessianSparsity() {
     }
 
     if (!_custom_hess.defined) {
-        generateSparsityIndexes(_hessSparsity.sparsity,
-                                _hessSparsity.rows, _hessSparsity.cols);
+        _hessSparsity.sparsity.toIndexes(_hessSparsity.rows, _hessSparsity.cols);
 
     } else {
         _hessSparsity.rows = _custom_hess.row;
         _hessSparsity.cols = _custom_hess.col;
     }
+
+    selectSparsityTriangle(_hessSparsity.rows, _hessSparsity.cols, _hessTriangle);
+    sortSparsityIndexes(_hessSparsity.rows, _hessSparsity.cols, _hessLayout);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::evalSparseHessian(const std::vector<CGBase>& x,
+                                              const std::vector<CGBase>& w,
+                                              const std::vector<size_t>& rows,
+                                              const std::vector<size_t>& cols,
+                                              const std::string& coloring,
+                                              std::vector<CGBase>& hess) {
+    sparseHessianElements(_fun, x, w, _hessSparsity.sparsity, rows, cols, hess, coloring);
 }
 
 template<class Base>
@@ -664,12 +676,12 @@ void ModelCSourceGen<Base>::generateHessianSparsitySource() {
     determineHessianSparsity();
 
     generateSparsity2DSource(_name + "_" + FUNCTION_HESSIAN_SPARSITY, _hessSparsity);
-    _sources[_name + "_" + FUNCTION_HESSIAN_SPARSITY + ".c"] = _cache.str();
+    saveSource(_name + "_" + FUNCTION_HESSIAN_SPARSITY + ".c", _cache.str());
     _cache.str("");
 
     if (_hessianByEquation || _reverseTwo) {
         generateSparsity2DSource2(_name + "_" + FUNCTION_HESSIAN_SPARSITY2, _hessSparsities);
-        _sources[_name + "_" + FUNCTION_HESSIAN_SPARSITY2 + ".c"] = _cache.str();
+        saveSource(_name + "_" + FUNCTION_HESSIAN_SPARSITY2 + ".c", _cache.str());
         _cache.str("");
     }
 }
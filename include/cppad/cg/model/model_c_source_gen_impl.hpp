@@ -23,6 +23,18 @@ namespace cg {
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_FORWAD_ZERO = "forward_zero";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_PARTITION = "forward_zero_partition";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_PARTITION_SPARSITY = "forward_zero_partition_sparsity";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_INDEP_PARTITIONS = "forward_zero_indep_partitions";
+
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_FORWARD_ZERO_PARTITION_COST = "forward_zero_partition_cost";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_JACOBIAN = "jacobian";
 
@@ -74,6 +86,9 @@ const std::string ModelCSourceGen<Base>::FUNCTION_REVERSE_TWO_SPARSITY = "sparse
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_INFO = "info";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_DYNAMIC_INFO = "dynamic_info";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES = "atomic_functions";
 
@@ -91,8 +106,9 @@ VariableNameGenerator<Base>* ModelCSourceGen<Base>::createVariableNameGenerator(
 template<class Base>
 const std::map<std::string, std::string>& ModelCSourceGen<Base>::getSources(MultiThreadingType multiThreadingType,
                                                                             JobTimer* timer) {
-    if (_sources.empty()) {
+    if (!_sourcesGenerated) {
         generateSources(multiThreadingType, timer);
+        _sourcesGenerated = true;
     }
     return _sources;
 }
@@ -102,8 +118,30 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
                                             JobTimer* timer) {
     _jobTimer = timer;
 
+    CPPADCG_ASSERT_KNOWN(_fun.size_dyn_ind() == 0 || (!_forwardOne && !_reverseOne && !_reverseTwo),
+                         "Dynamic parameters are not supported by the forward one, reverse one, and reverse two modes")
+    CPPADCG_ASSERT_KNOWN(_fun.size_dyn_ind() == 0 || _relatedDepCandidates.empty(),
+                         "Dynamic parameters are not supported with loops")
+    CPPADCG_ASSERT_KNOWN(!_zeroIncremental || _relatedDepCandidates.empty(),
+                         "The incremental zero order forward mode is not supported with loops")
+
     generateLoops();
 
+    if (!_directAtomicFunctions.empty()) {
+        /**
+         * the atomic functions called through the model library come first
+         * so that their indexes are not affected by the direct calls
+         */
+        std::set<std::string> known(_atomicFunctions.begin(), _atomicFunctions.end());
+        for (const auto& it : getAtomicsInfo()) {
+            if (it.second.atom != nullptr && known.insert(it.second.atom->atomic_name()).second)
+                _atomicFunctions.push_back(it.second.atom->atomic_name());
+        }
+        std::stable_partition(_atomicFunctions.begin(), _atomicFunctions.end(), [this](const std::string& name) {
+            return _directAtomicFunctions.find(name) == _directAtomicFunctions.end();
+        });
+    }
+
     startingJob("'" + _name + "'", JobTimer::SOURCE_FOR_MODEL);
 
     if (_zero) {
@@ -111,6 +149,10 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
         _zeroEvaluated = true;
     }
 
+    if (_zeroIncremental) {
+        generateZeroIncrementalSources();
+    }
+
     if (_jacobian) {
         generateJacobianSource();
     }
@@ -152,6 +194,8 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
 
     generateInfoSource();
 
+    generateDynamicInfoSource();
+
     generateAtomicFuncNames();
 
     finishedJob();
@@ -159,7 +203,10 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
 
 template<class Base>
 void ModelCSourceGen<Base>::generateLoops() {
-    if (_relatedDepCandidates.empty()) {
+    bool automatic = _relatedDepCandidates.empty() && _autoRelatedDependents &&
+            _fun.size_dyn_ind() == 0 && !_zeroIncremental;
+
+    if (_relatedDepCandidates.empty() && !automatic) {
         return; //nothing to do
     }
 
@@ -178,13 +225,36 @@ void ModelCSourceGen<Base>::generateLoops() {
 
     std::vector<CGBase> yy = _fun.Forward(0, xx);
 
-    DependentPatternMatcher<Base> matcher(_relatedDepCandidates, yy, xx);
+    std::vector<std::set<size_t> > relatedDepCandidates;
+    if (automatic) {
+        relatedDepCandidates = DependentPatternMatcher<Base>::findRelatedDependentCandidates(yy);
+        if (relatedDepCandidates.empty()) {
+            finishedJob();
+            return; // no repeated expressions
+        }
+    }
+
+    DependentPatternMatcher<Base> matcher(automatic ? relatedDepCandidates : _relatedDepCandidates, yy, xx);
+    matcher.setThreadCount(_loopDetectionThreads);
     matcher.generateTapes(_funNoLoops, _loopTapes);
 
+    _loopOperationSavings = 0;
+    for (LoopModel<Base>* loop : _loopTapes) {
+        _loopOperationSavings += (loop->getIterationCount() - 1) * loop->getTape().size_op();
+    }
+
     finishedJob();
     if (_jobTimer != nullptr && _jobTimer->isVerbose()) {
+        if (automatic) {
+            std::cout << " related dependent candidates: " << relatedDepCandidates.size() << std::endl;
+        }
         std::cout << " equation patterns: " << matcher.getEquationPatterns().size() <<
                 "  loops: " << matcher.getLoops().size() << std::endl;
+        for (LoopModel<Base>* loop : _loopTapes) {
+            std::cout << "  loop " << loop->getLoopId() << ": " << loop->getIterationCount() << " iterations, " <<
+                    loop->getTapeDependentCount() << " equations, " << loop->getTape().size_op() << " operations" << std::endl;
+        }
+        std::cout << " estimated operations saved by loops: " << _loopOperationSavings << std::endl;
     }
 }
 
@@ -210,13 +280,41 @@ void ModelCSourceGen<Base>::generateInfoSource() {
             "   *indCount = " << nameGen->getIndependent().size() << "; // number of independent array variables\n"
             "}\n\n";
 
-    _sources[funcName + ".c"] = _cache.str();
+    saveSource(funcName + ".c", _cache.str());
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateDynamicInfoSource() {
+    std::string funcName = _name + "_" + FUNCTION_DYNAMIC_INFO;
+
+    _cache.str("");
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"unsigned long* np"});
+    _cache << " {\n"
+            "   *np = " << _fun.size_dyn_ind() << "; // number of dynamic parameters\n"
+            "}\n\n";
+
+    saveSource(funcName + ".c", _cache.str());
+}
+
+template<class Base>
+std::vector<CG<Base> > ModelCSourceGen<Base>::makeDynamicParameters(CodeHandler<Base>& handler) {
+    std::vector<CGBase> p(_fun.size_dyn_ind());
+    if (!p.empty()) {
+        handler.makeVariables(p);
+        _fun.new_dynamic(p);
+    }
+    return p;
 }
 
 template<class Base>
 void ModelCSourceGen<Base>::generateAtomicFuncNames() {
     std::string funcName = _name + "_" + FUNCTION_ATOMIC_FUNC_NAMES;
-    size_t n = _atomicFunctions.size();
+    // atomic functions called directly are not provided by the model library
+    size_t n = 0;
+    while (n < _atomicFunctions.size() &&
+           _directAtomicFunctions.find(_atomicFunctions[n]) == _directAtomicFunctions.end()) {
+        n++;
+    }
     _cache.str("");
     LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"const char*** names",
                                                                          "unsigned long* n"});
@@ -231,7 +329,7 @@ void ModelCSourceGen<Base>::generateAtomicFuncNames() {
             "   *n = " << n << ";\n"
             "}\n\n";
 
-    _sources[funcName + ".c"] = _cache.str();
+    saveSource(funcName + ".c", _cache.str());
 }
 
 template<class Base>
@@ -254,29 +352,28 @@ const std::map<size_t, AtomicUseInfo<Base> >& ModelCSourceGen<Base>::getAtomicsI
 
 template<class Base>
 std::vector<typename ModelCSourceGen<Base>::Color> ModelCSourceGen<Base>::colorByRow(const std::set<size_t>& columns,
-                                                                                     const SparsitySetType& sparsity) {
-    std::vector<Color> colors(sparsity.size()); // reserve the maximum size to avoid reallocating more space later
+                                                                                     const SparsityPattern& sparsity) {
+    std::vector<Color> colors(sparsity.rows()); // reserve the maximum size to avoid reallocating more space later
 
     /**
      * try not match the columns of each row to a color which did not have
      * those columns yet
      */
     size_t c_used = 0;
-    for (size_t i = 0; i < sparsity.size(); i++) {
-        const std::set<size_t>& row = sparsity[i];
-        if (row.size() == 0) {
+    for (size_t i = 0; i < sparsity.rows(); i++) {
+        if (sparsity.rowSize(i) == 0) {
             continue; //nothing to do
         }
 
         // consider only the columns present in the sparsity pattern
         std::set<size_t> rowReduced;
-        if (_custom_hess.defined) {
-            for (size_t j : row) {
-                if (columns.find(j) != columns.end())
-                    rowReduced.insert(j);
+        if (!columns.empty()) {
+            for (const size_t* j = sparsity.begin(i); j != sparsity.end(i); ++j) {
+                if (columns.find(*j) != columns.end())
+                    rowReduced.insert(*j);
             }
         } else {
-            rowReduced = row;
+            rowReduced.insert(sparsity.begin(i), sparsity.end(i));
         }
 
         bool newColor = true;
@@ -345,14 +442,14 @@ void ModelCSourceGen<Base>::generateGlobalDirectionalFunctionSource(const std::s
             "   };\n";
 
     _cache << "}\n";
-    _sources[model_function + ".c"] = _cache.str();
+    saveSource(model_function + ".c", _cache.str());
     _cache.str("");
 
     /**
      * Sparsity
      */
     generateSparsity1DSource2(_name + "_" + function_sparsity, elements);
-    _sources[_name + "_" + function_sparsity + ".c"] = _cache.str();
+    saveSource(_name + "_" + function_sparsity + ".c", _cache.str());
     _cache.str("");
 }
 
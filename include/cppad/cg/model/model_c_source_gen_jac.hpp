@@ -37,6 +37,9 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
         }
     }
 
+    // dynamic parameters
+    makeDynamicParameters(handler);
+
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
 
@@ -53,14 +56,19 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+    langC.setSourceStream(_sourceStream);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     langC.setGenerateFunction(_name + "_" + FUNCTION_JACOBIAN);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
+    LangCDefaultDynamicParamVarNameGenerator<Base> nameGenDyn(nameGen.get(), n);
+    VariableNameGenerator<Base>& nameGenP = _fun.size_dyn_ind() > 0 ? nameGenDyn : *nameGen;
 
-    handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    handler.generateCode(code, langC, jac, nameGenP, _atomicFunctions, jobName);
 }
 
 template<class Base>
@@ -88,7 +96,9 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(MultiThreadingType mult
     /**
      * call the appropriate method for source code generation
      */
-    if (_sparseJacobianReusesOne && _forwardOne && forwardMode) {
+    if (_sparseJacobianColoring && _loopTapes.empty()) {
+        generateSparseJacobianColoredSource(forwardMode);
+    } else if (_sparseJacobianReusesOne && _forwardOne && forwardMode) {
         generateSparseJacobianForRevSource(true, multiThreadingType);
     } else if (_sparseJacobianReusesOne && _reverseOne && !forwardMode) {
         generateSparseJacobianForRevSource(false, multiThreadingType);
@@ -119,15 +129,12 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
         }
     }
 
+    // dynamic parameters
+    makeDynamicParameters(handler);
+
     vector<CGBase> jac(_jacSparsity.rows.size());
     if (_loopTapes.empty()) {
-        //printSparsityPattern(_jacSparsity.sparsity, "jac sparsity");
-        CppAD::sparse_jacobian_work work;
-        if (forward) {
-            _fun.SparseJacobianForward(indVars, _jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols, jac, work);
-        } else {
-            _fun.SparseJacobianReverse(indVars, _jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols, jac, work);
-        }
+        evalSparseJacobian(indVars, forward, jac);
 
     } else {
         jac = prepareSparseJacobianWithLoops(handler, indVars, forward);
@@ -137,14 +144,19 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+    langC.setSourceStream(_sourceStream);
     langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_JACOBIAN);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
+    LangCDefaultDynamicParamVarNameGenerator<Base> nameGenDyn(nameGen.get(), n);
+    VariableNameGenerator<Base>& nameGenP = _fun.size_dyn_ind() > 0 ? nameGenDyn : *nameGen;
 
-    handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    handler.generateCode(code, langC, jac, nameGenP, _atomicFunctions, jobName);
 }
 
 template<class Base>
@@ -241,12 +253,222 @@ void ModelCSourceGen<Base>::generateSparseJacobianForRevSource(bool forward,
     string functionName(_cache.str());
 
     if(!_multiThreading || multiThreadingType == MultiThreadingType::NONE) {
-        _sources[functionName + ".c"] = generateSparseJacobianForRevSingleThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward);
+        saveSource(functionName + ".c", generateSparseJacobianForRevSingleThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward));
     } else {
-        _sources[functionName + ".c"] = generateSparseJacobianForRevMultiThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward, multiThreadingType);
+        saveSource(functionName + ".c", generateSparseJacobianForRevMultiThreadSource(functionName, jacInfo, maxCompressedSize, functionRevFor, revForSuffix, forward, multiThreadingType));
+    }
+
+    _cache.str("");
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::generateSparseJacobianColoredSource(bool forward) {
+    using std::vector;
+
+    size_t m = _fun.Range();
+    size_t n = _fun.Domain();
+    size_t nnz = _jacSparsity.rows.size();
+
+    /**
+     * Coloring of the Jacobian columns (forward mode) or rows (reverse mode)
+     * requested by the user.
+     * The full sparsity pattern must be considered since all the non-zero
+     * elements contribute to the compressed Jacobian.
+     */
+    const SparsityPattern pattern = forward ? _jacSparsity.sparsity.transpose() : _jacSparsity.sparsity;
+    const vector<size_t>& major = forward ? _jacSparsity.cols : _jacSparsity.rows;
+    const vector<size_t>& minor = forward ? _jacSparsity.rows : _jacSparsity.cols;
+
+    vector<bool> requested(pattern.rows(), false);
+    for (size_t e = 0; e < nnz; e++) {
+        requested[major[e]] = true;
+    }
+
+    vector<size_t> patternRows, patternCols;
+    for (size_t i = 0; i < pattern.rows(); i++) {
+        if (requested[i]) {
+            for (const size_t* j = pattern.begin(i); j != pattern.end(i); ++j) {
+                patternRows.push_back(i);
+                patternCols.push_back(*j);
+            }
+        }
+    }
+
+    const vector<Color> colors = colorByRow(std::set<size_t>(),
+                                            SparsityPattern(pattern.rows(), pattern.cols(), patternRows, patternCols));
+
+    // majors without any non-zero element are not colored
+    const size_t noColor = colors.size();
+    vector<size_t> index2Color(pattern.rows(), noColor);
+    for (size_t c = 0; c < colors.size(); c++) {
+        for (size_t i : colors[c].rows) {
+            index2Color[i] = c;
+        }
+    }
+
+    /**
+     * Recovery tables: the elements determined by each color
+     * (the requested elements which are not in the sparsity pattern are
+     *  always zero)
+     */
+    vector<vector<size_t> > colorElements(colors.size());
+    vector<size_t> zeroElements;
+    for (size_t e = 0; e < nnz; e++) {
+        size_t c = index2Color[major[e]];
+        if (c == noColor || !pattern.contains(major[e], minor[e])) {
+            zeroElements.push_back(e);
+        } else {
+            colorElements[c].push_back(e);
+        }
+    }
+
+    /**
+     * Generate one function for each color
+     */
+    const std::string jobName = forward ? "sparse Jacobian (forward colors)" : "sparse Jacobian (reverse colors)";
+    startingJob("'" + jobName + "'", JobTimer::SOURCE_GENERATION);
+
+    std::string functionName = _name + "_" + FUNCTION_SPARSE_JACOBIAN;
+
+    for (size_t c = 0; c < colors.size(); c++) {
+        if (colorElements[c].empty())
+            continue; // only structural zeros were requested for this color
+
+        _cache.str("");
+        _cache << jobName << " color " << c;
+        const std::string subJobName = _cache.str();
+
+        startingJob("'" + subJobName + "'", JobTimer::GRAPH);
+
+        CodeHandler<Base> handler;
+        handler.setJobTimer(_jobTimer);
+
+        vector<CGBase> indVars(n);
+        handler.makeVariables(indVars);
+        if (_x.size() > 0) {
+            for (size_t i = 0; i < n; i++) {
+                indVars[i].setValue(_x[i]);
+            }
+        }
+
+        // dynamic parameters
+        makeDynamicParameters(handler);
+
+        _fun.Forward(0, indVars);
+
+        vector<CGBase> compressedJac;
+        if (forward) {
+            vector<CGBase> dx(n, Base(0));
+            for (size_t j : colors[c].rows) {
+                dx[j] = Base(1);
+            }
+            compressedJac = _fun.Forward(1, dx);
+        } else {
+            vector<CGBase> w(m, Base(0));
+            for (size_t i : colors[c].rows) {
+                w[i] = Base(1);
+            }
+            compressedJac = _fun.Reverse(1, w);
+        }
+
+        vector<CGBase> jacColor(colorElements[c].size());
+        for (size_t k = 0; k < jacColor.size(); k++) {
+            jacColor[k] = compressedJac[minor[colorElements[c][k]]];
+        }
+
+        finishedJob();
+
+        LanguageC<Base> langC(_baseTypeName);
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+        langC.setSourceStream(_sourceStream);
+        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setDirectAtomicFunctions(_directAtomicFunctions);
+        _cache.str("");
+        _cache << functionName << "_color" << c;
+        langC.setGenerateFunction(_cache.str());
+
+        std::ostringstream code;
+        std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
+        LangCDefaultDynamicParamVarNameGenerator<Base> nameGenDyn(nameGen.get(), n);
+        VariableNameGenerator<Base>& nameGenP = _fun.size_dyn_ind() > 0 ? nameGenDyn : *nameGen;
+
+        handler.generateCode(code, langC, jacColor, nameGenP, _atomicFunctions, subJobName);
+    }
+
+    finishedJob();
+
+    /**
+     * The sparse Jacobian calls the function of each color and places the
+     * compressed values in the Jacobian using the recovery tables
+     */
+    LanguageC<Base> langC(_baseTypeName);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+    std::vector<std::string> argsDcl2 = langC.generateDefaultFunctionArgumentsDcl2();
+
+    size_t maxCompressedSize = 0;
+    for (const auto& els : colorElements) {
+        maxCompressedSize = std::max<size_t>(maxCompressedSize, els.size());
     }
 
     _cache.str("");
+    _cache << "#include <stdlib.h>\n"
+              "\n"
+           << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+    for (size_t c = 0; c < colors.size(); c++) {
+        if (!colorElements[c].empty())
+            _cache << "void " << functionName << "_color" << c << "(" << argsDcl << ");\n";
+    }
+    _cache << "\n";
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", functionName, argsDcl2);
+    _cache << " {\n";
+    if (nnz > 0) {
+        _cache << "   " << _baseTypeName << " * jac = out[0];\n"
+                  "   unsigned long e;\n";
+    }
+
+    if (!zeroElements.empty()) {
+        // structural zeros requested by the user
+        _cache << "\n   ";
+        LanguageC<Base>::printStaticIndexArray(_cache, "zeros", zeroElements);
+        _cache << "   for(e = 0; e < " << zeroElements.size() << "; e++) jac[zeros[e]] = 0;\n";
+    }
+
+    if (maxCompressedSize > 0) {
+        vector<size_t> colorStart(colors.size() + 1, 0);
+        vector<size_t> location;
+        location.reserve(nnz);
+        for (size_t c = 0; c < colors.size(); c++) {
+            location.insert(location.end(), colorElements[c].begin(), colorElements[c].end());
+            colorStart[c + 1] = location.size();
+        }
+
+        _cache << "\n   ";
+        LanguageC<Base>::printStaticIndexArray(_cache, "location", location);
+        _cache << "   " << _baseTypeName << " * outLocal[1];\n"
+                  "   " << _baseTypeName << " compressed[" << maxCompressedSize << "];\n"
+                  "\n"
+                  "   outLocal[0] = compressed;\n";
+
+        langC.setArgumentOut("outLocal");
+        std::string argsLocal = langC.generateDefaultFunctionArguments();
+
+        for (size_t c = 0; c < colors.size(); c++) {
+            if (colorElements[c].empty())
+                continue; // only structural zeros were requested for this color
+
+            _cache << "\n"
+                      "   " << functionName << "_color" << c << "(" << argsLocal << ");\n"
+                      "   for(e = " << colorStart[c] << "; e < " << colorStart[c + 1] << "; e++) "
+                      "jac[location[e]] = compressed[e - " << colorStart[c] << "];\n";
+        }
+    }
+
+    _cache << "}\n";
+
+    saveSource(functionName + ".c", _cache.str());
+    _cache.str("");
 }
 
 template<class Base>
@@ -459,22 +681,31 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
 
 template<class Base>
 void ModelCSourceGen<Base>::determineJacobianSparsity() {
-    if (_jacSparsity.sparsity.size() > 0) {
+    if (_jacSparsity.sparsity.rows() > 0) {
         return;
     }
 
     /**
      * Determine the sparsity pattern
      */
-    _jacSparsity.sparsity = jacobianSparsitySet<SparsitySetType, CGBase> (_fun);
+    _jacSparsity.sparsity = jacobianSparsityPattern(_fun);
 
     if (!_custom_jac.defined) {
-        generateSparsityIndexes(_jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols);
+        _jacSparsity.sparsity.toIndexes(_jacSparsity.rows, _jacSparsity.cols);
 
     } else {
         _jacSparsity.rows = _custom_jac.row;
         _jacSparsity.cols = _custom_jac.col;
     }
+
+    sortSparsityIndexes(_jacSparsity.rows, _jacSparsity.cols, _jacLayout);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::evalSparseJacobian(const std::vector<CGBase>& x,
+                                               bool forward,
+                                               std::vector<CGBase>& jac) {
+    sparseJacobianElements(_fun, x, _jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols, jac, forward);
 }
 
 template<class Base>
@@ -482,7 +713,7 @@ void ModelCSourceGen<Base>::generateJacobianSparsitySource() {
     determineJacobianSparsity();
 
     generateSparsity2DSource(_name + "_" + FUNCTION_JACOBIAN_SPARSITY, _jacSparsity);
-    _sources[_name + "_" + FUNCTION_JACOBIAN_SPARSITY + ".c"] = _cache.str();
+    saveSource(_name + "_" + FUNCTION_JACOBIAN_SPARSITY + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -120,8 +120,11 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
 
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+        langC.setSourceStream(_sourceStream);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setDirectAtomicFunctions(_directAtomicFunctions);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
         langC.setGenerateFunction(_cache.str());
@@ -163,8 +166,7 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
 
     vector<CGBase> jacFlat(_jacSparsity.rows.size());
 
-    CppAD::sparse_jacobian_work work; // temporary structure for CPPAD
-    _fun.SparseJacobianReverse(x, _jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols, jacFlat, work);
+    evalSparseJacobian(x, false, jacFlat);
 
     /**
      * organize results
@@ -208,8 +210,11 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
 
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+        langC.setSourceStream(_sourceStream);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setDirectAtomicFunctions(_directAtomicFunctions);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
         langC.setGenerateFunction(_cache.str());
@@ -319,7 +324,7 @@ void ModelCSourceGen<Base>::generateReverseOneSources() {
             "   free(pyPos);\n"
             "   return 0;\n"
             "}\n";
-    _sources[model_function + ".c"] = _cache.str();
+    saveSource(model_function + ".c", _cache.str());
     _cache.str("");
 }
 
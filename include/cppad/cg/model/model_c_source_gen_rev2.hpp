@@ -128,8 +128,11 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
 
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+        langC.setSourceStream(_sourceStream);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setDirectAtomicFunctions(_directAtomicFunctions);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -192,11 +195,9 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
 
     vector<CGBase> hessFlat(evalRows.size());
 
-    CppAD::sparse_hessian_work work; // temporary structure for CPPAD
     // "cppad.symmetric" may have missing values for functions using atomic 
     // functions which only provide half of the elements, but there is none here
-    work.color_method = "cppad.symmetric";
-    _fun.SparseHessian(tx0, py, _hessSparsity.sparsity, evalRows, evalCols, hessFlat, work);
+    evalSparseHessian(tx0, py, evalRows, evalCols, "cppad.symmetric", hessFlat);
 
     std::map<size_t, vector<CGBase> > hess;
     for (const auto& itJ1 : elements) {
@@ -231,8 +232,11 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
 
         LanguageC<Base> langC(_baseTypeName);
         langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+        langC.setSourceStream(_sourceStream);
         langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
         langC.setParameterPrecision(_parameterPrecision);
+        langC.setDirectAtomicFunctions(_directAtomicFunctions);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -363,7 +367,7 @@ void ModelCSourceGen<Base>::generateReverseTwoSources() {
             "   return 0;\n"
             "};\n";
 
-    _sources[model_function + ".c"] = _cache.str();
+    saveSource(model_function + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -42,6 +42,7 @@ public:
     static const std::string FUNCTION_GETTHREADPOOLGUIDEDMAXGROUPWORK;
     static const std::string FUNCTION_SETTHREADPOOLNUMBEROFTIMEMEAS;
     static const std::string FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS;
+    static const std::string FUNCTION_COMPILEFLAGS;
     static const unsigned long API_VERSION;
 protected:
     static const std::string CONST;
@@ -64,6 +65,21 @@ protected:
      * Parallelization can be disabled locally for each model.
      */
     MultiThreadingType _multiThreading;
+    /**
+     * Whether or not models in this library which are used as atomic
+     * functions by other models in this library are called directly
+     */
+    bool _directAtomicModelCalls;
+    /**
+     * Whether or not the atomic functions which are called directly have
+     * already been determined
+     */
+    bool _directAtomicsDetermined;
+    /**
+     * The models which are called directly as atomic functions by other
+     * models in this library
+     */
+    std::set<std::string> _directAtomicCallees;
     /**
      * temporary stream to generate source code
      */
@@ -78,7 +94,9 @@ public:
      *              this object)
      */
     inline ModelLibraryCSourceGen(ModelCSourceGen<Base>& model):
-        _multiThreading(MultiThreadingType::NONE) {
+        _multiThreading(MultiThreadingType::NONE),
+        _directAtomicModelCalls(true),
+        _directAtomicsDetermined(false) {
         CPPADCG_ASSERT_KNOWN(_models.find(model.getName()) == _models.end(),
                              "Another model with the same name was already registered")
 
@@ -112,12 +130,29 @@ public:
         _models[model.getName()] = &model;
 
         _libSources.clear(); // must regenerate library sources again
+        _directAtomicsDetermined = false;
     }
 
     inline const std::map<std::string, ModelCSourceGen<Base>*>& getModels() const {
         return _models;
     }
 
+    /**
+     * Provides the source file streams used by the models to write their
+     * sources instead of keeping them in memory.
+     *
+     * @return the distinct source file streams of the models
+     */
+    inline std::set<SourceFileStream*> getSourceStreams() const {
+        std::set<SourceFileStream*> streams;
+        for (const auto& p : _models) {
+            SourceFileStream* stream = p.second->getSourceStream();
+            if (stream != nullptr)
+                streams.insert(stream);
+        }
+        return streams;
+    }
+
     void addCustomFunctionSource(const std::string& filename, const std::string& source) {
         CPPADCG_ASSERT_KNOWN(!filename.empty(), "The filename name cannot be empty")
 
@@ -158,8 +193,43 @@ public:
         _multiThreading = multiThreading;
     }
 
+    /**
+     * Whether or not models in this library which are used as atomic
+     * functions by other models in this library are called directly from
+     * the generated source code.
+     *
+     * @return true if atomic models in the same library are called directly
+     */
+    inline bool isDirectAtomicModelCalls() const {
+        return _directAtomicModelCalls;
+    }
+
+    /**
+     * Defines whether or not models in this library which are used as
+     * atomic functions by other models in this library are called directly
+     * from the generated source code.
+     * Direct calls avoid the dispatch through the atomic function structure
+     * and the external function wrappers in the model library.
+     * Such atomic functions do not need to be provided to the loaded models
+     * (e.g. with GenericModel::addExternalModel()).
+     * A model is only called directly if all of its own atomic functions
+     * are also called directly, it does not use dynamic parameters,
+     * it is always used with its own domain and range sizes, and it
+     * creates all the evaluation modes (forward zero, forward one, reverse
+     * one, and reverse two) needed by the models which use it.
+     * This must be defined before the sources are generated.
+     *
+     * @param direct true to call atomic models in the same library directly
+     */
+    inline void setDirectAtomicModelCalls(bool direct) {
+        _directAtomicModelCalls = direct;
+        _directAtomicsDetermined = false;
+    }
+
     /**
      * Saves the generated C source code into several files.
+     * The source files written to the source file streams of the models
+     * are also copied.
      * 
      * @param sourcesFolder A directory path where the files should be
      *                      created (any existing files with the same names
@@ -167,6 +237,16 @@ public:
      */
     void saveSources(const std::string& sourcesFolder);
 
+    /**
+     * Creates the source of the function which provides the flags used to
+     * compile each translation unit of the library.
+     *
+     * @param unitFlags maps the translation unit names to their compile
+     *                  flags
+     * @return the source file content
+     */
+    static std::string createCompileFlagsSource(const std::map<std::string, std::vector<std::string>>& unitFlags);
+
     /**
      * Provides the sources for the model library level.
      * These sources include, for instance, functions to retrieve the list of
@@ -186,6 +266,30 @@ protected:
 
     virtual void generateThreadPoolSources(std::map<std::string, std::string>& sources);
 
+    /**
+     * Determines which atomic functions are models in this library that
+     * can be called directly and informs each model.
+     * It must be called before the model sources are generated.
+     */
+    virtual void determineDirectAtomicCalls();
+
+    /**
+     * Generates the functions used to call a model directly as an atomic
+     * function from other models in this library.
+     */
+    virtual void generateDirectAtomicSources(std::map<std::string, std::string>& sources);
+
+    /**
+     * Generates the function which provides the flags used to compile each
+     * translation unit of the library.
+     *
+     * @param unitFlags maps the translation unit names to their compile
+     *                  flags
+     * @param sources where the generated source is added
+     */
+    virtual void generateCompileFlagsSource(const std::map<std::string, std::vector<std::string>>& unitFlags,
+                                            std::map<std::string, std::string>& sources);
+
     static void saveSources(const std::string& sourcesFolder,
                             const std::map<std::string, std::string>& sources);
 
@@ -68,6 +68,9 @@ const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLNUMBEROFTI
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS = "cppad_cg_thpool_get_number_of_time_meas";
 
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_COMPILEFLAGS = "cppad_cg_compile_flags";
+
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::CONST = "const";
 
@@ -77,11 +80,20 @@ void ModelLibraryCSourceGen<Base>::saveSources(const std::string& sourcesFolder)
     // create the folder if it does not exist
     system::createFolder(sourcesFolder);
 
+    determineDirectAtomicCalls();
+
     // save/generate model sources
     for (const auto& it : _models) {
         saveSources(sourcesFolder, it.second->getSources());
     }
 
+    // model sources which were written to a source file stream
+    for (SourceFileStream* stream : getSourceStreams()) {
+        for (const auto& f : stream->getFiles()) {
+            saveSources(sourcesFolder, {{f.first, stream->read(f.first)}});
+        }
+    }
+
     // save/generate library sources
     saveSources(sourcesFolder, getLibrarySources());
 
@@ -105,10 +117,13 @@ void ModelLibraryCSourceGen<Base>::saveSources(const std::string& sourcesFolder,
 template<class Base>
 const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getLibrarySources() {
     if (_libSources.empty()) {
+        determineDirectAtomicCalls();
+
         generateVersionSource(_libSources);
         generateModelsSource(_libSources);
         generateOnCloseSource(_libSources);
         generateThreadPoolSources(_libSources);
+        generateDirectAtomicSources(_libSources);
 
         if(_multiThreading != MultiThreadingType::NONE) {
             bool usingMultiThreading = false;
@@ -165,6 +180,56 @@ void ModelLibraryCSourceGen<Base>::generateModelsSource(std::map<std::string, st
     sources[FUNCTION_MODELS + ".c"] = _cache.str();
 }
 
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateCompileFlagsSource(const std::map<std::string, std::vector<std::string>>& unitFlags,
+                                                              std::map<std::string, std::string>& sources) {
+    sources[FUNCTION_COMPILEFLAGS + ".c"] = createCompileFlagsSource(unitFlags);
+}
+
+template<class Base>
+std::string ModelLibraryCSourceGen<Base>::createCompileFlagsSource(const std::map<std::string, std::vector<std::string>>& unitFlags) {
+    std::ostringstream code;
+
+    auto printString = [&code](const std::string& str) {
+        code << "\"";
+        for (char c : str) {
+            if (c == '"' || c == '\\')
+                code << '\\';
+            code << c;
+        }
+        code << "\"";
+    };
+
+    LanguageC<Base>::printFunctionDeclaration(code, "void", FUNCTION_COMPILEFLAGS, {"char const *const** units",
+                                                                                    "char const *const** flags",
+                                                                                    "int* count"});
+    code << " {\n"
+            "   static const char* const unitNames[] = {\n";
+    for (auto it = unitFlags.begin(); it != unitFlags.end(); ++it) {
+        if (it != unitFlags.begin()) {
+            code << ",\n";
+        }
+        code << "      ";
+        printString(it->first);
+    }
+    code << "};\n"
+            "   static const char* const unitFlags[] = {\n";
+    for (auto it = unitFlags.begin(); it != unitFlags.end(); ++it) {
+        if (it != unitFlags.begin()) {
+            code << ",\n";
+        }
+        code << "      ";
+        printString(implode(it->second, " "));
+    }
+    code << "};\n"
+            "   *units = unitNames;\n"
+            "   *flags = unitFlags;\n"
+            "   *count = " << unitFlags.size() << ";\n"
+            "}\n\n";
+
+    return code.str();
+}
+
 template<class Base>
 void ModelLibraryCSourceGen<Base>::generateOnCloseSource(std::map<std::string, std::string>& sources) {
     bool pthreads = false;
@@ -360,7 +425,279 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
     }
 }
 
+template<class Base>
+void ModelLibraryCSourceGen<Base>::determineDirectAtomicCalls() {
+    if (_directAtomicsDetermined)
+        return;
+    _directAtomicsDetermined = true;
+    _directAtomicCallees.clear();
+
+    if (!_directAtomicModelCalls || _models.size() < 2)
+        return;
+
+    /**
+     * the atomic functions used by each model and the sizes used in those calls
+     */
+    std::map<std::string, std::set<std::string> > used;
+    std::map<std::string, std::set<std::pair<size_t, size_t> > > usedSizes;
+    for (const auto& it : _models) {
+        std::set<std::string>& names = used[it.first];
+        for (const auto& itAtom : it.second->getAtomicsInfo()) {
+            const AtomicUseInfo<Base>& info = itAtom.second;
+            if (info.atom == nullptr)
+                continue;
+            const std::string& name = info.atom->atomic_name();
+            names.insert(name);
+            usedSizes[name].insert(info.sizes.begin(), info.sizes.end());
+        }
+    }
+
+    /**
+     * the evaluation modes which the models need from the atomic functions
+     * they use (the zero order is always needed)
+     */
+    std::set<std::string> needForwardOne, needReverseOne, needReverseTwo;
+    for (const auto& it : _models) {
+        const ModelCSourceGen<Base>& model = *it.second;
+        bool firstOrder = model._jacobian || model._sparseJacobian; // forward or reverse mode
+        bool secondOrder = model._hessian || model._sparseHessian || model._reverseTwo;
+        for (const std::string& name : used[it.first]) {
+            if (model._forwardOne || firstOrder || secondOrder)
+                needForwardOne.insert(name);
+            if (model._reverseOne || firstOrder)
+                needReverseOne.insert(name);
+            if (secondOrder)
+                needReverseTwo.insert(name);
+        }
+    }
+
+    /**
+     * models which can be called directly
+     */
+    std::set<std::string> candidates;
+    for (const auto& it : _models) {
+        const std::string& name = it.first;
+        ModelCSourceGen<Base>& model = *it.second;
+        if (usedSizes.find(name) == usedSizes.end())
+            continue; // not used by any model
+        if (used[name].count(name) > 0)
+            continue; // recursive
+        if (model._fun.size_dyn_ind() > 0)
+            continue;
+        if (model._sourcesGenerated && !used[name].empty())
+            continue; // already generated with the atomic function structure
+        if (!model._zero ||
+            (!model._forwardOne && needForwardOne.count(name) > 0) ||
+            (!model._reverseOne && needReverseOne.count(name) > 0) ||
+            (!model._reverseTwo && needReverseTwo.count(name) > 0))
+            continue; // does not provide all the modes used by the other models
+
+        bool sameSizes = true;
+        for (const auto& nm : usedSizes[name]) {
+            if (nm.first != model._fun.Domain() || nm.second != model._fun.Range()) {
+                sameSizes = false;
+                break;
+            }
+        }
+        if (sameSizes)
+            candidates.insert(name);
+    }
+
+    // a model can only be called directly if its own atomic functions are also called directly
+    std::set<std::string> callable;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const std::string& name : candidates) {
+            if (callable.find(name) != callable.end())
+                continue;
+            const std::set<std::string>& names = used[name];
+            if (std::includes(callable.begin(), callable.end(), names.begin(), names.end())) {
+                callable.insert(name);
+                changed = true;
+            }
+        }
+    }
+
+    for (const auto& it : _models) {
+        ModelCSourceGen<Base>& model = *it.second;
+        if (model._sourcesGenerated)
+            continue; // too late
+
+        std::set<std::string> direct;
+        for (const std::string& name : used[it.first]) {
+            if (callable.find(name) != callable.end())
+                direct.insert(name);
+        }
+        model.setDirectAtomicFunctions(direct);
+        _directAtomicCallees.insert(direct.begin(), direct.end());
+    }
+}
+
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateDirectAtomicSources(std::map<std::string, std::string>& sources) {
+    using ModelSrc = ModelCSourceGen<Base>;
+
+    for (const std::string& name : _directAtomicCallees) {
+        ModelSrc& model = *_models.at(name);
+        const std::string& baseType = model._baseTypeName;
+        size_t n = model._fun.Domain();
+        size_t m = model._fun.Range();
+        size_t nCompressed = std::max<size_t>(std::max(n, m), 1);
+
+        LanguageC<Base> langC(baseType);
+        std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+        std::string atomicArg = langC.generateArgumentAtomicDcl();
+
+        _cache.str("");
+        _cache << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+        if (model._zero) {
+            _cache << "void " << name << "_" << ModelSrc::FUNCTION_FORWAD_ZERO << "(" << argsDcl << ");\n";
+        }
+        if (model._forwardOne) {
+            _cache << "int " << name << "_" << ModelSrc::FUNCTION_SPARSE_FORWARD_ONE << "(unsigned long pos, " << argsDcl << ");\n"
+                    "void " << name << "_" << ModelSrc::FUNCTION_FORWARD_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+        }
+        if (model._reverseOne) {
+            _cache << "int " << name << "_" << ModelSrc::FUNCTION_SPARSE_REVERSE_ONE << "(unsigned long pos, " << argsDcl << ");\n"
+                    "void " << name << "_" << ModelSrc::FUNCTION_REVERSE_ONE_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+        }
+        if (model._reverseTwo) {
+            _cache << "int " << name << "_" << ModelSrc::FUNCTION_SPARSE_REVERSE_TWO << "(unsigned long pos, " << argsDcl << ");\n"
+                    "void " << name << "_" << ModelSrc::FUNCTION_REVERSE_TWO_SPARSITY << "(unsigned long pos, unsigned long const** elements, unsigned long* nnz);\n";
+        }
+        _cache << "\n";
+
+        /**
+         * forward mode
+         */
+        LanguageC<Base>::printFunctionDeclaration(_cache, "int", LanguageC<Base>::getDirectAtomicForwardName(name),
+                                                  {"int q", "int p", "const Array tx[]", "Array* ty", atomicArg});
+        _cache << " {\n"
+                "   unsigned long e, ePos, j, nnz;\n"
+                "   unsigned long const* pos;\n"
+                "   " << baseType << " const* in[2];\n"
+                "   " << baseType << "* out[1];\n"
+                "   " << baseType << " compressed[" << nCompressed << "];\n"
+                "   " << baseType << " const* x = (" << baseType << " const*) tx[0].data;\n"
+                "   " << baseType << "* y = (" << baseType << "*) ty->data;\n"
+                "   " << baseType << " const* tx1;\n"
+                "\n"
+                "   in[0] = x;\n";
+        if (model._zero) {
+            _cache << "   if (p == 0) {\n"
+                    "      out[0] = y;\n"
+                    "      " << name << "_" << ModelSrc::FUNCTION_FORWAD_ZERO << "(in, out, atomicFun);\n"
+                    "      return 1;\n"
+                    "   }\n";
+        }
+        if (model._forwardOne) {
+            _cache << "   if (p == 1) {\n"
+                    "      tx1 = (" << baseType << " const*) tx[1].data;\n"
+                    "      for (j = 0; j < " << m << "; j++)\n"
+                    "         y[j] = 0;\n"
+                    "      out[0] = compressed;\n"
+                    "      for (e = 0; e < tx[1].nnz; e++) {\n"
+                    "         j = tx[1].idx[e];\n"
+                    "         " << name << "_" << ModelSrc::FUNCTION_FORWARD_ONE_SPARSITY << "(j, &pos, &nnz);\n"
+                    "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                    "            compressed[ePos] = 0;\n"
+                    "         in[1] = &tx1[e];\n"
+                    "         if (" << name << "_" << ModelSrc::FUNCTION_SPARSE_FORWARD_ONE << "(j, in, out, atomicFun) != 0)\n"
+                    "            return 0;\n"
+                    "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                    "            y[pos[ePos]] += compressed[ePos];\n"
+                    "      }\n"
+                    "      return 1;\n"
+                    "   }\n";
+        }
+        _cache << "   return 0;\n"
+                "}\n\n";
+
+        /**
+         * reverse mode
+         */
+        LanguageC<Base>::printFunctionDeclaration(_cache, "int", LanguageC<Base>::getDirectAtomicReverseName(name),
+                                                  {"int p", "const Array tx[]", "Array* px", "const Array py[]", atomicArg});
+        if (!model._reverseOne && !model._reverseTwo) {
+            _cache << " {\n"
+                    "   return 0;\n"
+                    "}\n\n";
+            sources[name + "_atomic.c"] = _cache.str();
+            continue;
+        }
+        _cache << " {\n"
+                "   unsigned long e, ePos, j, nnz;\n"
+                "   unsigned long const* pos;\n"
+                "   " << baseType << " const* in[3];\n"
+                "   " << baseType << "* out[1];\n"
+                "   " << baseType << " compressed[" << nCompressed << "];\n"
+                "   " << baseType << " const* x = (" << baseType << " const*) tx[0].data;\n"
+                "   " << baseType << "* pxb = (" << baseType << "*) px->data;\n"
+                "   " << baseType << " const* v;\n"
+                "   unsigned long vNnz;\n"
+                "   unsigned long const* vIdx;\n"
+                "\n"
+                "   in[0] = x;\n"
+                "   out[0] = compressed;\n";
+        if (model._reverseOne) {
+            _cache << "   if (p == 0) {\n"
+                    "      v = (" << baseType << " const*) py[0].data;\n"
+                    "      vNnz = py[0].nnz;\n"
+                    "      vIdx = py[0].idx;\n"
+                    "   }\n";
+        }
+        if (model._reverseTwo) {
+            _cache << "   if (p == 1) {\n"
+                    "      v = (" << baseType << " const*) tx[1].data;\n"
+                    "      vNnz = tx[1].nnz;\n"
+                    "      vIdx = tx[1].idx;\n"
+                    "      in[2] = (" << baseType << " const*) py[1].data;\n"
+                    "   }\n";
+        }
+        _cache << "   if (";
+        if (model._reverseOne && model._reverseTwo)
+            _cache << "p != 0 && p != 1";
+        else if (model._reverseOne)
+            _cache << "p != 0";
+        else
+            _cache << "p != 1";
+        _cache << ")\n"
+                "      return 0;\n"
+                "\n"
+                "   for (j = 0; j < " << n << "; j++)\n"
+                "      pxb[j] = 0;\n"
+                "   for (e = 0; e < vNnz; e++) {\n"
+                "      j = vIdx[e];\n";
+        auto printReverse = [&](const std::string& sparsity, const std::string& function) {
+            _cache << "         " << name << "_" << sparsity << "(j, &pos, &nnz);\n"
+                    "         for (ePos = 0; ePos < nnz; ePos++)\n"
+                    "            compressed[ePos] = 0;\n"
+                    "         in[1] = &v[e];\n"
+                    "         if (" << name << "_" << function << "(j, in, out, atomicFun) != 0)\n"
+                    "            return 0;\n";
+        };
+        if (model._reverseOne) {
+            _cache << "      if (p == 0) {\n";
+            printReverse(ModelSrc::FUNCTION_REVERSE_ONE_SPARSITY, ModelSrc::FUNCTION_SPARSE_REVERSE_ONE);
+            _cache << "      }\n";
+        }
+        if (model._reverseTwo) {
+            _cache << "      if (p == 1) {\n";
+            printReverse(ModelSrc::FUNCTION_REVERSE_TWO_SPARSITY, ModelSrc::FUNCTION_SPARSE_REVERSE_TWO);
+            _cache << "      }\n";
+        }
+        _cache << "      for (ePos = 0; ePos < nnz; ePos++)\n"
+                "         pxb[pos[ePos]] += compressed[ePos];\n"
+                "   }\n"
+                "   return 1;\n"
+                "}\n\n";
+
+        sources[name + "_atomic.c"] = _cache.str();
+    }
+}
+
 } // END cg namespace
 } // END CppAD namespace
 
-#endif
\ No newline at end of file
+#endif
@@ -43,9 +43,184 @@ protected:
     }
 
     inline const std::map<std::string, std::string>& getSources(ModelCSourceGen<Base>& model) {
+        modelLibraryHelper_->determineDirectAtomicCalls();
         return model.getSources(modelLibraryHelper_->getMultiThreading(), modelLibraryHelper_);
     }
 
+    /**
+     * Provides the source files of the models which were written to source
+     * file streams instead of being kept in memory.
+     * The source files are loaded one at a time.
+     *
+     * @param process called with each source file (maps the file name to
+     *                its content)
+     */
+    template<class Processor>
+    inline void processStreamedSources(Processor process) {
+        for (SourceFileStream* stream : modelLibraryHelper_->getSourceStreams()) {
+            for (const auto& f : stream->getFiles()) {
+                std::map<std::string, std::string> sources;
+                sources[f.first] = stream->read(f.first);
+                process(sources);
+            }
+        }
+    }
+
+    /**
+     * Compiles the source files written to the source file streams of the
+     * models in a background thread while the model sources are still
+     * being generated.
+     * The compiler is only used by one thread at a time: other compilations
+     * must lock the compiler with lock().
+     * Nothing is done if there are no source file streams or if the
+     * compiler does not compile source files from disk.
+     */
+    class StreamedSourcesCompiler {
+    private:
+        std::vector<SourceFileStream*> streams_;
+        std::vector<std::function<void(const std::string&)>> listeners_;
+        AbstractCCompiler<Base>* compiler_;
+        bool posIndepCode_;
+        std::mutex compilerMutex_;
+        std::mutex queueMutex_;
+        std::condition_variable queueChanged_;
+        std::deque<std::pair<SourceFileStream*, std::string>> queue_;
+        bool finished_;
+        std::exception_ptr error_;
+        std::thread thread_;
+    public:
+
+        inline StreamedSourcesCompiler(ModelLibraryCSourceGen<Base>& modelLibraryHelper,
+                                       CCompiler<Base>& compiler,
+                                       bool posIndepCode) :
+            compiler_(dynamic_cast<AbstractCCompiler<Base>*>(&compiler)),
+            posIndepCode_(posIndepCode),
+            finished_(false) {
+            if (compiler_ == nullptr)
+                return;
+
+            for (SourceFileStream* stream : modelLibraryHelper.getSourceStreams()) {
+                streams_.push_back(stream);
+                listeners_.push_back(stream->getWriteListener());
+
+                std::function<void(const std::string&)> previous = listeners_.back();
+                stream->setWriteListener([this, stream, previous](const std::string& name) {
+                    if (previous)
+                        previous(name);
+                    std::lock_guard<std::mutex> lock(queueMutex_);
+                    queue_.emplace_back(stream, name);
+                    queueChanged_.notify_one();
+                });
+            }
+
+            if (!streams_.empty())
+                thread_ = std::thread(&StreamedSourcesCompiler::run, this);
+        }
+
+        StreamedSourcesCompiler(const StreamedSourcesCompiler&) = delete;
+        StreamedSourcesCompiler& operator=(const StreamedSourcesCompiler&) = delete;
+
+        /**
+         * Prevents the background thread from using the compiler.
+         */
+        inline std::unique_lock<std::mutex> lock() {
+            return std::unique_lock<std::mutex>(compilerMutex_);
+        }
+
+        /**
+         * Waits for the compilation of all the source files written so far.
+         *
+         * @throws CGException if the compilation of a source file failed
+         */
+        inline void finish() {
+            stop();
+            if (error_)
+                std::rethrow_exception(error_);
+        }
+
+        inline ~StreamedSourcesCompiler() {
+            stop();
+        }
+
+    private:
+
+        inline void stop() {
+            if (thread_.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex_);
+                    finished_ = true;
+                    queueChanged_.notify_one();
+                }
+                thread_.join();
+            }
+
+            for (size_t i = 0; i < streams_.size(); i++) {
+                streams_[i]->setWriteListener(listeners_[i]);
+            }
+            streams_.clear();
+            listeners_.clear();
+        }
+
+        inline void run() {
+            while (true) {
+                std::pair<SourceFileStream*, std::string> file;
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex_);
+                    queueChanged_.wait(lock, [this]() { return finished_ || !queue_.empty(); });
+                    if (queue_.empty())
+                        return; // finished
+                    file = std::move(queue_.front());
+                    queue_.pop_front();
+                }
+
+                if (error_)
+                    continue; // ignore the remaining files
+
+                try {
+                    std::lock_guard<std::mutex> lock(compilerMutex_);
+                    compiler_->compileStreamedFile(*file.first, file.second, posIndepCode_);
+                } catch (...) {
+                    error_ = std::current_exception();
+                }
+            }
+        }
+    };
+
+    /**
+     * Compiles the source files of the models which were written to source
+     * file streams instead of being kept in memory.
+     */
+    inline void compileStreamedSources(CCompiler<Base>& compiler,
+                                       bool posIndepCode) {
+        auto* cCompiler = dynamic_cast<AbstractCCompiler<Base>*>(&compiler);
+
+        if (cCompiler != nullptr) {
+            for (SourceFileStream* stream : modelLibraryHelper_->getSourceStreams()) {
+                cCompiler->compileSourceStream(*stream, posIndepCode, modelLibraryHelper_);
+            }
+        } else {
+            processStreamedSources([&](const std::map<std::string, std::string>& sources) {
+                compiler.compileSources(sources, posIndepCode, modelLibraryHelper_);
+            });
+        }
+    }
+
+    /**
+     * Compiles the library function which provides the flags used to
+     * compile each translation unit, when the compiler selected different
+     * flags for each translation unit.
+     */
+    inline void compileCompileFlagsSource(CCompiler<Base>& compiler,
+                                          bool posIndepCode) {
+        auto* cCompiler = dynamic_cast<AbstractCCompiler<Base>*>(&compiler);
+        if (cCompiler == nullptr || cCompiler->getUnitCompileFlags().empty())
+            return;
+
+        std::map<std::string, std::string> sources;
+        modelLibraryHelper_->generateCompileFlagsSource(cCompiler->getUnitCompileFlags(), sources);
+        compiler.compileSources(sources, posIndepCode, modelLibraryHelper_);
+    }
+
 };
 
 } // END cg namespace
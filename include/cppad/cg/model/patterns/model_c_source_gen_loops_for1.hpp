@@ -347,6 +347,7 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJcolDcl);
             langC.setParameterPrecision(_parameterPrecision);
+            langC.setDirectAtomicFunctions(_directAtomicFunctions);
 
             _cache.str("");
             std::ostringstream code;
@@ -373,7 +374,8 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
                     "\n"
                     << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
                     "\n"
-                    "void " << functionName << "(" << argsDcl << ") {\n";
+                    << LanguageC<Base>::generateDirectAtomicDeclarations(_directAtomicFunctions)
+                    << "void " << functionName << "(" << argsDcl << ") {\n";
             nameGenHess.customFunctionVariableDeclarations(_cache);
             _cache << langC.generateIndependentVariableDeclaration() << "\n";
             _cache << langC.generateDependentVariableDeclaration() << "\n";
@@ -388,7 +390,7 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
             nameGenHess.finalizeCustomFunctionVariables(_cache);
             _cache << "}\n\n";
 
-            _sources[functionName + ".c"] = _cache.str();
+            saveSource(functionName + ".c", _cache.str());
             _cache.str("");
 
             /**
@@ -405,16 +407,16 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
      * 
      */
     string functionFor1 = _name + "_" + FUNCTION_SPARSE_FORWARD_ONE;
-    _sources[functionFor1 + ".c"] = generateGlobalForRevWithLoopsFunctionSource(elements,
+    saveSource(functionFor1 + ".c", generateGlobalForRevWithLoopsFunctionSource(elements,
                                                                                 _loopFor1Groups, _nonLoopFor1Elements,
                                                                                 functionFor1, _name, _baseTypeName, "indep",
-                                                                                generateFunctionNameLoopFor1);
+                                                                                generateFunctionNameLoopFor1));
     /**
      * Sparsity
      */
     _cache.str("");
     generateSparsity1DSource2(_name + "_" + FUNCTION_FORWARD_ONE_SPARSITY, elements);
-    _sources[_name + "_" + FUNCTION_FORWARD_ONE_SPARSITY + ".c"] = _cache.str();
+    saveSource(_name + "_" + FUNCTION_FORWARD_ONE_SPARSITY + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -430,7 +432,10 @@ void ModelCSourceGen<Base>::createForwardOneWithLoopsNL(CodeHandler<Base>& handl
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+    langC.setSourceStream(_sourceStream);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     _cache.str("");
     _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_noloop_indep" << j;
     langC.setGenerateFunction(_cache.str());
@@ -847,7 +852,7 @@ std::pair<CG<Base>, IndexPattern*> createForwardOneElement(CodeHandler<Base>& ha
 
 template<class Base>
 std::map<size_t, std::map<size_t, CG<Base> > > ModelCSourceGen<Base>::generateLoopFor1Jac(ADFun<CGBase>& fun,
-                                                                                          const SparsitySetType& sparsity,
+                                                                                          const SparsityPattern& sparsity,
                                                                                           const SparsitySetType& evalSparsity,
                                                                                           const std::vector<CGBase>& x,
                                                                                           bool constainsAtomics) {
@@ -866,8 +871,7 @@ std::map<size_t, std::map<size_t, CG<Base> > > ModelCSourceGen<Base>::generateLo
 
         std::vector<CGBase> jacLoop(row.size());
 
-        CppAD::sparse_jacobian_work work; // temporary structure for CppAD
-        fun.SparseJacobianForward(x, sparsity, row, col, jacLoop, work);
+        sparseJacobianElements(fun, x, sparsity, row, col, jacLoop, true);
 
         // organize results
         for (size_t el = 0; el < jacLoop.size(); el++) {
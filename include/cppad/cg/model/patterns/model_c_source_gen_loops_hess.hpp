@@ -93,16 +93,16 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
         loopHessInfol.noLoopEvalHessTempsSparsity.resize(_funNoLoops != nullptr ? n : 0);
     }
 
-    auto flipIndices = [&](const std::vector<set<size_t> >& groupHess,
+    auto flipIndices = [&](const SparsityPattern& groupHess,
                            size_t tape1,
                            size_t tape2) {
-        return useSymmetry && tape1 > tape2 && groupHess[tape2].find(tape1) != groupHess[tape2].end();
+        return useSymmetry && tape1 > tape2 && groupHess.contains(tape2, tape1);
     };
 
-    auto flipIndices2 = [&](const std::vector<set<size_t> >& groupHess,
+    auto flipIndices2 = [&](const SparsityPattern& groupHess,
                             size_t tape1,
                             size_t tape2) {
-        return useSymmetry && groupHess[tape2].find(tape1) != groupHess[tape2].end();
+        return useSymmetry && groupHess.contains(tape2, tape1);
     };
 
     /**
@@ -117,15 +117,13 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
 
         if (_funNoLoops != nullptr) {
             // considers only the pattern for the original equations and leaves out the temporaries
-            const std::vector<std::set<size_t> >& dydxx = _funNoLoops->getHessianOrigEqsSparsity();
-            if (!dydxx.empty()) {
-                if (dydxx[j1].find(j2) != dydxx[j1].end()) {
-                    /**
-                     * Present in the equations outside the loops
-                     */
-                    noLoopEvalHessSparsity[j1].insert(j2);
-                    noLoopEvalHessLocations[j1][j2].insert(e);
-                }
+            const SparsityPattern& dydxx = _funNoLoops->getHessianOrigEqsSparsity();
+            if (dydxx.contains(j1, j2)) {
+                /**
+                 * Present in the equations outside the loops
+                 */
+                noLoopEvalHessSparsity[j1].insert(j2);
+                noLoopEvalHessLocations[j1][j2].insert(e);
             }
         }
 
@@ -133,7 +131,7 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
             size_t nIter = loop->getIterationCount();
 
             const std::vector<IterEquationGroup<Base> >& eqGroups = loop->getEquationsGroups();
-            const std::vector<set<size_t> >& loopJac = loop->getJacobianSparsity();
+            const SparsityPattern& loopJac = loop->getJacobianSparsity();
             HessianWithLoopsInfo<Base>& loopInfo = loopHessInfo.at(loop);
 
             const std::vector<std::vector<LoopPosition> >& indexedIndepIndexes = loop->getIndexedIndepIndexes();
@@ -150,7 +148,7 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
 
             for (size_t g = 0; g < nEqGroups; g++) {
                 const IterEquationGroup<Base>& group = eqGroups[g];
-                const std::vector<set<size_t> >& groupHess = group.getHessianSparsity();
+                const SparsityPattern& groupHess = group.getHessianSparsity();
 
                 /**
                  * indexed - indexed
@@ -236,23 +234,23 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
                             const IterEquationGroup<Base>& group = *itg;
                             size_t g = group.index;
                             HessianWithLoopsEquationGroupInfo<Base>& groupInfo = loopInfo.equationGroups[g];
-                            const std::vector<set<size_t> >& groupHess = group.getHessianSparsity();
+                            const SparsityPattern& groupHess = group.getHessianSparsity();
 
-                            auto itz = groupHess[tapeJ1].lower_bound(nIndexed + nNonIndexed);
+                            const size_t* hessRowEnd = groupHess.end(tapeJ1);
+                            const size_t* itz = std::lower_bound(groupHess.begin(tapeJ1), hessRowEnd, nIndexed + nNonIndexed);
 
                             pairss pos(tapeJ1, j2);
                             bool used = false;
 
                             // loop temporary variables
-                            for (; itz != groupHess[tapeJ1].end(); ++itz) {
+                            for (; itz != hessRowEnd; ++itz) {
                                 size_t tapeJ = *itz;
                                 size_t k = temporaryIndependents[tapeJ - nIndexed - nNonIndexed].original;
 
                                 /**
                                  * check if this temporary depends on j2
                                  */
-                                const set<size_t>& sparsity = _funNoLoops->getJacobianSparsity()[nonIndexdedEqSize + k];
-                                if (sparsity.find(j2) != sparsity.end()) {
+                                if (_funNoLoops->getJacobianSparsity().contains(nonIndexdedEqSize + k, j2)) {
                                     noLoopEvalJacSparsity[nonIndexdedEqSize + k].insert(j2); // element required
 
                                     size_t tapeK = loop->getTempIndepIndexes(k)->tape;
@@ -346,17 +344,17 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
                 for (size_t g = 0; g < nEqGroups; g++) {
                     const IterEquationGroup<Base>& group = eqGroups[g];
 
-                    const set<size_t>& hessRow = group.getHessianSparsity()[posJ1->tape];
-                    auto itz = hessRow.lower_bound(nIndexed + nNonIndexed);
+                    const SparsityPattern& groupHess = group.getHessianSparsity();
+                    const size_t* hessRowEnd = groupHess.end(posJ1->tape);
+                    const size_t* itz = std::lower_bound(groupHess.begin(posJ1->tape), hessRowEnd, nIndexed + nNonIndexed);
 
                     // loop temporary variables
-                    for (; itz != hessRow.end(); ++itz) {
+                    for (; itz != hessRowEnd; ++itz) {
                         size_t tapeJ = *itz;
                         size_t k = temporaryIndependents[tapeJ - nIndexed - nNonIndexed].original;
 
                         // Jacobian of g for k must have j2
-                        const set<size_t>& gJacRow = _funNoLoops->getJacobianSparsity()[nonIndexdedEqSize + k];
-                        if (gJacRow.find(j2) != gJacRow.end()) {
+                        if (_funNoLoops->getJacobianSparsity().contains(nonIndexdedEqSize + k, j2)) {
                             noLoopEvalJacSparsity[nonIndexdedEqSize + k].insert(j2); // element required
 
                             if (!jInNonIndexed) {
@@ -379,16 +377,16 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
              * temporaries
              */
             if (_funNoLoops != nullptr) {
-                const std::vector<set<size_t> >& gJac = _funNoLoops->getJacobianSparsity();
+                const SparsityPattern& gJac = _funNoLoops->getJacobianSparsity();
                 size_t nk = _funNoLoops->getTemporaryDependentCount();
                 size_t nOrigEq = _funNoLoops->getTapeDependentCount() - nk;
 
-                const std::vector<set<size_t> >& dzdxx = _funNoLoops->getHessianTempEqsSparsity();
+                const SparsityPattern& dzdxx = _funNoLoops->getHessianTempEqsSparsity();
 
                 std::vector<std::set<size_t> > usedTapeJ2(nEqGroups);
 
                 for (size_t k1 = 0; k1 < nk; k1++) {
-                    if (gJac[nOrigEq + k1].find(j1) == gJac[nOrigEq + k1].end()) {
+                    if (!gJac.contains(nOrigEq + k1, j1)) {
                         continue;
                     }
 
@@ -405,7 +403,7 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
 
                     for (size_t g = 0; g < nEqGroups; g++) {
                         const IterEquationGroup<Base>& group = eqGroups[g];
-                        const std::vector<set<size_t> >& groupHess = group.getHessianSparsity();
+                        const SparsityPattern& groupHess = group.getHessianSparsity();
                         HessianWithLoopsEquationGroupInfo<Base>& groupHessInfo = loopInfo.equationGroups[g];
 
                         const map<size_t, set<size_t> >& tapeJ22Iter = group.getHessianTempIndexedTapeIndexes(k1, j2);
@@ -458,9 +456,7 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
                          * d x_j2 d z_k1
                          */
                         if (posJ2 != nullptr) {
-                            const set<size_t>& hessRow = group.getHessianSparsity()[posK1->tape];
-
-                            if (hessRow.find(j2) != hessRow.end()) {
+                            if (groupHess.contains(posK1->tape, j2)) {
                                 if (!jInNonIndexed) {
                                     jInNonIndexed = true;
                                     CPPADCG_ASSERT_KNOWN(loopInfo.nonIndexedNonIndexedPosition.find(orig) == loopInfo.nonIndexedNonIndexedPosition.end(),
@@ -480,14 +476,13 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
                          * d z_k2 d z_k1     d x_j2
                          */
                         // loop Hessian row
-                        const set<size_t>& hessRow = group.getHessianSparsity()[posK1->tape];
-                        auto itTapeJ2 = hessRow.lower_bound(nIndexed + nNonIndexed);
-                        for (; itTapeJ2 != hessRow.end(); ++itTapeJ2) {
+                        const size_t* hessRowEnd = groupHess.end(posK1->tape);
+                        const size_t* itTapeJ2 = std::lower_bound(groupHess.begin(posK1->tape), hessRowEnd, nIndexed + nNonIndexed);
+                        for (; itTapeJ2 != hessRowEnd; ++itTapeJ2) {
                             size_t tapeK2 = *itTapeJ2;
                             size_t k2 = loop->getTemporaryIndependents()[tapeK2 - nIndexed - nNonIndexed].original;
 
-                            const set<size_t>& jacZk2Row = gJac[nOrigEq + k2];
-                            if (jacZk2Row.find(j2) != jacZk2Row.end()) { // is this check truly needed?
+                            if (gJac.contains(nOrigEq + k2, j2)) { // is this check truly needed?
 
                                 if (!jInNonIndexed) {
                                     jInNonIndexed = true;
@@ -512,12 +507,10 @@ void ModelCSourceGen<Base>::analyseSparseHessianWithLoops(const std::vector<size
                      * d f_i   .  d      d z_k1
                      * d z_k1     d x_j2 d x_j1
                      */
-                    if (dzdxx[j1].find(j2) != dzdxx[j1].end()) {
-
-                        for (size_t i = 0; i < loopJac.size(); i++) {
-                            const set<size_t>& fJacRow = loopJac[i];
+                    if (dzdxx.contains(j1, j2)) {
 
-                            if (fJacRow.find(posK1->tape) != fJacRow.end()) {
+                        for (size_t i = 0; i < loopJac.rows(); i++) {
+                            if (loopJac.contains(i, posK1->tape)) {
                                 if (!jInNonIndexed) {
                                     CPPADCG_ASSERT_KNOWN(loopInfo.nonIndexedNonIndexedPosition.find(orig) == loopInfo.nonIndexedNonIndexedPosition.end(),
                                                          "Repeated hessian elements requested")
@@ -1098,10 +1091,10 @@ inline void generateLoopForJacHes(ADFun<CG<Base> >& fun,
                                   const std::vector<CG<Base> >& x,
                                   const std::vector<std::vector<CG<Base> > >& vw,
                                   std::vector<CG<Base> >& y,
-                                  const std::vector<std::set<size_t> >& jacSparsity,
+                                  const SparsityPattern& jacSparsity,
                                   const std::vector<std::set<size_t> >& jacEvalSparsity,
                                   std::vector<std::map<size_t, CG<Base> > >& jac,
-                                  const std::vector<std::set<size_t> >& hesSparsity,
+                                  const SparsityPattern& hesSparsity,
                                   const std::vector<std::set<size_t> >& hesEvalSparsity,
                                   std::vector<std::map<size_t, std::map<size_t, CG<Base> > > >& vhess,
                                   bool individualColoring) {
@@ -1146,12 +1139,13 @@ inline void generateLoopForJacHes(ADFun<CG<Base> >& fun,
             xl = x;
         }
 
+        // sparseForJacHessian() relies on the set based CppAD sparsity API
         SparseForjacHessianWork work;
         sparseForJacHessian(fun, xl, vw,
                             y,
-                            jacSparsity,
+                            jacSparsity.toSets(),
                             jacRow, jacCol, jacFlat,
-                            hesSparsity,
+                            hesSparsity.toSets(),
                             hesRow, hesCol, vhessFlat,
                             work);
 
@@ -124,8 +124,7 @@ void ModelCSourceGen<Base>::analyseSparseJacobianWithLoops(const std::vector<siz
             size_t nIndexed = indexedIndepIndexes.size();
             size_t nNonIndexed = nonIndexedIndepIndexes.size();
 
-            const std::vector<std::set<size_t> >& loopSparsity = loop->getJacobianSparsity();
-            const std::set<size_t>& loopRow = loopSparsity[tapeI];
+            const SparsityPattern& loopSparsity = loop->getJacobianSparsity();
 
             JacobianWithLoopsRowInfo& rowInfo = loopEqInfo[loop][tapeI];
 
@@ -137,7 +136,7 @@ void ModelCSourceGen<Base>::analyseSparseJacobianWithLoops(const std::vector<siz
              */
             const std::set<size_t>& tapeJs = loop->getIndexedTapeIndexes(iteration, j);
             for (size_t tapeJ : tapeJs) {
-                if (loopRow.find(tapeJ) != loopRow.end()) {
+                if (loopSparsity.contains(tapeI, tapeJ)) {
                     loopEvalRow.insert(tapeJ);
 
                     //this indexed variable must be request for all iterations 
@@ -155,7 +154,7 @@ void ModelCSourceGen<Base>::analyseSparseJacobianWithLoops(const std::vector<siz
              */
             const LoopPosition* pos = loop->getNonIndexedIndepIndexes(j);
             bool jInNonIndexed = false;
-            if (pos != nullptr && loopRow.find(pos->tape) != loopRow.end()) {
+            if (pos != nullptr && loopSparsity.contains(tapeI, pos->tape)) {
                 loopEvalRow.insert(pos->tape);
 
                 //this non-indexed element must be request for all iterations 
@@ -175,10 +174,11 @@ void ModelCSourceGen<Base>::analyseSparseJacobianWithLoops(const std::vector<siz
              * find temporary variables used by this equation pattern
              */
             if (_funNoLoops != nullptr) {
-                set<size_t>::const_iterator itz = loopRow.lower_bound(nIndexed + nNonIndexed);
+                const size_t* loopRowEnd = loopSparsity.end(tapeI);
+                const size_t* itz = std::lower_bound(loopSparsity.begin(tapeI), loopRowEnd, nIndexed + nNonIndexed);
 
                 // loop temporary variables
-                for (; itz != loopRow.end(); ++itz) {
+                for (; itz != loopRowEnd; ++itz) {
                     size_t tapeJ = *itz;
                     size_t k = temporaryIndependents[tapeJ - nIndexed - nNonIndexed].original;
 
@@ -186,8 +186,7 @@ void ModelCSourceGen<Base>::analyseSparseJacobianWithLoops(const std::vector<siz
                      * check if this temporary depends on j
                      */
                     bool used = false;
-                    const set<size_t>& sparsity = _funNoLoops->getJacobianSparsity()[nonIndexdedEqSize + k];
-                    if (sparsity.find(j) != sparsity.end()) {
+                    if (_funNoLoops->getJacobianSparsity().contains(nonIndexdedEqSize + k, j)) {
                         noLoopEvalSparsity[nonIndexdedEqSize + k].insert(j); // element required
                         if (!jInNonIndexed) {
                             std::vector<size_t>& positions = rowInfo.nonIndexedPositions[j];
@@ -275,12 +274,7 @@ std::vector<CG<Base> > ModelCSourceGen<Base>::prepareSparseJacobianWithLoops(Cod
         generateSparsityIndexes(noLoopEvalSparsity, row, col);
         jacNoLoop.resize(row.size());
 
-        CppAD::sparse_jacobian_work work; // temporary structure for CPPAD
-        if (forward) {
-            fun.SparseJacobianForward(x, _funNoLoops->getJacobianSparsity(), row, col, jacNoLoop, work);
-        } else {
-            fun.SparseJacobianReverse(x, _funNoLoops->getJacobianSparsity(), row, col, jacNoLoop, work);
-        }
+        sparseJacobianElements(fun, x, _funNoLoops->getJacobianSparsity(), row, col, jacNoLoop, forward);
 
         for (size_t el = 0; el < row.size(); el++) {
             size_t il = row[el];
@@ -337,12 +331,7 @@ std::vector<CG<Base> > ModelCSourceGen<Base>::prepareSparseJacobianWithLoops(Cod
             continue;
         }
 
-        CppAD::sparse_jacobian_work work; // temporary structure for CppAD
-        if (forward) {
-            fun.SparseJacobianForward(xl, lModel.getJacobianSparsity(), row, col, jacLoop, work);
-        } else {
-            fun.SparseJacobianReverse(xl, lModel.getJacobianSparsity(), row, col, jacLoop, work);
-        }
+        sparseJacobianElements(fun, xl, lModel.getJacobianSparsity(), row, col, jacLoop, forward);
 
         // organize results
         std::vector<std::map<size_t, CGBase> > dyiDxtape(lModel.getTapeDependentCount());
@@ -62,7 +62,7 @@ void ModelCSourceGen<Base>::generateSparseJacobianWithLoopsSourceFromForRev(cons
 
     finishedJob();
 
-    _sources[model_function + ".c"] = _cache.str();
+    saveSource(model_function + ".c", _cache.str());
     _cache.str("");
 }
 
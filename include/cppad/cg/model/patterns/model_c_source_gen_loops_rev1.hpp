@@ -282,6 +282,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJrowDcl);
             langC.setParameterPrecision(_parameterPrecision);
+            langC.setDirectAtomicFunctions(_directAtomicFunctions);
 
             _cache.str("");
             std::ostringstream code;
@@ -308,7 +309,8 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
                     "\n"
                     << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
                     "\n"
-                    "void " << functionName << "(" << argsDcl << ") {\n";
+                    << LanguageC<Base>::generateDirectAtomicDeclarations(_directAtomicFunctions)
+                    << "void " << functionName << "(" << argsDcl << ") {\n";
             nameGenHess.customFunctionVariableDeclarations(_cache);
             _cache << langC.generateIndependentVariableDeclaration() << "\n";
             _cache << langC.generateDependentVariableDeclaration() << "\n";
@@ -323,7 +325,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
             nameGenHess.finalizeCustomFunctionVariables(_cache);
             _cache << "}\n\n";
 
-            _sources[functionName + ".c"] = _cache.str();
+            saveSource(functionName + ".c", _cache.str());
             _cache.str("");
 
             /**
@@ -340,16 +342,16 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
      * 
      */
     string functionRev1 = _name + "_" + FUNCTION_SPARSE_REVERSE_ONE;
-    _sources[functionRev1 + ".c"] = generateGlobalForRevWithLoopsFunctionSource(elements,
+    saveSource(functionRev1 + ".c", generateGlobalForRevWithLoopsFunctionSource(elements,
                                                                                 _loopRev1Groups, _nonLoopRev1Elements,
                                                                                 functionRev1, _name, _baseTypeName, "dep",
-                                                                                generateFunctionNameLoopRev1);
+                                                                                generateFunctionNameLoopRev1));
     /**
      * Sparsity
      */
     _cache.str("");
     generateSparsity1DSource2(_name + "_" + FUNCTION_REVERSE_ONE_SPARSITY, elements);
-    _sources[_name + "_" + FUNCTION_REVERSE_ONE_SPARSITY + ".c"] = _cache.str();
+    saveSource(_name + "_" + FUNCTION_REVERSE_ONE_SPARSITY + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -365,7 +367,10 @@ void ModelCSourceGen<Base>::createReverseOneWithLoopsNL(CodeHandler<Base>& handl
 
     LanguageC<Base> langC(_baseTypeName);
     langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+    langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+    langC.setSourceStream(_sourceStream);
     langC.setParameterPrecision(_parameterPrecision);
+    langC.setDirectAtomicFunctions(_directAtomicFunctions);
     _cache.str("");
     _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_noloop_dep" << i;
     langC.setGenerateFunction(_cache.str());
@@ -381,7 +386,7 @@ void ModelCSourceGen<Base>::createReverseOneWithLoopsNL(CodeHandler<Base>& handl
 
 template<class Base>
 std::vector<std::map<size_t, CG<Base> > > ModelCSourceGen<Base>::generateLoopRev1Jac(ADFun<CGBase>& fun,
-                                                                                     const SparsitySetType& sparsity,
+                                                                                     const SparsityPattern& sparsity,
                                                                                      const SparsitySetType& evalSparsity,
                                                                                      const std::vector<CGBase>& x,
                                                                                      bool constainsAtomics) {
@@ -400,8 +405,7 @@ std::vector<std::map<size_t, CG<Base> > > ModelCSourceGen<Base>::generateLoopRev
 
         std::vector<CGBase> jacLoop(row.size());
 
-        CppAD::sparse_jacobian_work work; // temporary structure for CppAD
-        fun.SparseJacobianReverse(x, sparsity, row, col, jacLoop, work);
+        sparseJacobianElements(fun, x, sparsity, row, col, jacLoop, false);
 
         // organize results
         for (size_t el = 0; el < jacLoop.size(); el++) {
@@ -383,6 +383,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJrowDcl);
             langC.setParameterPrecision(_parameterPrecision);
+            langC.setDirectAtomicFunctions(_directAtomicFunctions);
 
             std::ostringstream code;
             std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
@@ -408,7 +409,8 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
                     "\n"
                     << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
                     "\n"
-                    "void " << functionName << "(" << argsDcl << ") {\n";
+                    << LanguageC<Base>::generateDirectAtomicDeclarations(_directAtomicFunctions)
+                    << "void " << functionName << "(" << argsDcl << ") {\n";
             nameGenRev2.customFunctionVariableDeclarations(_cache);
             _cache << langC.generateIndependentVariableDeclaration() << "\n";
             _cache << langC.generateDependentVariableDeclaration() << "\n";
@@ -423,7 +425,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
             nameGenRev2.finalizeCustomFunctionVariables(_cache);
             _cache << "}\n\n";
 
-            _sources[functionName + ".c"] = _cache.str();
+            saveSource(functionName + ".c", _cache.str());
             _cache.str("");
 
             /**
@@ -485,12 +487,10 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
 
             std::vector<CGBase> hessNoLoop(row.size());
 
-            CppAD::sparse_hessian_work work; // temporary structure for CPPAD
             // "cppad.symmetric" may have missing values for functions using
             // atomic functions which only provide half of the elements 
             // (some values could be zeroed)
-            work.color_method = "cppad.general";
-            fun.SparseHessian(tx0, pyNoLoop, _funNoLoops->getHessianOrigEqsSparsity(), row, col, hessNoLoop, work);
+            sparseHessianElements(fun, tx0, pyNoLoop, _funNoLoops->getHessianOrigEqsSparsity(), row, col, hessNoLoop, "cppad.general");
 
             map<size_t, map<size_t, CGBase> > hess;
             // save non-indexed hessian elements
@@ -524,8 +524,11 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
 
                 LanguageC<Base> langC(_baseTypeName);
                 langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+                langC.setMaxOperationsPerFunction(_maxOperationsPerFunc);
+                langC.setSourceStream(_sourceStream);
                 langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
                 langC.setParameterPrecision(_parameterPrecision);
+                langC.setDirectAtomicFunctions(_directAtomicFunctions);
                 _cache.str("");
                 _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_noloop_indep" << j;
                 string functionName = _cache.str();
@@ -547,16 +550,16 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
      * 
      */
     string functionRev2 = _name + "_" + FUNCTION_SPARSE_REVERSE_TWO;
-    _sources[functionRev2 + ".c"] = generateGlobalForRevWithLoopsFunctionSource(elements,
+    saveSource(functionRev2 + ".c", generateGlobalForRevWithLoopsFunctionSource(elements,
                                                                                 _loopRev2Groups, _nonLoopRev2Elements,
                                                                                 functionRev2, _name, _baseTypeName, "indep",
-                                                                                generateFunctionNameLoopRev2);
+                                                                                generateFunctionNameLoopRev2));
     /**
      * Sparsity
      */
     _cache.str("");
     generateSparsity1DSource2(_name + "_" + FUNCTION_REVERSE_TWO_SPARSITY, elements);
-    _sources[_name + "_" + FUNCTION_REVERSE_TWO_SPARSITY + ".c"] = _cache.str();
+    saveSource(_name + "_" + FUNCTION_REVERSE_TWO_SPARSITY + ".c", _cache.str());
     _cache.str("");
 }
 
@@ -61,6 +61,12 @@ public:
             }
         }
 
+        this->processStreamedSources([&](const std::map<std::string, std::string>& sources) {
+            for (const auto& it : sources) {
+                saveFile(it.first, it.second);
+            }
+        });
+
         for (const auto& it : this->modelLibraryHelper_->getLibrarySources()) {
             saveFile(it.first, it.second);
         }
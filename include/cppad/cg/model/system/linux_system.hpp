@@ -18,10 +18,13 @@
 
 #if CPPAD_CG_SYSTEM_LINUX
 #include <unistd.h>
+#include <spawn.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
 
+extern char** environ;
+
 namespace CppAD {
 namespace cg {
 
@@ -80,6 +83,40 @@ public:
     }
 };
 
+/**
+ * Utility class for the file actions of a spawned process
+ */
+class SpawnFileActions {
+public:
+    posix_spawn_file_actions_t actions;
+public:
+
+    inline SpawnFileActions() {
+        if (posix_spawn_file_actions_init(&actions) != 0) {
+            throw CGException("Failed to initialize the file actions of a new process");
+        }
+    }
+
+    SpawnFileActions(const SpawnFileActions&) = delete;
+    SpawnFileActions& operator=(const SpawnFileActions&) = delete;
+
+    inline void addClose(int fd) {
+        if (posix_spawn_file_actions_addclose(&actions, fd) != 0) {
+            throw CGException("Failed to define the file actions of a new process");
+        }
+    }
+
+    inline void addDup2(int fd, int newFd) {
+        if (posix_spawn_file_actions_adddup2(&actions, fd, newFd) != 0) {
+            throw CGException("Failed to define the file actions of a new process");
+        }
+    }
+
+    inline ~SpawnFileActions() {
+        posix_spawn_file_actions_destroy(&actions);
+    }
+};
+
 }
 
 #ifdef CPPAD_CG_SYSTEM_APPLE
@@ -195,14 +232,50 @@ inline bool isFile(const std::string& path) {
     return false;
 }
 
+inline std::string findExecutable(const std::string& name) {
+    if (name.find('/') != std::string::npos) {
+        return access(name.c_str(), X_OK) == 0 ? name : "";
+    }
+
+    const char* pathEnv = getenv("PATH");
+    if (pathEnv == nullptr)
+        return "";
+
+    std::string paths(pathEnv);
+    size_t start = 0;
+    while (start <= paths.size()) {
+        size_t end = paths.find(':', start);
+        if (end == std::string::npos)
+            end = paths.size();
+
+        std::string folder = paths.substr(start, end - start);
+        std::string path = createPath(folder.empty() ? "." : folder, name);
+        if (isFile(path) && access(path.c_str(), X_OK) == 0)
+            return path;
+
+        start = end + 1;
+    }
+
+    return "";
+}
+
 inline void callExecutable(const std::string& executable,
                            const std::vector<std::string>& args,
                            std::string* stdOutErrMessage,
                            const std::string* stdInMessage) {
     std::string execName = filenameFromPath(executable);
 
-    PipeHandler pipeMsg; // file descriptors used to communicate between processes
-    pipeMsg.create();
+    auto readCErrorMsg = []() {
+        int error = errno;
+        errno = 0;
+        char buf[512];
+#ifndef CPPAD_CG_SYSTEM_APPLE
+        return std::string(strerror_r(error, buf, 512));
+#else
+        strerror_r(error, buf, 512);
+        return std::string(buf);
+#endif
+    };
 
     PipeHandler pipeStdOutErr; // file descriptors used to communicate between processes
     if(stdOutErrMessage != nullptr) {
@@ -215,111 +288,54 @@ inline void callExecutable(const std::string& executable,
         pipeSrc.create();
     }
 
-    //Fork the compiler, pipe source to it, wait for the compiler to exit
-    pid_t pid = fork();
-    if (pid < 0) {
-        throw CGException("Failed to fork process");
-    }
+    /**
+     * Redirections in the child process
+     */
+    SpawnFileActions actions;
 
-    if (pid == 0) {
-        /***********************************************************************
-         * Child process
-         **********************************************************************/
-        pipeMsg.read.close();
-
-        if (stdInMessage != nullptr) {
-            pipeSrc.write.close(); // close write end of pipe
-            // Send pipe input to stdin
-            close(STDIN_FILENO);
-            if (dup2(pipeSrc.read.fd, STDIN_FILENO) == -1) {
-                perror("redirecting stdin");
-                exit(EXIT_FAILURE);
-            }
-        }
-
-        if(stdOutErrMessage != nullptr) {
-            pipeStdOutErr.read.close(); // close read end of pipe
-
-            // redirect stdout
-            if (dup2(pipeStdOutErr.write.fd, STDOUT_FILENO) == -1) {
-                perror("redirecting stdout");
-                exit(EXIT_FAILURE);
-            }
-
-            // redirect stderr
-            if (dup2(pipeStdOutErr.write.fd, STDERR_FILENO) == -1) {
-                perror("redirecting stderr");
-                exit(EXIT_FAILURE);
-            }
-        }
-
-        auto toCharArray = [](const std::string & args) {
-            const size_t s = args.size() + 1;
-            char* args2 = new char[s];
-            for (size_t c = 0; c < s - 1; c++) {
-                args2[c] = args.at(c);
-            }
-            args2[s - 1] = '\0';
-            return args2;
-        };
-
-        std::vector<char*> args2(args.size() + 2);
-        args2[0] = toCharArray(execName);
-        for (size_t i = 0; i < args.size(); i++) {
-            args2[i + 1] = toCharArray(args[i]);
-        }
-        args2.back() = (char *) nullptr; // END             
-
-        int eCode = execv(executable.c_str(), &args2[0]);
+    if (stdInMessage != nullptr) {
+        // Send pipe input to stdin
+        actions.addClose(pipeSrc.write.fd); // close write end of pipe
+        actions.addDup2(pipeSrc.read.fd, STDIN_FILENO);
+        actions.addClose(pipeSrc.read.fd);
+    }
 
-        for (size_t i = 0; i < args.size(); i++) {
-            delete [] args2[i];
-        }
+    if(stdOutErrMessage != nullptr) {
+        actions.addClose(pipeStdOutErr.read.fd); // close read end of pipe
+        // redirect stdout and stderr
+        actions.addDup2(pipeStdOutErr.write.fd, STDOUT_FILENO);
+        actions.addDup2(pipeStdOutErr.write.fd, STDERR_FILENO);
+        actions.addClose(pipeStdOutErr.write.fd);
+    }
 
-        if(stdOutErrMessage != nullptr) {
-            pipeStdOutErr.write.close();
-        }
+    std::vector<std::string> argsStr(args.size() + 1);
+    argsStr[0] = execName;
+    std::copy(args.begin(), args.end(), argsStr.begin() + 1);
 
-        if (eCode < 0) {
-            char buf[512];
-#ifndef CPPAD_CG_SYSTEM_APPLE
-            std::string error = executable + ": " + strerror_r(errno, buf, 511); // thread safe
-#else
-            std::string error = executable + ": ";
-            strerror_r(errno, buf, 511); // thread safe
-            error += std::string(buf);
-#endif
-            ssize_t size = error.size() + 1;
-            if (write(pipeMsg.write.fd, error.c_str(), size) != size) {
-                std::cerr << "Failed to send message to parent process" << std::endl;
-            }
-            std::cerr << "*** ERROR: exec failed" << std::endl;
-            exit(EXIT_FAILURE);
-        }
-
-        exit(EXIT_SUCCESS);
+    std::vector<char*> args2(argsStr.size() + 1);
+    for (size_t i = 0; i < argsStr.size(); i++) {
+        args2[i] = &argsStr[i][0];
+    }
+    args2.back() = (char *) nullptr; // END
+
+    /**
+     * Spawn the executable without duplicating the memory mappings of this
+     * process (which can be very large while generating source code)
+     */
+    pid_t pid;
+    int eCode = posix_spawn(&pid, executable.c_str(), &actions.actions, nullptr, &args2[0], environ);
+    if (eCode != 0) {
+        errno = eCode;
+        throw CGException("Failed to call executable '", executable, "': ", readCErrorMsg());
     }
 
     /***************************************************************************
      * Parent process
      **************************************************************************/
-    pipeMsg.write.close();
     if(stdOutErrMessage != nullptr) {
         pipeStdOutErr.write.close();
     }
 
-    auto readCErrorMsg = []() {
-        int error = errno;
-        errno = 0;
-        char buf[512];
-#ifndef CPPAD_CG_SYSTEM_APPLE
-        return std::string(strerror_r(error, buf, 512));
-#else
-        strerror_r(error, buf, 512);
-        return std::string(buf);
-#endif
-    };
-
     std::string writeError;
     if (stdInMessage != nullptr) {
         // close read end of pipe
@@ -334,7 +350,6 @@ inline void callExecutable(const std::string& executable,
     //Wait for the executable to exit
     int status;
     // Read message from the child
-    std::ostringstream messageErr;
     std::ostringstream messageStdOutErr;
     size_t size = 0;
     char buffer[128];
@@ -348,41 +363,28 @@ inline void callExecutable(const std::string& executable,
             }
         }
 
-        while ((n = read(pipeMsg.read.fd, buffer, sizeof (buffer))) > 0) {
-            messageErr.write(buffer, n);
-            size += n;
-            if (size > 1e4) break;
-        }
-
         if (waitpid(pid, &status, 0) < 0) {
             throw CGException("Waitpid failed for pid ", pid, " [", readCErrorMsg(), "]");
         }
     } while (!WIFEXITED(status) && !WIFSIGNALED(status));
 
-    pipeMsg.read.close();
     if(stdOutErrMessage != nullptr) {
         pipeStdOutErr.read.close();
     }
 
     if (!writeError.empty()) {
-        std::ostringstream s;
-        s << "Failed to write to pipe";
-        if (size > 0) s << ": " << messageErr.str();
-        else s << ": " << writeError;
-        throw CGException(s.str());
+        throw CGException("Failed to write to pipe: ", writeError);
     }
 
     if (WIFEXITED(status)) {
         if (WEXITSTATUS(status) != EXIT_SUCCESS) {
             std::ostringstream s;
             s << "Executable '" << executable << "' (pid " << pid << ") exited with code " << WEXITSTATUS(status);
-            if (size > 0) s << ": " << messageErr.str();
             throw CGException(s.str());
         }
     } else if (WIFSIGNALED(status)) {
         std::ostringstream s;
         s << "Executable '" << executable << "' (pid " << pid << ") terminated by signal " << WTERMSIG(status);
-        if (size > 0) s << ": " << messageErr.str();
         throw CGException(s.str());
     }
 
@@ -96,6 +96,16 @@ inline bool isDirectory(const std::string& path);
  */
 inline bool isFile(const std::string& path);
 
+/**
+ * Searches for an executable in the folders of the PATH environment
+ * variable (system dependent).
+ *
+ * @param name the executable name
+ * @return the path to the executable or an empty string if it was not
+ *         found
+ */
+inline std::string findExecutable(const std::string& name);
+
 /**
  * Calls an external executable (system dependent).
  * In the case of an error during execution an exception will be thrown.
@@ -97,8 +97,8 @@ private:
      * reproducibility between different runs
      */
     CodeHandlerVector<Base, size_t> origShareNodeId_;
-    /// used to mark visited nodes and indexed nodes
-    size_t color_;
+    /// the number of threads used to compare equation patterns
+    size_t threads_;
 public:
 
     /**
@@ -121,7 +121,7 @@ public:
         independents_(independents),
         idCounter_(0),
         origShareNodeId_(*handler_),
-        color_(0) {
+        threads_(1) {
         CPPADCG_ASSERT_UNKNOWN(independents_.size() > 0)
         CPPADCG_ASSERT_UNKNOWN(independents_[0].getCodeHandler() != nullptr)
         equations_.reserve(relatedDepCandidates_.size());
@@ -136,6 +136,80 @@ public:
         return loops_;
     }
 
+    /**
+     * Provides the number of threads used to compare the expression patterns
+     * of the dependents in different groups of related dependent candidates.
+     *
+     * @return the number of threads (zero means the number of concurrent
+     *         threads supported by the hardware)
+     */
+    inline size_t getThreadCount() const {
+        return threads_;
+    }
+
+    /**
+     * Defines the number of threads used to compare the expression patterns
+     * of the dependents in different groups of related dependent candidates.
+     * The results do not depend on the number of threads.
+     *
+     * @param threads the number of threads (zero means the number of
+     *                concurrent threads supported by the hardware)
+     */
+    inline void setThreadCount(size_t threads) {
+        threads_ = threads;
+    }
+
+    /**
+     * Proposes groups of dependent variables which might share the same
+     * expression pattern (to be used as related dependent candidates).
+     * Dependents are grouped by their structural fingerprint (see
+     * EquationPattern::structuralFingerprint()); the patterns are only
+     * confirmed later during the loop detection.
+     * Dependents which are constant are ignored.
+     *
+     * @param dependents The dependent variable values
+     * @return groups with at least two dependent variable indexes (sorted
+     *         by the lowest dependent index in each group)
+     */
+    static inline std::vector<std::set<size_t> > findRelatedDependentCandidates(const std::vector<CGBase>& dependents) {
+        CodeHandler<Base>* handler = nullptr;
+        for (const CGBase& dep : dependents) {
+            if (dep.isVariable()) {
+                handler = dep.getCodeHandler();
+                break;
+            }
+        }
+
+        if (handler == nullptr)
+            return std::vector<std::set<size_t> >(); // only constants
+
+        CodeHandlerVector<Base, size_t> fingerprints(*handler);
+        fingerprints.adjustSize();
+        handler->startNewOperationTreeVisit();
+
+        std::map<size_t, std::set<size_t> > fingerprint2Deps;
+        std::vector<std::set<size_t>*> groups;
+        for (size_t i = 0; i < dependents.size(); i++) {
+            if (dependents[i].isParameter())
+                continue;
+
+            size_t fp = EquationPattern<Base>::structuralFingerprint(dependents[i], fingerprints);
+            std::set<size_t>& group = fingerprint2Deps[fp];
+            if (group.empty())
+                groups.push_back(&group); // keep the order of the first dependent
+            group.insert(i);
+        }
+
+        std::vector<std::set<size_t> > candidates;
+        for (std::set<size_t>* group : groups) {
+            if (group->size() > 1) {
+                candidates.push_back(std::move(*group));
+            }
+        }
+
+        return candidates;
+    }
+
     /**
      * Detects common equation patterns and generates a new tape for the
      * model using loops.
@@ -785,64 +859,163 @@ private:
 
     std::vector<EquationPattern<Base>*> findRelatedVariables() {
         eqCurr_ = nullptr;
-        CodeHandlerVector<Base, size_t> varColor(*handler_);
-        color_ = 1; // used to mark visited nodes
 
-        varColor.adjustSize();
-        varColor.fill(0);
+        /**
+         * the structural fingerprint is used to avoid comparing dependents
+         * which can never have the same pattern
+         * (determined before any comparison since it marks visited nodes)
+         */
+        CodeHandlerVector<Base, size_t> fingerprints(*handler_);
+        fingerprints.adjustSize();
+        handler_->startNewOperationTreeVisit();
 
         size_t rSize = relatedDepCandidates_.size();
+        std::vector<std::map<size_t, std::vector<size_t> > > buckets(rSize);
+        std::map<size_t, size_t> dep2Fingerprint;
         for (size_t r = 0; r < rSize; r++) {
-            const std::set<size_t>& candidates = relatedDepCandidates_[r];
-            std::set<size_t> used;
+            // group the candidates by fingerprint (sorted by dependent index)
+            for (size_t iDep : relatedDepCandidates_[r]) {
+                size_t fp = EquationPattern<Base>::structuralFingerprint(dependents_[iDep], fingerprints);
+                dep2Fingerprint[iDep] = fp;
+                buckets[r][fp].push_back(iDep);
+            }
+        }
 
-            eqCurr_ = nullptr;
+        /**
+         * The groups of candidates are independent from each other and can be
+         * processed in parallel.
+         * The equation patterns are kept in the order of the candidate
+         * groups so that the results do not depend on the number of threads.
+         */
+        std::vector<std::vector<EquationPattern<Base>*> > rEquations(rSize);
 
-            std::set<size_t>::const_iterator itRef;
-            for (itRef = candidates.begin(); itRef != candidates.end(); ++itRef) {
-                size_t iDepRef = *itRef;
+        size_t nThreads = std::min(threads_ == 0 ? size_t(std::thread::hardware_concurrency()) : threads_, rSize);
+        if (nThreads <= 1) {
+            CodeHandlerVector<Base, size_t> varColor(*handler_);
+            varColor.adjustSize();
+            varColor.fill(0);
+            size_t color = 1; // used to mark visited nodes
 
-                // check if it has already been used
-                if (used.find(iDepRef) != used.end()) {
-                    continue;
-                }
+            for (size_t r = 0; r < rSize; r++) {
+                findRelatedVariables(r, buckets[r], dep2Fingerprint, color, varColor, rEquations[r]);
+            }
 
-                if (eqCurr_ == nullptr || !used.empty()) {
-                    eqCurr_ = new EquationPattern<Base>(dependents_[iDepRef], iDepRef);
-                    equations_.push_back(eqCurr_);
-                }
+        } else {
+            // the vectors must be created before starting the threads (they are registered in the handler)
+            std::vector<CodeHandlerVector<Base, size_t> > varColors(nThreads, CodeHandlerVector<Base, size_t>(*handler_));
+            for (auto& varColor : varColors) {
+                varColor.adjustSize();
+                varColor.fill(0);
+            }
 
-                auto it = itRef;
-                for (++it; it != candidates.end(); ++it) {
-                    size_t iDep = *it;
-                    // check if it has already been used
-                    if (used.find(iDep) != used.end()) {
-                        continue;
+            std::atomic<size_t> next(0);
+            std::vector<std::exception_ptr> errors(nThreads);
+            std::vector<std::thread> workers;
+            workers.reserve(nThreads);
+
+            for (size_t t = 0; t < nThreads; t++) {
+                workers.emplace_back([&, t]() {
+                    try {
+                        size_t color = 1; // used to mark visited nodes
+                        for (size_t r = next++; r < rSize; r = next++) {
+                            findRelatedVariables(r, buckets[r], dep2Fingerprint, color, varColors[t], rEquations[r]);
+                        }
+                    } catch (...) {
+                        errors[t] = std::current_exception();
+                        next = rSize; // stop the other threads
                     }
+                });
+            }
 
-                    if (eqCurr_->testAdd(iDep, dependents_[iDep], color_, varColor)) {
-                        used.insert(iDep);
+            for (auto& w : workers) {
+                w.join();
+            }
+
+            for (const auto& e : errors) {
+                if (e) {
+                    for (const auto& eqs : rEquations) {
+                        for (EquationPattern<Base>* eq : eqs)
+                            delete eq;
                     }
+                    std::rethrow_exception(e);
                 }
+            }
+        }
 
-                if (eqCurr_->dependents.size() == 1) {
-                    // nothing found :(
-                    delete eqCurr_;
-                    eqCurr_ = nullptr;
-                    equations_.pop_back();
+        for (const auto& eqs : rEquations) {
+            equations_.insert(equations_.end(), eqs.begin(), eqs.end());
+        }
+
+        return equations_;
+    }
+
+    /**
+     * Determines the equation patterns in a group of related dependent
+     * candidates.
+     * It does not change the state of this object and can therefore be
+     * called simultaneously for different groups (using different colors).
+     *
+     * @param r the index of the group of related dependent candidates
+     * @param buckets the candidates grouped by structural fingerprint
+     * @param dep2Fingerprint the structural fingerprint of each candidate
+     * @param color the next color to be used to mark visited nodes
+     * @param varColor the node colors
+     * @param equations where the new equation patterns are placed
+     */
+    void findRelatedVariables(size_t r,
+                              const std::map<size_t, std::vector<size_t> >& buckets,
+                              const std::map<size_t, size_t>& dep2Fingerprint,
+                              size_t& color,
+                              CodeHandlerVector<Base, size_t>& varColor,
+                              std::vector<EquationPattern<Base>*>& equations) const {
+        const std::set<size_t>& candidates = relatedDepCandidates_[r];
+        std::set<size_t> used;
+
+        EquationPattern<Base>* eqCurr = nullptr;
+
+        std::set<size_t>::const_iterator itRef;
+        for (itRef = candidates.begin(); itRef != candidates.end(); ++itRef) {
+            size_t iDepRef = *itRef;
+
+            // check if it has already been used
+            if (used.find(iDepRef) != used.end()) {
+                continue;
+            }
+
+            if (eqCurr == nullptr || !used.empty()) {
+                eqCurr = new EquationPattern<Base>(dependents_[iDepRef], iDepRef);
+                equations.push_back(eqCurr);
+            }
+
+            const std::vector<size_t>& bucket = buckets.at(dep2Fingerprint.at(iDepRef));
+            auto it = std::upper_bound(bucket.begin(), bucket.end(), iDepRef);
+            for (; it != bucket.end(); ++it) {
+                size_t iDep = *it;
+                // check if it has already been used
+                if (used.find(iDep) != used.end()) {
+                    continue;
+                }
+
+                if (eqCurr->testAdd(iDep, dependents_[iDep], color, varColor)) {
+                    used.insert(iDep);
                 }
             }
+
+            if (eqCurr->dependents.size() == 1) {
+                // nothing found :(
+                delete eqCurr;
+                eqCurr = nullptr;
+                equations.pop_back();
+            }
         }
 
         /**
          * Determine the independents that don't change from iteration to
          * iteration
          */
-        for (size_t eq = 0; eq < equations_.size(); eq++) {
-            equations_[eq]->detectNonIndexedIndependents();
+        for (EquationPattern<Base>* eq : equations) {
+            eq->detectNonIndexedIndependents();
         }
-
-        return equations_;
     }
 
     /**
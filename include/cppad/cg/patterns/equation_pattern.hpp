@@ -85,6 +85,14 @@ public:
     std::map<const OperationNode<Base>*, std::set<size_t> > constOperationIndependents;
 
 private:
+    /**
+     * Two operations being compared and the next argument to compare
+     */
+    struct ComparePathNode {
+        OperationNode<Base>* nodeRef;
+        OperationNode<Base>* node2;
+        size_t arg;
+    };
     CodeHandler<Base>* const handler_;
     size_t currDep_;
     size_t minColor_;
@@ -231,10 +239,108 @@ public:
 
     }
 
+    /**
+     * Determines a structural fingerprint of the expression of a dependent
+     * variable: the operation types, the operation information, and the
+     * shape of the operation tree, where independent variables are
+     * abstracted as argument slots and all constants are considered equal.
+     * Two dependents with a different fingerprint can never have the same
+     * pattern (comparePath() would fail) while dependents with the same
+     * fingerprint must still be compared.
+     *
+     * @param dep the dependent variable
+     * @param fingerprints the fingerprint of each operation node
+     *                     (only valid for the nodes visited since the last
+     *                     call to CodeHandler::startNewOperationTreeVisit())
+     * @return the fingerprint
+     */
+    static inline size_t structuralFingerprint(const CG<Base>& dep,
+                                               CodeHandlerVector<Base, size_t>& fingerprints) {
+        if (dep.isParameter())
+            return 0;
+
+        return structuralFingerprint(*dep.getOperationNode(), fingerprints);
+    }
+
     virtual ~EquationPattern() = default;
 
 private:
 
+    static inline OperationNode<Base>* skipFingerprintAliases(OperationNode<Base>* n) {
+        while (n->getOperationType() == CGOpCode::Alias) {
+            OperationNode<Base>* sc = n->getArguments()[0].getOperation();
+            if (sc != nullptr && sc->getOperationType() == CGOpCode::Inv) break; // same as comparePath()
+            n = sc;
+        }
+        return n;
+    }
+
+    static inline size_t structuralFingerprint(OperationNode<Base>& node,
+                                               CodeHandlerVector<Base, size_t>& fingerprints) {
+        OperationNode<Base>* root = skipFingerprintAliases(&node);
+
+        CodeHandler<Base>& handler = *root->getCodeHandler();
+        if (handler.isVisited(*root))
+            return fingerprints[*root];
+
+        auto combine = [](size_t& h, size_t v) {
+            h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2);
+        };
+
+        // nodes whose fingerprint is being determined (after their arguments)
+        std::vector<std::pair<OperationNode<Base>*, size_t> > stack; // node, next argument
+        stack.emplace_back(root, 0);
+
+        while (!stack.empty()) {
+            OperationNode<Base>* n = stack.back().first;
+            size_t& a = stack.back().second;
+            const std::vector<Argument<Base> >& args = n->getArguments();
+
+            if (n->getOperationType() != CGOpCode::Inv) {
+                // the fingerprints of the arguments must be determined first
+                for (; a < args.size(); ++a) {
+                    OperationNode<Base>* argOp = args[a].getOperation();
+                    if (argOp != nullptr) {
+                        argOp = skipFingerprintAliases(argOp);
+                        if (!handler.isVisited(*argOp))
+                            break;
+                    }
+                }
+
+                if (a < args.size()) {
+                    stack.emplace_back(skipFingerprintAliases(args[a].getOperation()), 0);
+                    continue;
+                }
+            }
+
+            size_t h = size_t(n->getOperationType()) + 1;
+
+            if (n->getOperationType() != CGOpCode::Inv) {
+                const std::vector<size_t>& info = n->getInfo();
+                combine(h, info.size());
+                for (size_t i : info) {
+                    combine(h, i);
+                }
+
+                combine(h, args.size());
+                for (const Argument<Base>& arg : args) {
+                    if (arg.getOperation() == nullptr) {
+                        combine(h, 1); // constant values are not distinguished
+                    } else {
+                        combine(h, fingerprints[*skipFingerprintAliases(arg.getOperation())]);
+                    }
+                }
+            }
+
+            handler.markVisited(*n);
+            fingerprints[*n] = h;
+
+            stack.pop_back();
+        }
+
+        return fingerprints[*root];
+    }
+
     bool comparePath(const CG<Base>& dep1,
                      const CG<Base>& dep2,
                      size_t dep2Index,
@@ -266,6 +372,65 @@ private:
                      OperationNode<Base>* sc2,
                      size_t dep2,
                      CodeHandlerVector<Base, size_t>& varColor) {
+        /**
+         * the operations being compared whose arguments have not been
+         * completely compared yet (used instead of recursion)
+         */
+        std::vector<ComparePathNode> stack;
+
+        if (!comparePathNode(scRef, sc2, dep2, varColor, stack))
+            return false;
+
+        while (!stack.empty()) {
+            ComparePathNode& cmp = stack.back();
+
+            const std::vector<Argument<Base> >& args1 = cmp.nodeRef->getArguments();
+            const std::vector<Argument<Base> >& args2 = cmp.node2->getArguments();
+            if (cmp.arg == args1.size()) {
+                stack.pop_back();
+                continue;
+            }
+
+            size_t a = cmp.arg++;
+            const Argument<Base>& a1 = args1[a];
+            const Argument<Base>& a2 = args2[a];
+
+            if (a1.getParameter() != nullptr) {
+                if (a2.getParameter() == nullptr || *a1.getParameter() != *a2.getParameter())
+                    return false;
+            } else {
+                if (a2.getOperation() == nullptr) {
+                    return false;
+                }
+                OperationNode<Base>* argRefOp = a1.getOperation();
+                OperationNode<Base>* arg2Op = a2.getOperation();
+                bool related;
+                if (argRefOp->getOperationType() == CGOpCode::Inv) {
+                    related = saveIndependent(cmp.nodeRef, a, argRefOp, arg2Op);
+                } else {
+                    related = comparePathNode(argRefOp, arg2Op, dep2, varColor, stack); // cmp might no longer be valid
+                }
+
+                if (!related)
+                    return false;
+            }
+        }
+
+        return true; // same pattern
+    }
+
+    /**
+     * Compares two operations without their arguments.
+     * If the arguments must also be compared, the operations are added to
+     * the stack.
+     *
+     * @return false if the operations do not have the same pattern
+     */
+    bool comparePathNode(OperationNode<Base>* scRef,
+                         OperationNode<Base>* sc2,
+                         size_t dep2,
+                         CodeHandlerVector<Base, size_t>& varColor,
+                         std::vector<ComparePathNode>& stack) {
         saveOperationReference(dep2, sc2, scRef);
         if (dependents.size() == 1) {
             saveOperationReference(depRefIndex, scRef, scRef);
@@ -321,38 +486,13 @@ private:
             }
         }
 
-        const std::vector<Argument<Base> >& args1 = scRef->getArguments();
-        const std::vector<Argument<Base> >& args2 = sc2->getArguments();
-        size_t size = args1.size();
-        if (size != args2.size()) {
+        if (scRef->getArguments().size() != sc2->getArguments().size()) {
             return false;
         }
-        for (size_t a = 0; a < size; a++) {
-            const Argument<Base>& a1 = args1[a];
-            const Argument<Base>& a2 = args2[a];
 
-            if (a1.getParameter() != nullptr) {
-                if (a2.getParameter() == nullptr || *a1.getParameter() != *a2.getParameter())
-                    return false;
-            } else {
-                if (a2.getOperation() == nullptr) {
-                    return false;
-                }
-                OperationNode<Base>* argRefOp = a1.getOperation();
-                OperationNode<Base>* arg2Op = a2.getOperation();
-                bool related;
-                if (argRefOp->getOperationType() == CGOpCode::Inv) {
-                    related = saveIndependent(scRef, a, argRefOp, arg2Op);
-                } else {
-                    related = comparePath(argRefOp, arg2Op, dep2, varColor);
-                }
-
-                if (!related)
-                    return false;
-            }
-        }
+        stack.push_back(ComparePathNode{scRef, sc2, 0});
 
-        return true; // same pattern
+        return true;
     }
 
     inline void saveOperationReference(size_t dep2,
@@ -474,22 +614,29 @@ private:
         return indexedDependentPath;
     }
 
-    void findOperationsWithIndeps(OperationNode<Base>& node,
+    void findOperationsWithIndeps(OperationNode<Base>& root,
                                   std::set<const OperationNode<Base>*>& ops) const {
-        if (handler_->isVisited(node))
-            return; // been here before
-
-        handler_->markVisited(node);
-
-        const std::vector<Argument<Base> >& args = node.getArguments();
-        size_t size = args.size();
-        for (size_t a = 0; a < size; a++) {
-            OperationNode<Base>* argOp = args[a].getOperation();
-            if (argOp != nullptr) {
-                if (argOp->getOperationType() == CGOpCode::Inv) {
-                    ops.insert(&node);
-                } else {
-                    findOperationsWithIndeps(*argOp, ops);
+        std::vector<OperationNode<Base>*> stack{&root};
+
+        while (!stack.empty()) {
+            OperationNode<Base>& node = *stack.back();
+            stack.pop_back();
+
+            if (handler_->isVisited(node))
+                continue; // been here before
+
+            handler_->markVisited(node);
+
+            const std::vector<Argument<Base> >& args = node.getArguments();
+            size_t size = args.size();
+            for (size_t a = 0; a < size; a++) {
+                OperationNode<Base>* argOp = args[a].getOperation();
+                if (argOp != nullptr) {
+                    if (argOp->getOperationType() == CGOpCode::Inv) {
+                        ops.insert(&node);
+                    } else {
+                        stack.push_back(argOp);
+                    }
                 }
             }
         }
@@ -44,7 +44,7 @@ private:
     /**
      * Hessian sparsity pattern of the tape
      */
-    std::vector<std::set<size_t> > hessTapeSparsity_;
+    SparsityPattern hessTapeSparsity_;
     bool hessSparsity_;
     /**
      * indexed Hessian elements
@@ -93,7 +93,7 @@ public:
 
         ADFun<CGB>& fun = model->getTape();
 
-        hessTapeSparsity_ = hessianSparsitySet<std::vector<std::set<size_t> >, CGB>(fun, tapeI);
+        hessTapeSparsity_ = hessianSparsityPattern(fun, tapeI);
 
         /**
          * make a database of the Hessian elements
@@ -107,11 +107,11 @@ public:
              * indexed tapeJ1
              */
             for (size_t tapeJ1 = 0; tapeJ1 < nIndexed; tapeJ1++) {
-                const std::set<size_t>& hessRow = hessTapeSparsity_[tapeJ1];
+                const size_t* hessRowEnd = hessTapeSparsity_.end(tapeJ1);
                 size_t j1 = indexedIndepIndexes[tapeJ1][iter].original;
 
-                std::set<size_t> ::const_iterator itTape2;
-                for (itTape2 = hessRow.begin(); itTape2 != hessRow.end() && *itTape2 < nIndexed; ++itTape2) {
+                const size_t* itTape2;
+                for (itTape2 = hessTapeSparsity_.begin(tapeJ1); itTape2 != hessRowEnd && *itTape2 < nIndexed; ++itTape2) {
                     size_t j2 = indexedIndepIndexes[*itTape2][iter].original;
                     pairss orig(j1, j2);
                     pairss tapeTape(tapeJ1, *itTape2);
@@ -120,7 +120,7 @@ public:
                     iterations[iter].insert(tapeTape);
                 }
 
-                for (; itTape2 != hessRow.end() && *itTape2 < nIndexed + nNonIndexed; ++itTape2) {
+                for (; itTape2 != hessRowEnd && *itTape2 < nIndexed + nNonIndexed; ++itTape2) {
                     size_t j2 = nonIndexedIndepIndexes[*itTape2 - nIndexed].original;
                     pairss orig(j1, j2);
                     std::vector<std::set<size_t> >& iterations = hessOrig2Iter2TapeJ1OrigJ2_[orig];
@@ -133,11 +133,11 @@ public:
              * non-indexed tapeJ1
              */
             for (size_t tapeJ1 = nIndexed; tapeJ1 < nIndexed + nNonIndexed; tapeJ1++) {
-                const std::set<size_t>& hessRow = hessTapeSparsity_[tapeJ1];
+                const size_t* hessRowEnd = hessTapeSparsity_.end(tapeJ1);
                 size_t j1 = nonIndexedIndepIndexes[tapeJ1 - nIndexed].original;
 
-                std::set<size_t> ::const_iterator itTape2;
-                for (itTape2 = hessRow.begin(); itTape2 != hessRow.end() && *itTape2 < nIndexed; ++itTape2) {
+                const size_t* itTape2;
+                for (itTape2 = hessTapeSparsity_.begin(tapeJ1); itTape2 != hessRowEnd && *itTape2 < nIndexed; ++itTape2) {
                     size_t j2 = indexedIndepIndexes[*itTape2][iter].original;
                     pairss orig(j1, j2);
                     std::vector<std::set<size_t> >& iterations = hessOrig2Iter2OrigJ1TapeJ2_[orig];
@@ -145,7 +145,7 @@ public:
                     iterations[iter].insert(*itTape2);
                 }
 
-                for (; itTape2 != hessRow.end() && *itTape2 < nIndexed + nNonIndexed; ++itTape2) {
+                for (; itTape2 != hessRowEnd && *itTape2 < nIndexed + nNonIndexed; ++itTape2) {
                     size_t j2 = nonIndexedIndepIndexes[*itTape2 - nIndexed].original;
                     pairss orig(j1, j2);
                     hessOrigJ1OrigJ2_.insert(orig);
@@ -156,11 +156,11 @@ public:
              * temporaries tapeJ1
              */
             for (size_t tapeJ1 = nIndexed + nNonIndexed; tapeJ1 < nIndexed + nNonIndexed + nTemp; tapeJ1++) {
-                const std::set<size_t>& hessRow = hessTapeSparsity_[tapeJ1];
+                const size_t* hessRowEnd = hessTapeSparsity_.end(tapeJ1);
                 size_t k1 = temporaryIndependents[tapeJ1 - nIndexed - nNonIndexed].original;
 
-                std::set<size_t> ::const_iterator itTape2;
-                for (itTape2 = hessRow.begin(); itTape2 != hessRow.end() && *itTape2 < nIndexed; ++itTape2) {
+                const size_t* itTape2;
+                for (itTape2 = hessTapeSparsity_.begin(tapeJ1); itTape2 != hessRowEnd && *itTape2 < nIndexed; ++itTape2) {
                     size_t j2 = indexedIndepIndexes[*itTape2][iter].original;
                     pairss pos(k1, j2);
                     std::map<size_t, std::set<size_t> >& var2iters = hessOrig2TempTapeJ22Iter_[pos];
@@ -174,7 +174,7 @@ public:
 
     }
 
-    inline const std::vector<std::set<size_t> >& getHessianSparsity() const {
+    inline const SparsityPattern& getHessianSparsity() const {
         return hessTapeSparsity_;
     }
 
@@ -44,18 +44,18 @@ protected:
     /**
      * Jacobian sparsity pattern of the tape
      */
-    VectorSet jacTapeSparsity_;
+    SparsityPattern jacTapeSparsity_;
     bool jacSparsity_;
     /**
      * Hessian sparsity pattern for equations used to determine the
      * temporaries (ignores the the original model equations)
      */
-    VectorSet hessTapeTempSparsity_;
+    SparsityPattern hessTapeTempSparsity_;
     /**
      * Hessian sparsity pattern for the original model equations in the tape
      * (ignores the equations for the temporaries)
      */
-    VectorSet hessTapeOrigEqSparsity_;
+    SparsityPattern hessTapeOrigEqSparsity_;
     // whether or not the hessian sparsities have been evaluated
     bool hessSparsity_;
 public:
@@ -112,12 +112,12 @@ public:
 
     inline void evalJacobianSparsity() {
         if (!jacSparsity_) {
-            jacTapeSparsity_ = jacobianSparsitySet<VectorSet, CGB>(*fun_);
+            jacTapeSparsity_ = jacobianSparsityPattern(*fun_);
             jacSparsity_ = true;
         }
     }
 
-    inline const VectorSet& getJacobianSparsity() const {
+    inline const SparsityPattern& getJacobianSparsity() const {
         return jacTapeSparsity_;
     }
 
@@ -133,7 +133,9 @@ public:
                 for (size_t i = 0; i < mo; i++)
                     eqs.insert(eqs.end(), i);
 
-                hessTapeOrigEqSparsity_ = hessianSparsitySet<std::vector<std::set<size_t> >, CGB>(*fun_, eqs);
+                hessTapeOrigEqSparsity_ = hessianSparsityPattern(*fun_, eqs);
+            } else {
+                hessTapeOrigEqSparsity_ = SparsityPattern(n, n);
             }
 
             // hessian for the temporary variable equations
@@ -141,21 +143,21 @@ public:
                 eqs.clear();
                 for (size_t i = mo; i < m; i++)
                     eqs.insert(eqs.end(), i);
-                hessTapeTempSparsity_ = hessianSparsitySet<std::vector<std::set<size_t> >, CGB>(*fun_, eqs);
+                hessTapeTempSparsity_ = hessianSparsityPattern(*fun_, eqs);
             } else {
-                hessTapeTempSparsity_.resize(n);
+                hessTapeTempSparsity_ = SparsityPattern(n, n);
             }
 
             hessSparsity_ = true;
         }
     }
 
-    inline const VectorSet& getHessianTempEqsSparsity() const {
+    inline const SparsityPattern& getHessianTempEqsSparsity() const {
         CPPADCG_ASSERT_UNKNOWN(hessSparsity_)
         return hessTapeTempSparsity_;
     }
 
-    inline const VectorSet& getHessianOrigEqsSparsity() const {
+    inline const SparsityPattern& getHessianOrigEqsSparsity() const {
         CPPADCG_ASSERT_UNKNOWN(hessSparsity_)
         return hessTapeOrigEqSparsity_;
     }
@@ -371,12 +373,10 @@ public:
                 wNoLoop[inl] = w[dependentIndexes_[inl]];
             }
 
-            CppAD::sparse_hessian_work work; // temporary structure for CPPAD
             // "cppad.symmetric" may have missing values for functions using
             // atomic functions which only provide half of the elements
             // (some values could be zeroed)
-            work.color_method = "cppad.general";
-            fun_->SparseHessian(x, wNoLoop, hessTapeOrigEqSparsity_, row, col, hessNoLoop, work);
+            sparseHessianElements(*fun_, x, wNoLoop, hessTapeOrigEqSparsity_, row, col, hessNoLoop, "cppad.general");
 
             // save non-indexed hessian elements
             for (size_t el = 0; el < row.size(); el++) {
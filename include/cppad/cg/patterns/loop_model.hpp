@@ -101,12 +101,12 @@ private:
     /**
      * Jacobian sparsity pattern of the tape
      */
-    std::vector<std::set<size_t> > jacTapeSparsity_;
+    SparsityPattern jacTapeSparsity_;
     bool jacSparsity_;
     /**
      * Hessian sparsity pattern of the tape
      */
-    std::vector<std::set<size_t> > hessTapeSparsity_;
+    SparsityPattern hessTapeSparsity_;
     bool hessSparsity_;
 public:
 
@@ -453,33 +453,38 @@ public:
 
     inline void evalJacobianSparsity() {
         if (!jacSparsity_) {
-            jacTapeSparsity_ = jacobianSparsitySet<std::vector<std::set<size_t> >, CGB>(*fun_);
+            jacTapeSparsity_ = jacobianSparsityPattern(*fun_);
             jacSparsity_ = true;
         }
     }
 
-    inline const std::vector<std::set<size_t> >& getJacobianSparsity() const {
+    inline const SparsityPattern& getJacobianSparsity() const {
         return jacTapeSparsity_;
     }
 
     inline void evalHessianSparsity() {
         if (!hessSparsity_) {
             size_t n = fun_->Domain();
-            hessTapeSparsity_.resize(n);
 
+            // union of the Hessian sparsities of all equation groups
+            std::vector<size_t> rows, cols;
             for (size_t g = 0; g < equationGroups_.size(); g++) {
                 equationGroups_[g].evalHessianSparsity();
-                const std::vector<std::set<size_t> >& ghess = equationGroups_[g].getHessianSparsity();
-                for (size_t j = 0; j < n; j++) {
-                    hessTapeSparsity_[j].insert(ghess[j].begin(), ghess[j].end());
+                const SparsityPattern& ghess = equationGroups_[g].getHessianSparsity();
+                for (size_t j = 0; j < ghess.rows(); j++) {
+                    for (const size_t* it = ghess.begin(j); it != ghess.end(j); ++it) {
+                        rows.push_back(j);
+                        cols.push_back(*it);
+                    }
                 }
             }
+            hessTapeSparsity_ = SparsityPattern(n, n, rows, cols);
 
             hessSparsity_ = true;
         }
     }
 
-    inline const std::vector<std::set<size_t> >& getHessianSparsity() const {
+    inline const SparsityPattern& getHessianSparsity() const {
         return hessTapeSparsity_;
     }
 
@@ -0,0 +1,287 @@
+#ifndef CPPAD_CG_SOURCE_FILE_STREAM_INCLUDED
+#define CPPAD_CG_SOURCE_FILE_STREAM_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Writes generated source files to disk as soon as they are created,
+ * optionally compressed with gzip, so that the source code of a large
+ * model does not have to be kept in memory until it is compiled.
+ * Files can be extracted and read by another thread (e.g. a compiler)
+ * while new files are written.
+ *
+ * @author Joao Leal
+ */
+class SourceFileStream {
+protected:
+    /**
+     * the folder where the source files are written
+     */
+    std::string _folder;
+    /**
+     * whether or not the source files are compressed
+     */
+    bool _compress;
+    /**
+     * the path to the gzip executable (searched in the PATH when empty)
+     */
+    std::string _gzipPath;
+    /**
+     * maps the source file names to their paths
+     */
+    std::map<std::string, std::string> _files;
+    /**
+     * the number of characters written (before compression)
+     */
+    size_t _size;
+    /**
+     * called after each new source file is written
+     */
+    std::function<void(const std::string&)> _writeListener;
+    /**
+     * protects the files and the size from concurrent access
+     */
+    mutable std::mutex _mutex;
+public:
+
+    /**
+     * Creates a new stream of source files.
+     *
+     * @param folder the folder where the source files are written
+     * @param compress whether or not to compress the source files
+     */
+    explicit SourceFileStream(std::string folder = "cppadcg_sources",
+                              bool compress = false) :
+        _folder(std::move(folder)),
+        _compress(compress),
+        _gzipPath(system::findExecutable("gzip")),
+        _size(0) {
+        CPPADCG_ASSERT_KNOWN(!_folder.empty(), "Invalid source folder")
+    }
+
+    SourceFileStream(const SourceFileStream&) = delete;
+    SourceFileStream& operator=(const SourceFileStream&) = delete;
+
+    virtual ~SourceFileStream() = default;
+
+    /**
+     * Provides the folder where the source files are written.
+     */
+    inline const std::string& getFolder() const {
+        return _folder;
+    }
+
+    /**
+     * Whether or not the source files are compressed with gzip.
+     */
+    inline bool isCompress() const {
+        return _compress;
+    }
+
+    /**
+     * Defines whether or not the source files which are written from now
+     * on are compressed with gzip.
+     * Compressed files are extracted one at a time when they are compiled.
+     *
+     * @param compress whether or not to compress the source files
+     */
+    inline void setCompress(bool compress) {
+        _compress = compress;
+    }
+
+    /**
+     * Provides the path to the gzip executable.
+     * By default it is the first gzip executable found in the folders of
+     * the PATH environment variable (empty if it was not found).
+     */
+    inline const std::string& getGzipPath() const {
+        return _gzipPath;
+    }
+
+    /**
+     * Defines the path to the gzip executable used to compress and
+     * extract source files.
+     */
+    inline void setGzipPath(const std::string& gzipPath) {
+        _gzipPath = gzipPath;
+    }
+
+    /**
+     * Provides the source files written so far.
+     * This map must not be used while other threads write to the stream.
+     *
+     * @return maps the source file names to their paths
+     */
+    inline const std::map<std::string, std::string>& getFiles() const {
+        return _files;
+    }
+
+    /**
+     * Provides the number of characters written to this stream (before
+     * compression).
+     */
+    inline size_t getSize() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _size;
+    }
+
+    /**
+     * Provides the function called after each new source file is written.
+     */
+    inline const std::function<void(const std::string&)>& getWriteListener() const {
+        return _writeListener;
+    }
+
+    /**
+     * Defines a function called (in the thread which writes to the stream)
+     * after each new source file is written, with the source file name.
+     * It can be used to process the source files while other source files
+     * are still being generated.
+     *
+     * @param listener the function (an empty function to remove it)
+     */
+    inline void setWriteListener(std::function<void(const std::string&)> listener) {
+        _writeListener = std::move(listener);
+    }
+
+    /**
+     * Writes a new source file (replacing any previous file with the same
+     * name).
+     *
+     * @param name the source file name
+     * @param source the source file content
+     * @throws CGException if the file cannot be created
+     */
+    virtual void write(const std::string& name,
+                       const std::string& source) {
+        system::createFolder(_folder);
+
+        std::string path = system::createPath(_folder, name);
+
+        std::ofstream file(path.c_str());
+        file << source;
+        file.close();
+        if (file.fail())
+            throw CGException("Failed to write source file '", path, "'");
+
+        if (_compress) {
+            system::callExecutable(getGzipExecutable(), {"-f", "-n", path});
+            path += ".gz";
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _files[name] = path;
+            _size += source.size();
+        }
+
+        if (_writeListener)
+            _writeListener(name);
+    }
+
+    /**
+     * Provides an uncompressed version of a source file.
+     * Compressed files are extracted and the extracted file should be
+     * released with release() after it is used.
+     *
+     * @param name the source file name
+     * @return the path to the uncompressed source file
+     * @throws CGException if the source file does not exist
+     */
+    virtual std::string extract(const std::string& name) {
+        const std::string path = getPath(name);
+
+        if (!isCompressed(path))
+            return path;
+
+        system::callExecutable(getGzipExecutable(), {"-d", "-k", "-f", path});
+        return path.substr(0, path.size() - 3);
+    }
+
+    /**
+     * Releases a file created by extract().
+     *
+     * @param name the source file name
+     * @param extracted the path returned by extract()
+     */
+    virtual void release(const std::string& name,
+                         const std::string& extracted) {
+        if (extracted != getPath(name)) {
+            if (remove(extracted.c_str()) != 0)
+                std::cerr << "Failed to delete temporary file '" << extracted << "'" << std::endl;
+        }
+    }
+
+    /**
+     * Reads the content of a source file.
+     *
+     * @param name the source file name
+     * @return the source file content
+     * @throws CGException if the source file does not exist
+     */
+    virtual std::string read(const std::string& name) {
+        std::string path = extract(name);
+
+        std::ifstream file(path.c_str());
+        std::ostringstream source;
+        source << file.rdbuf();
+        file.close();
+
+        release(name, path);
+
+        return source.str();
+    }
+
+    /**
+     * Deletes all the source files written to this stream.
+     */
+    virtual void removeFiles() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const auto& f : _files) {
+            if (remove(f.second.c_str()) != 0)
+                std::cerr << "Failed to delete source file '" << f.second << "'" << std::endl;
+        }
+        _files.clear();
+        _size = 0;
+    }
+
+protected:
+
+    inline std::string getPath(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _files.find(name);
+        if (it == _files.end())
+            throw CGException("Source file '", name, "' was not written to the stream");
+        return it->second;
+    }
+
+    inline const std::string& getGzipExecutable() const {
+        if (_gzipPath.empty())
+            throw CGException("Failed to find the gzip executable (define its path with setGzipPath())");
+        return _gzipPath;
+    }
+
+    static inline bool isCompressed(const std::string& path) {
+        return path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
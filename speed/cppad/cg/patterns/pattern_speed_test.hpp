@@ -81,6 +81,8 @@ public:
     bool cppADCG;
     bool cppADCGLoops;
     bool cppADCGLoopsLlvm;
+    bool cppADCGInterpreter;
+    bool linkTimeOptimization;
 protected:
     std::string libName_;
     bool testJacobian_;
@@ -91,6 +93,7 @@ protected:
     std::vector<std::set<size_t> > customHessSparsity_;
     std::unique_ptr<DynamicLib<Base> > dynamicLib_;
     std::unique_ptr<LlvmModelLibrary<Base> > llvmLib_;
+    std::unique_ptr<ADFun<CGD> > interpretedFun_; // must outlive model_
     std::unique_ptr<GenericModel<Base> > model_;
     std::vector<GenericModel<Base>*> externalModels_;
     std::vector<std::string> compileFlags_;
@@ -119,6 +122,8 @@ public:
         cppADCG(true),
         cppADCGLoops(true),
         cppADCGLoopsLlvm(true),
+        cppADCGInterpreter(true),
+        linkTimeOptimization(false),
         libName_(libName),
         testJacobian_(true),
         testHessian_(true),
@@ -187,6 +192,11 @@ public:
 
         measureSpeedCppADCGWithLoopsLlvm(relatedDepCandidates, repeat, xb);
 
+        /*******************************************************************
+         * CppADCG bytecode interpreter
+         ******************************************************************/
+        measureSpeedCppADCGInterpreter(repeat, xb);
+
         /*******************************************************************
          * CppAD
          ******************************************************************/
@@ -215,7 +225,7 @@ protected:
          ******************************************************************/
         std::string head = "\n"
                 "********************************************************************************\n"
-                "CppADCG (without Loops) GCC\n"
+                "CppADCG (without Loops) GCC" + std::string(linkTimeOptimization ? " LTO" : "") + "\n"
                 "********************************************************************************\n";
         std::cout << head << std::endl;
         std::cerr << head << std::endl;
@@ -257,7 +267,7 @@ protected:
 
         std::string head = "\n"
                 "********************************************************************************\n"
-                "CppADCG (with Loops) GCC\n"
+                "CppADCG (with Loops) GCC" + std::string(linkTimeOptimization ? " LTO" : "") + "\n"
                 "********************************************************************************\n";
         std::cout << head << std::endl;
         std::cerr << head << std::endl;
@@ -299,7 +309,7 @@ protected:
 
         std::string head = "\n"
                 "********************************************************************************\n"
-                "CppADCG (with Loops) LLVM\n"
+                "CppADCG (with Loops) LLVM" + std::string(linkTimeOptimization ? " LTO" : "") + "\n"
                 "********************************************************************************\n";
         std::cout << head << std::endl;
         std::cerr << head << std::endl;
@@ -341,6 +351,57 @@ protected:
         executionSpeedCppADCG(xb, cppADCGLoopsLlvm);
     }
 
+    inline void measureSpeedCppADCGInterpreter(size_t repeat,
+                                               const std::vector<Base>& xb) {
+        using namespace std::chrono;
+        using namespace CppAD;
+
+        std::string head = "\n"
+                "********************************************************************************\n"
+                "CppADCG bytecode interpreter\n"
+                "********************************************************************************\n";
+        std::cout << head << std::endl;
+        std::cerr << head << std::endl;
+
+        printStatHeader();
+
+        ModelCppADCG model(*this);
+
+        /**
+         * preparation (the bytecode is created when each function is first used)
+         */
+        std::vector<duration> dt1(cppADCGInterpreter ? (preparation ? nTimes_ : 1) : 0);
+        std::vector<duration> dt2(dt1.size());
+        for (size_t i = 0; i < dt1.size(); i++) {
+            // tape
+            auto t0 = steady_clock::now();
+            model_.reset();
+            interpretedFun_.reset(tapeModel(model, xb, repeat));
+            dt1[i] = steady_clock::now() - t0;
+
+            // bytecode
+            t0 = steady_clock::now();
+            model_.reset(new InterpretedModel<Base>(*interpretedFun_, libName_));
+            std::vector<double> y, jac, hess;
+            std::vector<size_t> rows, cols;
+            if (zeroOrder)
+                model_->ForwardZero(xb, y);
+            if (sparseJacobian)
+                model_->SparseJacobian(xb, jac, rows, cols);
+            if (sparseHessian)
+                model_->SparseHessian(xb, std::vector<double>(model_->Range(), 1.0), hess, rows, cols);
+            dt2[i] = steady_clock::now() - t0;
+        }
+        printStat("model tape", dt1);
+        printStat("bytecode generation", dt2);
+
+        /**
+         * execution
+         */
+        // evaluation speed
+        executionSpeedCppADCG(xb, cppADCGInterpreter);
+    }
+
     inline void printCGResults() {
         // save results
         if (!patternDection_.empty())
@@ -597,6 +658,7 @@ protected:
         GccCompiler<double> compiler;
         if (!compileFlags_.empty())
             compiler.setCompileFlags(compileFlags_);
+        compiler.setLinkTimeOptimization(linkTimeOptimization);
 #ifndef NDEBUG
         compiler.setSourcesFolder("sources_" + libBaseName);
         compiler.setSaveToDiskFirst(true);
@@ -640,7 +702,13 @@ protected:
         /**
          * Prepare JITed library
          */
+#if LLVM_VERSION_MAJOR >= 5
+        LlvmModelLibraryProcessor<Base> p(*libSourceGen_);
+        p.setLinkTimeOptimization(linkTimeOptimization);
+        llvmLib_ = p.create();
+#else
         llvmLib_ = LlvmModelLibraryProcessor<Base>::create(*libSourceGen_);
+#endif
         model_ = llvmLib_->model(libBaseName + (withLoops ? "Loops" : "NoLoops")); //must request model
         assert(model_.get() != nullptr);
         for (size_t i = 0; i < externalModels_.size(); i++)
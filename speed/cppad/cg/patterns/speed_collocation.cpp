@@ -115,12 +115,14 @@ int main(int argc, char **argv) {
     size_t repeat = PatternSpeedTest::parseProgramArguments(1, argc, argv, 10); // time intervals
     size_t nEls = PatternSpeedTest::parseProgramArguments(2, argc, argv, 10); // number of CSTR elements
     size_t nExec = PatternSpeedTest::parseProgramArguments(3, argc, argv, 30); // number of executions
+    bool lto = PatternSpeedTest::parseProgramArguments(4, argc, argv, 0) != 0; // link-time optimization
 
 
     size_t K = 3;
     size_t ns = PlugFlowModel<AD<double>>::N_EL_STATES;
     CollocationPatternSpeedTest speed(nEls);
     speed.setNumberOfExecutions(nExec);
+    speed.linkTimeOptimization = lto;
 #if 0
     speed.preparation = false;
     speed.zeroOrder = false;
@@ -43,6 +43,7 @@ public:
 
 int main(int argc, char **argv) {
     size_t nEles = PatternSpeedTest::parseProgramArguments(1, argc, argv, 10);
+    bool lto = PatternSpeedTest::parseProgramArguments(2, argc, argv, 0) != 0; // link-time optimization
 
     std::vector<Base> x = PlugFlowModel<Base>::getTypicalValues(nEles);
     std::vector<std::set<size_t> > relations = PlugFlowModel<Base>::getRelatedCandidates(nEles);
@@ -60,5 +61,6 @@ int main(int argc, char **argv) {
     //speed.sparseHessian = false;
     speed.setNumberOfExecutions(30);
     speed.setCompileFlags(flags);
+    speed.linkTimeOptimization = lto;
     speed.measureSpeed(relations, nEles, x);
 }
@@ -258,6 +258,8 @@ public:
 
         unique_ptr<GenericModel<Base> > modelLib = _dynamicLib->model(_modelName);
         unique_ptr<GenericModel<Base> > modelLibOuter = _dynamicLib->model(_modelName + "_outer");
+        // the inner model is called directly by the outer model
+        ASSERT_TRUE(modelLibOuter->getAtomicFunctionNames().empty());
 
         test2LevelAtomicLibModel(modelLib.get(), modelLibOuter.get(),
                                  x, xNorm, eqNorm, epsilonR, epsilonA);
@@ -284,6 +286,8 @@ public:
 
         unique_ptr<GenericModel<Base> > modelLib = _dynamicLib->model(_modelName);
         unique_ptr<GenericModel<Base> > modelLibOuter = _dynamicLib->model(_modelName + "_outer");
+        // the inner model is called directly by the outer model
+        ASSERT_TRUE(modelLibOuter->getAtomicFunctionNames().empty());
 
         test2LevelAtomicLibModelCustomEls(modelLib.get(), modelLibOuter.get(),
                                           x, xNorm, eqNorm,
@@ -291,6 +295,64 @@ public:
                                           epsilonR, epsilonA);
     }
 
+    /**
+     * Test 2 models in the same dynamic library where the inner model is
+     * called through the atomic function structure
+     */
+    void testAtomicLibModelBridgeNotDirect(const CppAD::vector<Base>& x,
+                                           const CppAD::vector<Base>& xNorm,
+                                           const CppAD::vector<Base>& eqNorm,
+                                           Base epsilonR = 1e-14, Base epsilonA = 1e-14) {
+        using namespace std;
+
+        prepareAtomicLibModelBridge(x, xNorm, eqNorm,
+                                    {}, {}, {}, {},
+                                    true, false);
+
+        unique_ptr<GenericModel<Base> > modelLib = _dynamicLib->model(_modelName);
+        unique_ptr<GenericModel<Base> > modelLibOuter = _dynamicLib->model(_modelName + "_outer");
+        // the inner model must be provided to the outer model
+        ASSERT_EQ(modelLibOuter->getAtomicFunctionNames(), std::vector<std::string>{_modelName});
+
+        test2LevelAtomicLibModel(modelLib.get(), modelLibOuter.get(),
+                                 x, xNorm, eqNorm, epsilonR, epsilonA);
+    }
+
+    /**
+     * Test 2 models in the same dynamic library where the inner model does
+     * not provide the first order modes used by the outer model and,
+     * therefore, it cannot be called directly
+     */
+    void testAtomicLibModelBridgeZeroOrderInner(const CppAD::vector<Base>& x,
+                                                const CppAD::vector<Base>& xNorm,
+                                                const CppAD::vector<Base>& eqNorm,
+                                                Base epsilonR = 1e-14, Base epsilonA = 1e-14) {
+        using namespace std;
+        using CppAD::vector;
+
+        prepareAtomicLibModelBridge(x, xNorm, eqNorm,
+                                    {}, {}, {}, {},
+                                    true, true, false);
+
+        unique_ptr<GenericModel<Base> > modelLib = _dynamicLib->model(_modelName);
+        unique_ptr<GenericModel<Base> > modelLibOuter = _dynamicLib->model(_modelName + "_outer");
+        // the inner model must be provided to the outer model
+        ASSERT_EQ(modelLibOuter->getAtomicFunctionNames(), std::vector<std::string>{_modelName});
+
+        modelLibOuter->addAtomicFunction(modelLib->asAtomic());
+
+        const size_t n = _funOuter->Domain();
+
+        vector<CGD> xOrig(n);
+        for (size_t j = 0; j < n; j++)
+            xOrig[j] = x[j];
+
+        vector<CGD> yOrig = _funOuter->Forward(0, xOrig);
+        vector<double> yOuter = modelLibOuter->ForwardZero(x);
+
+        ASSERT_TRUE(compareValues<double>(yOuter, yOrig, epsilonR, epsilonA));
+    }
+
     /**
      * Test the Jacobian and Hessian sparsity patterns computed directly with
      * the methods of the CGAbstractAtomicFun.
@@ -845,7 +907,9 @@ private:
                                              const std::vector<std::set<size_t> >& hessInner,
                                              const std::vector<std::set<size_t> >& jacOuter,
                                              const std::vector<std::set<size_t> >& hessOuter,
-                                             bool createOuterReverse2) {
+                                             bool createOuterReverse2,
+                                             bool directAtomicModelCalls = true,
+                                             bool createInnerFirstOrder = true) {
 
         tapeInnerModel(x, xNorm, eqNorm);
 
@@ -857,6 +921,11 @@ private:
          */
 
         auto cSourceInner = prepareInnerModelCompilation(jacInner, hessInner);
+        if (!createInnerFirstOrder) {
+            cSourceInner->setCreateForwardOne(false);
+            cSourceInner->setCreateReverseOne(false);
+            cSourceInner->setCreateReverseTwo(false);
+        }
 
         /**
          * Second compiled model
@@ -907,6 +976,7 @@ private:
          */
         ModelLibraryCSourceGen<double> compDynHelp(*cSourceInner, cSourceOuter);
         compDynHelp.setVerbose(this->verbose_);
+        compDynHelp.setDirectAtomicModelCalls(directAtomicModelCalls);
 
         std::string folder = std::string("sources_atomiclibmodelbridge_") + (createOuterReverse2 ? "rev2_" : "dir_") + _modelName;
 
@@ -72,6 +72,34 @@ public:
 
     virtual std::vector<ADCGD> model(const std::vector<ADCGD>& ind) = 0;
 
+    /**
+     * Allows subclasses to change the source generation options.
+     */
+    virtual void prepareSourceGen(ModelCSourceGen<double>& modelSourceGen) {
+    }
+
+    /**
+     * Creates the compiler used to build the model library.
+     */
+    virtual std::unique_ptr<GccCompiler<double>> createCompiler() {
+        return std::unique_ptr<GccCompiler<double>>(new GccCompiler<double>(CPPAD_CG_C_COMPILER));
+    }
+
+    /**
+     * Creates the tested model (loaded from a new dynamic library by default).
+     */
+    virtual std::unique_ptr<GenericModel<double>> createModel(DynamicModelLibraryProcessor<double>& p,
+                                                            GccCompiler<double>& compiler) {
+        _dynamicLib = p.createDynamicLibrary(compiler);
+        _dynamicLib->setThreadPoolVerbose(this->verbose_);
+        _dynamicLib->setThreadNumber(2);
+        _dynamicLib->setThreadPoolDisabled(_multithreadDisabled);
+        _dynamicLib->setThreadPoolSchedulerStrategy(_multithreadScheduler);
+        _dynamicLib->setThreadPoolGuidedMaxWork(0.75);
+
+        return _dynamicLib->model(_name + "dynamic");
+    }
+
     void SetUp() override {
         ASSERT_EQ(_xTape.size(), _xRun.size());
         ASSERT_TRUE(_xNorm.empty() || _xRun.size() == _xNorm.size());
@@ -131,11 +159,11 @@ public:
         if (!_hessRow.empty())
             modelSourceGen.setCustomSparseHessianElements(_hessRow, _hessCol);
 
+        prepareSourceGen(modelSourceGen);
+
         ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
         libSourceGen.setMultiThreading(_multithread);
 
-        SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(libSourceGen, "sources_" + _name + "_1");
-
         DynamicModelLibraryProcessor<double> p(libSourceGen);
 
         // some additional tests
@@ -154,7 +182,8 @@ public:
         const auto& cp = p;
         ASSERT_TRUE(cp.getOptions().empty());
 
-        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        std::unique_ptr<GccCompiler<double>> compilerPtr = createCompiler();
+        GccCompiler<double>& compiler = *compilerPtr;
         //compiler.setSaveToDiskFirst(true); // useful to detect problem
         prepareTestCompilerFlags(compiler);
         if(libSourceGen.getMultiThreading() == MultiThreadingType::OPENMP) {
@@ -171,18 +200,11 @@ public:
             compiler.addCompileFlag("-pthread");
         }
 
-        _dynamicLib = p.createDynamicLibrary(compiler);
-        _dynamicLib->setThreadPoolVerbose(this->verbose_);
-        _dynamicLib->setThreadNumber(2);
-        _dynamicLib->setThreadPoolDisabled(_multithreadDisabled);
-        _dynamicLib->setThreadPoolSchedulerStrategy(_multithreadScheduler);
-        _dynamicLib->setThreadPoolGuidedMaxWork(0.75);
-
-        /**
-         * test the library
-         */
-        _model = _dynamicLib->model(_name + "dynamic");
+        _model = createModel(p, compiler);
         ASSERT_TRUE(_model != nullptr);
+
+        // the sources are saved after they are used (source files can be compiled while they are generated)
+        SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(libSourceGen, "sources_" + _name + "_1");
     }
 
     void TearDown() override {
@@ -221,7 +243,7 @@ public:
     // sparse Jacobian
     void testJacobian() {
         // sparse Jacobian again (make sure the second run is also OK)
-        size_t n_tests = _dynamicLib->getThreadNumber() > 1 ? 2 : 1;
+        size_t n_tests = _dynamicLib != nullptr && _dynamicLib->getThreadNumber() > 1 ? 2 : 1;
 
         this->testSparseJacobianResults(n_tests, *_model, *_fun, nullptr, _xRun, !_jacRow.empty(), epsilonR,
                                         epsilonA);
@@ -230,7 +252,7 @@ public:
     // sparse Hessian
     void testHessian() {
         // sparse Hessian again (make sure the second run is also OK)
-        size_t n_tests = _dynamicLib->getThreadNumber() > 1 ? 2 : 1;
+        size_t n_tests = _dynamicLib != nullptr && _dynamicLib->getThreadNumber() > 1 ? 2 : 1;
 
         this->testSparseHessianResults(n_tests, *_model, *_fun, nullptr, _xRun, !_hessRow.empty(), epsilonR,
                                        epsilonA);
@@ -0,0 +1,127 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+void sparsityCacheModel(const std::vector<AD<double> >& x,
+                        std::vector<AD<double> >& y) {
+    y[0] = x[0] * x[1];
+    y[1] = sin(x[1]) + x[2];
+    y[2] = x[2] * x[2] * x[3];
+}
+
+/**
+ * Counts the number of sparsity evaluations
+ */
+class CountingAtomicFun : public CGAtomicFun<double> {
+public:
+    size_t sparsityCalls;
+
+    CountingAtomicFun(atomic_base<double>& atomicFun,
+                      const CppAD::vector<double>& x) :
+        CGAtomicFun<double>(atomicFun, x, true),
+        sparsityCalls(0) {
+    }
+
+    bool for_sparse_jac(size_t q,
+                        const CppAD::vector<std::set<size_t> >& r,
+                        CppAD::vector<std::set<size_t> >& s,
+                        const CppAD::vector<CGD>& x) override {
+        sparsityCalls++;
+        return CGAtomicFun<double>::for_sparse_jac(q, r, s, x);
+    }
+
+    bool rev_sparse_jac(size_t q,
+                        const CppAD::vector<std::set<size_t> >& rt,
+                        CppAD::vector<std::set<size_t> >& st,
+                        const CppAD::vector<CGD>& x) override {
+        sparsityCalls++;
+        return CGAtomicFun<double>::rev_sparse_jac(q, rt, st, x);
+    }
+
+    bool rev_sparse_hes(const CppAD::vector<bool>& vx,
+                        const CppAD::vector<bool>& s,
+                        CppAD::vector<bool>& t,
+                        size_t q,
+                        const CppAD::vector<std::set<size_t> >& r,
+                        const CppAD::vector<std::set<size_t> >& u,
+                        CppAD::vector<std::set<size_t> >& v,
+                        const CppAD::vector<CGD>& x) override {
+        sparsityCalls++;
+        return CGAtomicFun<double>::rev_sparse_hes(vx, s, t, q, r, u, v, x);
+    }
+};
+
+std::vector<double> tapeDerivatives(CountingAtomicFun& atomic,
+                                    const std::vector<double>& xv) {
+    const size_t n = xv.size();
+
+    std::vector<AD<CGD> > ax(n);
+    for (size_t j = 0; j < n; j++)
+        ax[j] = xv[j];
+    CppAD::Independent(ax);
+
+    std::vector<AD<CGD> > ay(3);
+    atomic(ax, ay);
+
+    ADFun<CGD> fun(ax, ay);
+
+    CodeHandler<double> handler;
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+    for (size_t j = 0; j < n; j++)
+        x[j].setValue(xv[j]);
+
+    std::vector<CGD> w{1.0, 2.0, 0.5};
+
+    std::vector<CGD> jac = fun.SparseJacobian(x);
+    std::vector<CGD> hess = fun.SparseHessian(x, w);
+
+    std::vector<double> values;
+    for (const CGD& v : jac)
+        values.push_back(v.getValue());
+    for (const CGD& v : hess)
+        values.push_back(v.getValue());
+    return values;
+}
+
+}
+
+TEST_F(CppADCGTest, AtomicSparsityCache) {
+    std::vector<double> x{0.5, 1.5, 2.0, 3.0};
+
+    std::vector<AD<double> > ax(x.begin(), x.end());
+    std::vector<AD<double> > ay(3);
+    checkpoint<double> atomicFun("sparsityCache", sparsityCacheModel, ax, ay);
+
+    CppAD::vector<double> xSparsity(x.size());
+    for (size_t j = 0; j < x.size(); j++)
+        xSparsity[j] = x[j];
+
+    CountingAtomicFun noCache(atomicFun, xSparsity);
+    noCache.setCacheSparsity(false);
+    std::vector<double> expected = tapeDerivatives(noCache, x);
+
+    CountingAtomicFun cached(atomicFun, xSparsity);
+    ASSERT_TRUE(cached.isCacheSparsity());
+    std::vector<double> values = tapeDerivatives(cached, x);
+
+    ASSERT_TRUE(compareValues(values, expected));
+    ASSERT_LT(cached.sparsityCalls, noCache.sparsityCalls);
+}
@@ -0,0 +1,191 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <cppad/cg/dae_index_reduction/dae_block_c_source_gen.hpp>
+
+#include "CppADCGIndexReductionTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * variables: a, b, c, d, p, e (p is not assigned to any equation)
+ */
+template<class T>
+std::vector<T> daeBlockModel(const std::vector<T>& u) {
+    std::vector<T> res(5);
+    res[0] = u[0] - 2.0 * u[4]; // a
+    res[1] = u[1] + sin(u[2]) - u[0]; // b
+    res[2] = u[2] - cos(u[1]); // c
+    res[3] = u[3] - u[2] * u[0] * u[5]; // d
+    res[4] = u[5] - 1.25; // e (constant)
+    return res;
+}
+
+}
+
+TEST_F(IndexReductionTest, DaeBlockCSourceGen) {
+    using ADCGD = CppAD::AD<CGD>;
+
+    const std::vector<size_t> assigned{0, 1, 2, 3, 5};
+
+    std::vector<ADCGD> u(6);
+    CppAD::Independent(u);
+    std::vector<ADCGD> res = daeBlockModel(u);
+    ADFun<CGD> fun(u, res);
+
+    std::vector<AD<double> > ax(6);
+    CppAD::Independent(ax);
+    std::vector<AD<double> > ares = daeBlockModel(ax);
+    ADFun<double> funD(ax, ares);
+
+    std::vector<DaeEquationInfo> eqInfo;
+    for (size_t i = 0; i < res.size(); ++i) {
+        eqInfo.emplace_back(i, int(i), -1, int(assigned[i]));
+    }
+
+    DaeBlockCSourceGen<double> blockGen(fun, eqInfo, "dae");
+    blockGen.generate();
+
+    const std::vector<DaeBlock>& blocks = blockGen.getBlocks();
+    ASSERT_EQ(blocks.size(), 4u);
+    ASSERT_EQ(blockGen.getModels().size(), 3u);
+
+    // the block with an equation
+    auto blockOf = [&](size_t i) {
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            const std::vector<size_t>& eqs = blocks[b].equations;
+            if (std::find(eqs.begin(), eqs.end(), i) != eqs.end())
+                return b;
+        }
+        return blocks.size();
+    };
+
+    // a = 2 p
+    const DaeBlock& blockA = blocks[blockOf(0)];
+    ASSERT_TRUE(blockA.isExplicit());
+    ASSERT_EQ(blockA.explicitVariables, std::vector<size_t>{0});
+    ASSERT_EQ(blockA.inputVariables, std::vector<size_t>{4});
+
+    // algebraic loop torn with b
+    ASSERT_EQ(blockOf(1), blockOf(2));
+    const DaeBlock& blockBC = blocks[blockOf(1)];
+    ASSERT_FALSE(blockBC.isExplicit());
+    ASSERT_EQ(blockBC.tearVariables, std::vector<size_t>{1});
+    ASSERT_EQ(blockBC.residualEquations, std::vector<size_t>{1});
+    ASSERT_EQ(blockBC.explicitVariables, std::vector<size_t>{2});
+    ASSERT_EQ(blockBC.inputVariables, (std::vector<size_t>{1, 0}));
+
+    // e = 1.25 does not read any variable
+    ASSERT_LT(blockOf(4), blockOf(3));
+    const DaeBlock& blockE = blocks[blockOf(4)];
+    ASSERT_TRUE(blockE.isConstant());
+    ASSERT_EQ(blockE.explicitVariables, std::vector<size_t>{5});
+    ASSERT_EQ(blockGen.getConstantValues(blockOf(4)), std::vector<double>{1.25});
+
+    // d = c a e (the value of e is used directly)
+    const DaeBlock& blockD = blocks[blockOf(3)];
+    ASSERT_TRUE(blockD.isExplicit());
+    ASSERT_EQ(blockD.explicitVariables, std::vector<size_t>{3});
+    ASSERT_EQ(blockD.inputVariables, (std::vector<size_t>{0, 2}));
+
+    // the blocks only use the variables they read
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        if (!blocks[b].isConstant()) {
+            ASSERT_EQ(blockGen.getBlockFunction(b).Domain(), blocks[b].inputVariables.size());
+        }
+    }
+
+    /**
+     * compile the models of the blocks
+     */
+    std::vector<ModelCSourceGen<double>*> models = blockGen.getModels();
+    ModelLibraryCSourceGen<double> libSourceGen(*models[0]);
+    for (size_t k = 1; k < models.size(); ++k)
+        libSourceGen.addModel(*models[k]);
+    DynamicModelLibraryProcessor<double> processor(libSourceGen, "cppad_cg_dae_blocks");
+
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    std::unique_ptr<DynamicLib<double> > dynamicLib = processor.createDynamicLibrary(compiler);
+
+    /**
+     * evaluate the blocks in order (b is the value of the tearing variable)
+     */
+    std::vector<double> x{0.0, 0.3, 0.0, 0.0, 1.5, 0.0};
+    std::vector<double> residuals(res.size(), 0.0);
+
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        const DaeBlock& block = blocks[b];
+
+        if (block.isConstant()) {
+            const std::vector<double>& values = blockGen.getConstantValues(b);
+            for (size_t k = 0; k < values.size(); ++k)
+                x[block.explicitVariables[k]] = values[k];
+            continue;
+        }
+
+        std::vector<double> xb;
+        for (size_t j : block.inputVariables)
+            xb.push_back(x[j]);
+
+        std::unique_ptr<GenericModel<double> > model = dynamicLib->model("dae_block" + std::to_string(b));
+        ASSERT_TRUE(model != nullptr);
+
+        std::vector<double> yb = model->ForwardZero(xb);
+
+        std::vector<CGD> xbCG(xb.begin(), xb.end());
+        std::vector<CGD> ybCG = blockGen.getBlockFunction(b).Forward(0, xbCG);
+        ASSERT_EQ(yb.size(), ybCG.size());
+        for (size_t k = 0; k < yb.size(); ++k) {
+            ASSERT_NEAR(yb[k], ybCG[k].getValue(), 1e-10);
+        }
+
+        size_t nr = block.residualEquations.size();
+        for (size_t k = 0; k < nr; ++k)
+            residuals[block.residualEquations[k]] = yb[k];
+        for (size_t k = 0; k < block.explicitVariables.size(); ++k)
+            x[block.explicitVariables[k]] = yb[nr + k];
+
+        if (!block.isExplicit()) {
+            // derivatives of the residuals relative to the tearing variables
+            std::vector<double> jac;
+            std::vector<size_t> row, col;
+            model->SparseJacobian(xb, jac, row, col);
+
+            std::vector<CGD> jacCG = blockGen.getBlockFunction(b).Jacobian(xbCG);
+            ASSERT_EQ(jac.size(), 1u);
+            for (size_t e = 0; e < jac.size(); ++e) {
+                ASSERT_LT(row[e], nr);
+                ASSERT_LT(col[e], block.tearVariables.size());
+                ASSERT_NEAR(jac[e], jacCG[row[e] * xb.size() + col[e]].getValue(), 1e-10);
+            }
+        }
+    }
+
+    double c = std::cos(0.3);
+    ASSERT_NEAR(x[0], 3.0, 1e-10);
+    ASSERT_NEAR(x[2], c, 1e-10);
+    ASSERT_NEAR(x[3], c * 3.0 * 1.25, 1e-10);
+    ASSERT_NEAR(x[5], 1.25, 1e-10);
+
+    // the blocks agree with the original model
+    std::vector<double> resD = funD.Forward(0, x);
+    ASSERT_TRUE(compareValues(residuals, resD));
+    ASSERT_NEAR(residuals[1], 0.3 + std::sin(c) - 3.0, 1e-10);
+}
@@ -131,6 +131,56 @@ TEST_F(IndexReductionTest, DummyDerivPendulum2D_avoidDummy) {
     delete fun;
 }
 
+/**
+ * @test select the dummy derivatives using a sparse QR decomposition
+ */
+TEST_F(IndexReductionTest, DummyDerivPendulum2D_sparseSelection) {
+    using namespace std;
+
+    std::vector<DaeVarInfo> daeVar;
+
+    ADFun<CGD>* fun = Pendulum2D<CGD> (daeVar);
+
+    std::vector<double> x(daeVar.size());
+    std::vector<double> normVar(daeVar.size(), 1.0);
+    std::vector<double> normEq(5, 1.0);
+
+    x[0] = -1.0; // x
+    x[1] = 0.0; // y
+    x[2] = 0.0; // vx
+    x[3] = 0.0; // vy
+    x[4] = 1.0; // Tension
+    x[5] = 1.0; // length
+
+    x[6] = 0.0; // time
+
+    x[7] = 0.0; // dxdt
+    x[8] = 0.0; // dydt
+    x[9] = -1.0; // dvxdt
+    x[10] = 9.80665; // dvydt
+
+    std::vector<std::string> eqName; // empty
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    DummyDerivatives<double> dummyD(pantelides, x, normVar, normEq);
+    dummyD.setGenerateSemiExplicitDae(true);
+    dummyD.setReduceEquations(false);
+    // always use the sparse decomposition
+    dummyD.setMaxDenseSelectionSize(0);
+    dummyD.setMaxSparseSelectionDensity(1.0);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> newEqInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = dummyD.reduceIndex(newDaeVar, newEqInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+
+    ASSERT_EQ(size_t(3), pantelides.getStructuralIndex());
+
+    delete fun;
+}
+
 TEST_F(IndexReductionTest, DummyDerivPendulum3D) {
     using namespace CppAD;
     using namespace std;
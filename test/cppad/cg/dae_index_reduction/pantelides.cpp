@@ -143,3 +143,159 @@ TEST_F(IndexReductionTest, PantelidesPendulum3D) {
 
     delete fun;
 }
+
+TEST_F(IndexReductionTest, PantelidesPendulum2DHopcroftKarp) {
+    using CGD = CG<double>;
+
+    std::vector<DaeVarInfo> daeVar;
+    // create f: U -> Z and vectors used for derivative calculations
+    ADFun<CGD>* fun = Pendulum2D<CGD> (daeVar);
+
+    std::vector<double> x(daeVar.size());
+    x[0] = -1.0; // x
+    x[1] = 0.0; // y
+    x[2] = 0.0; // vx
+    x[3] = 0.0; // vy
+    x[4] = 1.0; // Tension
+    x[5] = 1.0; // length
+
+    x[6] = 0.0; // time
+
+    x[7] = 0.0; // dxdt
+    x[8] = 0.0; // dydt
+    x[9] = -1.0; // dvxdt
+    x[10] = 9.80665; // dvydt
+
+    std::vector<std::string> eqName; // empty
+
+    AugmentPathHopcroftKarp<double> augment;
+
+    Pantelides<double> pantelides(*fun, daeVar, eqName, x);
+    pantelides.setAugmentPath(augment);
+
+    std::vector<DaeVarInfo> newDaeVar;
+    std::vector<DaeEquationInfo> equationInfo;
+    std::unique_ptr<ADFun<CGD>> reducedFun;
+    ASSERT_NO_THROW(reducedFun = pantelides.reduceIndex(newDaeVar, equationInfo));
+
+    ASSERT_TRUE(reducedFun != nullptr);
+
+    ASSERT_EQ(size_t(3), pantelides.getStructuralIndex());
+
+    /**
+     * block lower triangular form
+     */
+    std::vector<std::vector<size_t> > blocks = bltDecomposition(*reducedFun, equationInfo);
+
+    std::vector<size_t> eqBlock(reducedFun->Range(), reducedFun->Range());
+    for (size_t b = 0; b < blocks.size(); b++) {
+        for (size_t i : blocks[b]) {
+            ASSERT_EQ(eqBlock[i], reducedFun->Range()); // only in one block
+            eqBlock[i] = b;
+        }
+    }
+
+    std::vector<int> var2Eq(newDaeVar.size(), -1);
+    for (size_t i = 0; i < equationInfo.size(); i++) {
+        ASSERT_LT(eqBlock[i], blocks.size()); // all equations are in a block
+        if (equationInfo[i].getAssignedVarIndex() >= 0)
+            var2Eq[equationInfo[i].getAssignedVarIndex()] = int(i);
+    }
+
+    // equations only depend on equations from the same or previous blocks
+    SparsityPattern jacSparsity = jacobianSparsityPattern(*reducedFun);
+    for (size_t i = 0; i < equationInfo.size(); i++) {
+        for (const size_t* j = jacSparsity.begin(i); j != jacSparsity.end(i); ++j) {
+            if (var2Eq[*j] >= 0) {
+                ASSERT_LE(eqBlock[var2Eq[*j]], eqBlock[i]);
+            }
+        }
+    }
+
+    delete fun;
+}
+
+TEST_F(IndexReductionTest, BltDecomposition) {
+    // e0(v0, v1), e1(v1), e2(v2, v3, v0), e3(v2, v3)
+    std::vector<size_t> rows{0, 0, 1, 2, 2, 2, 3, 3};
+    std::vector<size_t> cols{0, 1, 1, 2, 3, 0, 2, 3};
+    SparsityPattern pattern(4, 4, rows, cols);
+
+    std::vector<int> assigned{0, 1, 2, 3};
+
+    std::vector<std::vector<size_t> > blocks = bltDecomposition(pattern, assigned);
+
+    std::vector<std::vector<size_t> > expected{{1}, {0}, {2, 3}};
+    ASSERT_EQ(blocks, expected);
+}
+
+TEST_F(IndexReductionTest, HopcroftKarpMaximumMatching) {
+    // e0(v0, v1), e1(v0), e2(v1, v2), e3(v2, v3, v4), e4(v3), e5(v3, v4)
+    std::vector<std::vector<size_t> > eqVars{{0, 1}, {0}, {1, 2}, {2, 3, 4}, {3}, {3, 4}};
+    const size_t nVars = 5;
+
+    auto createGraph = [&](std::vector<std::unique_ptr<Enode<double>>>& eqs,
+                           std::vector<std::unique_ptr<Vnode<double>>>& vars) {
+        for (size_t j = 0; j < nVars; ++j)
+            vars.emplace_back(new Vnode<double>(j, int(j), "v" + std::to_string(j)));
+        for (size_t i = 0; i < eqVars.size(); ++i) {
+            eqs.emplace_back(new Enode<double>(i));
+            for (size_t j : eqVars[i])
+                eqs[i]->addVariable(vars[j].get());
+        }
+    };
+
+    auto checkMatching = [](const std::vector<std::unique_ptr<Enode<double>>>& eqs) {
+        size_t assigned = 0;
+        for (const auto& i : eqs) {
+            Vnode<double>* j = i->assignmentVariable();
+            if (j == nullptr)
+                continue;
+            EXPECT_EQ(j->assignmentEquation(), i.get());
+            const auto& vars = i->variables();
+            EXPECT_TRUE(std::find(vars.begin(), vars.end(), j) != vars.end());
+            assigned++;
+        }
+        return assigned;
+    };
+
+    /**
+     * one equation at a time
+     */
+    std::vector<std::unique_ptr<Enode<double>>> eqs1;
+    std::vector<std::unique_ptr<Vnode<double>>> vars1;
+    createGraph(eqs1, vars1);
+
+    AugmentPathHopcroftKarp<double> augment1;
+    size_t found = 0;
+    for (const auto& i : eqs1) {
+        for (const auto& e : eqs1)
+            e->uncolor();
+        for (const auto& j : vars1)
+            j->uncolor();
+        if (augment1.augmentPath(*i))
+            found++;
+    }
+
+    /**
+     * all equations at once
+     */
+    std::vector<std::unique_ptr<Enode<double>>> eqs2;
+    std::vector<std::unique_ptr<Vnode<double>>> vars2;
+    createGraph(eqs2, vars2);
+
+    std::vector<Enode<double>*> equations;
+    for (const auto& i : eqs2)
+        equations.push_back(i.get());
+
+    AugmentPathHopcroftKarp<double> augment2;
+    size_t matched = augment2.maximumMatching(equations);
+
+    ASSERT_EQ(size_t(5), found);
+    ASSERT_EQ(found, matched);
+    ASSERT_EQ(found, checkMatching(eqs1));
+    ASSERT_EQ(matched, checkMatching(eqs2));
+
+    // nothing else can be assigned
+    ASSERT_EQ(size_t(0), augment2.maximumMatching(equations));
+}
@@ -0,0 +1,74 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * Operation graphs with very long chains of operations (e.g. unrolled
+ * time integration) must not exhaust the call stack.
+ */
+TEST_F(CppADCGTest, DeepChain) {
+    // deep enough to overflow a default 8 MB stack with one recursive call per operation
+    const size_t depth = 100000;
+
+    CodeHandler<double> handler(depth + 10);
+
+    std::vector<CGD> x(1);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y(1);
+    y[0] = x[0];
+    for (size_t i = 0; i < depth; i++) {
+        y[0] = y[0] + 1.0;
+    }
+
+    /**
+     * evaluator
+     */
+    Evaluator<double, double> evaluator(handler);
+    std::vector<AD<double> > xNew{AD<double>(2.0)};
+    std::vector<AD<double> > yNew = evaluator.evaluate(xNew, y);
+
+    ASSERT_EQ(Value(yNew[0]), 2.0 + depth);
+
+    /**
+     * pattern detection
+     */
+    handler.startNewOperationTreeVisit();
+    CodeHandlerVector<double, size_t> fingerprints(handler);
+    fingerprints.adjustSize();
+    ASSERT_NE(EquationPattern<double>::structuralFingerprint(y[0], fingerprints), 0u);
+
+    CodeHandlerVector<double, size_t> varColor(handler);
+    varColor.adjustSize();
+    size_t color = 1;
+
+    EquationPattern<double> eq(y[0], 0);
+    ASSERT_TRUE(eq.testAdd(1, y[0], color, varColor));
+
+    /**
+     * source code generation
+     */
+    LanguageC<double> langC("double");
+    langC.setMaxOperationsPerAssignment(100);
+    LangCDefaultVariableNameGenerator<double> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, y, nameGen);
+
+    ASSERT_NE(code.str().find("y[0] = "), std::string::npos);
+}
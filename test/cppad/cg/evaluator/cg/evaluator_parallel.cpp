@@ -0,0 +1,128 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGTest, ParallelEvaluator) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(4);
+    handler.makeVariables(x);
+
+    CGD s = x[1] * x[3]; // shared by two dependents
+
+    std::vector<CGD> y(6);
+    y[0] = x[0] * x[1] + sin(x[2]);
+    y[1] = s + x[0];
+    y[2] = s * s;
+    y[3] = cos(x[3]) * x[2];
+    y[4] = 2.0;
+    y[5] = x[1];
+
+    /**
+     * same independent variables (values) for all threads
+     */
+    std::vector<CGD> xNew{0.5, 1.5, 2.5, 3.5};
+
+    Evaluator<double, double, CGD> evaluator(handler);
+    std::vector<CGD> yExpected = evaluator.evaluate(xNew, y);
+
+    ParallelEvaluator<double, double, CGD> parEvaluator(handler);
+    parEvaluator.setThreadCount(3);
+    std::vector<CGD> yNew = parEvaluator.evaluate(xNew, y);
+
+    ASSERT_EQ(yNew.size(), yExpected.size());
+    for (size_t i = 0; i < y.size(); ++i) {
+        ASSERT_TRUE(yNew[i].isParameter());
+        ASSERT_NEAR(yNew[i].getValue(), yExpected[i].getValue(), 1e-14);
+    }
+
+    /**
+     * a different code handler for each thread
+     */
+    size_t nWorkers = 3;
+    std::vector<std::unique_ptr<CodeHandler<double> > > outHandlers(nWorkers);
+    std::vector<std::vector<CGD> > xOut(nWorkers, std::vector<CGD>(x.size()));
+    std::vector<ArrayView<const CGD> > indepNew;
+    for (size_t w = 0; w < nWorkers; ++w) {
+        outHandlers[w].reset(new CodeHandler<double>());
+        outHandlers[w]->makeVariables(xOut[w]);
+        indepNew.emplace_back(xOut[w]);
+    }
+
+    std::vector<size_t> depWorker;
+    yNew = parEvaluator.evaluate(indepNew, y, &depWorker);
+
+    ASSERT_EQ(depWorker.size(), y.size());
+    ASSERT_EQ(depWorker[1], depWorker[2]); // share operations
+    for (size_t i = 0; i < y.size(); ++i) {
+        ASSERT_LT(depWorker[i], nWorkers);
+        if (yNew[i].isVariable()) {
+            ASSERT_EQ(yNew[i].getCodeHandler(), outHandlers[depWorker[i]].get());
+        }
+    }
+    ASSERT_TRUE(yNew[4].isParameter());
+    ASSERT_EQ(yNew[4].getValue(), 2.0);
+}
+
+TEST_F(CppADCGTest, ParallelEvaluatorThreads) {
+    CodeHandler<double> handler;
+
+    size_t n = 8;
+    size_t m = 16;
+    size_t depth = 200;
+
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+
+    // independent chains of operations (one per dependent)
+    std::vector<CGD> y(m);
+    for (size_t i = 0; i < m; ++i) {
+        y[i] = x[i % n];
+        for (size_t k = 0; k < depth; ++k) {
+            y[i] = sin(y[i]) * x[(i + k) % n] + double(i);
+        }
+    }
+
+    std::vector<CGD> xNew(n);
+    for (size_t j = 0; j < n; ++j)
+        xNew[j] = 0.1 * double(j + 1);
+
+    Evaluator<double, double, CGD> evaluator(handler);
+    std::vector<CGD> yExpected = evaluator.evaluate(xNew, y);
+
+    size_t nWorkers = 4;
+    std::vector<ArrayView<const CGD> > indepNew(nWorkers, ArrayView<const CGD>(xNew));
+
+    ParallelEvaluator<double, double, CGD> parEvaluator(handler);
+
+    // repeated to increase the chance of detecting data races
+    for (size_t r = 0; r < 20; ++r) {
+        std::vector<size_t> depWorker;
+        std::vector<CGD> yNew = parEvaluator.evaluate(indepNew, y, &depWorker);
+
+        // all the workers were used
+        std::set<size_t> workers(depWorker.begin(), depWorker.end());
+        ASSERT_EQ(workers.size(), nWorkers);
+
+        ASSERT_EQ(yNew.size(), m);
+        for (size_t i = 0; i < m; ++i) {
+            ASSERT_TRUE(yNew[i].isParameter());
+            ASSERT_EQ(yNew[i].getValue(), yExpected[i].getValue());
+        }
+    }
+}
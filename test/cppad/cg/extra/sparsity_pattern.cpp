@@ -0,0 +1,80 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+#include <gtest/gtest.h>
+
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGTest, SparsityPatternFromIndexes) {
+    // unsorted and with a duplicate
+    std::vector<size_t> row{2, 0, 2, 0, 2, 1};
+    std::vector<size_t> col{3, 1, 0, 0, 3, 2};
+
+    SparsityPattern p(3, 4, row, col);
+
+    ASSERT_EQ(p.rows(), 3u);
+    ASSERT_EQ(p.cols(), 4u);
+    ASSERT_EQ(p.nnz(), 5u);
+    ASSERT_EQ(p.getRowStart(), std::vector<size_t>({0, 2, 3, 5}));
+    ASSERT_EQ(p.getColumnIndexes(), std::vector<size_t>({0, 1, 2, 0, 3}));
+
+    ASSERT_TRUE(p.contains(2, 3));
+    ASSERT_FALSE(p.contains(1, 3));
+
+    std::vector<std::set<size_t> > sets{{0, 1}, {2}, {0, 3}};
+    ASSERT_EQ(p.toSets(), sets);
+    ASSERT_EQ(SparsityPattern::fromSets(sets, 4), p);
+
+    std::vector<size_t> row2, col2;
+    p.toIndexes(row2, col2);
+    ASSERT_EQ(row2, std::vector<size_t>({0, 0, 1, 2, 2}));
+    ASSERT_EQ(col2, std::vector<size_t>({0, 1, 2, 0, 3}));
+
+    ASSERT_EQ(SparsityPattern::fromSparseRc(p.toSparseRc()), p);
+}
+
+TEST_F(CppADCGTest, SparsityPatternTranspose) {
+    std::vector<std::set<size_t> > sets{{0, 1}, {}, {0, 3}};
+    SparsityPattern p = SparsityPattern::fromSets(sets, 4);
+
+    SparsityPattern t = p.transpose();
+    std::vector<std::set<size_t> > setsT{{0, 2}, {0}, {}, {2}};
+    ASSERT_EQ(t.toSets(), setsT);
+    ASSERT_EQ(t.transpose(), p);
+}
+
+TEST_F(CppADCGTest, SparsityPatternADFun) {
+    std::vector<AD<double> > x(3);
+    Independent(x);
+    std::vector<AD<double> > y(2);
+    y[0] = x[0] * x[1];
+    y[1] = sin(x[2]) + x[1];
+    ADFun<double> fun(x, y);
+
+    std::vector<std::set<size_t> > jac = jacobianSparsitySet<std::vector<std::set<size_t> > >(fun);
+    SparsityPattern jacPattern = jacobianSparsityPattern(fun);
+    ASSERT_EQ(jacPattern.toSets(), jac);
+    ASSERT_EQ(jacobianSparsityPattern(fun, true), jacPattern);
+    ASSERT_EQ(jacobianSparsityPattern(fun, false), jacPattern);
+
+    std::vector<std::set<size_t> > hess = hessianSparsitySet<std::vector<std::set<size_t> > >(fun);
+    SparsityPattern hessPattern = hessianSparsityPattern(fun);
+    ASSERT_EQ(hessPattern.toSets(), hess);
+}
@@ -0,0 +1,153 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+void arrayAtomicModel(const std::vector<AD<double> >& ax, std::vector<AD<double> >& ay) {
+    ay[0] = ax[0] * ax[1];
+    ay[1] = ax[1] * ax[2];
+}
+
+/**
+ * An atomic function which also uses the arrays from compiled models directly
+ */
+class ArrayCheckpoint : public checkpoint<double>, public ArrayAtomicFun<double> {
+public:
+    size_t arrayCalls;
+public:
+
+    ArrayCheckpoint(const std::vector<AD<double> >& ax, std::vector<AD<double> >& ay) :
+        checkpoint<double>("arrayAtomic", arrayAtomicModel, ax, ay),
+        arrayCalls(0) {
+    }
+
+    bool forwardArray(int q,
+                      int p,
+                      const Array tx[],
+                      Array& ty) override {
+        arrayCalls++;
+        double x[3], dx[3];
+        toDense(tx[0], x);
+        auto* y = static_cast<double*> (ty.data);
+
+        if (p == 0) {
+            y[0] = x[0] * x[1];
+            y[1] = x[1] * x[2];
+            return true;
+        } else if (p == 1) {
+            toDense(tx[1], dx);
+            y[0] += dx[0] * x[1] + x[0] * dx[1];
+            y[1] += dx[1] * x[2] + x[1] * dx[2];
+            return true;
+        }
+        return false;
+    }
+
+    bool reverseArray(int p,
+                      const Array tx[],
+                      Array& px,
+                      const Array py[]) override {
+        arrayCalls++;
+        double x[3], dx[3], w[2];
+        toDense(tx[0], x);
+        toDense(py[0], w);
+        auto* pxv = static_cast<double*> (px.data);
+
+        if (p == 0) {
+            pxv[0] = w[0] * x[1];
+            pxv[1] = w[0] * x[0] + w[1] * x[2];
+            pxv[2] = w[1] * x[1];
+            return true;
+        } else if (p == 1) {
+            double w2[2];
+            toDense(tx[1], dx);
+            toDense(py[1], w2);
+            pxv[0] += w[0] * x[1] + w2[0] * dx[1];
+            pxv[1] += w[0] * x[0] + w[1] * x[2] + w2[0] * dx[0] + w2[1] * dx[2];
+            pxv[2] += w[1] * x[1] + w2[1] * dx[1];
+            return true;
+        }
+        return false;
+    }
+
+private:
+
+    static void toDense(const Array& a, double* values) {
+        const auto* data = static_cast<const double*> (a.data);
+        if (a.sparse) {
+            std::fill(values, values + a.size, 0.0);
+            for (size_t e = 0; e < a.nnz; e++)
+                values[a.idx[e]] = data[e];
+        } else {
+            std::copy(data, data + a.size, values);
+        }
+    }
+};
+
+}
+
+TEST_F(CppADCGTest, DynamicArrayAtomic) {
+    const size_t m = 2;
+
+    std::vector<double> x{2.0, 3.0, 4.0};
+    std::vector<double> w{1.0, 0.5};
+
+    std::vector<AD<double> > ax(x.begin(), x.end());
+    std::vector<AD<double> > ay(m);
+    ArrayCheckpoint atomic(ax, ay);
+    CGAtomicFun<double> cgAtomic(atomic, x, true);
+
+    // the model uses the atomic function
+    std::vector<ADCGD> u(x.begin(), x.end());
+    CppAD::Independent(u);
+
+    std::vector<ADCGD> v(m);
+    cgAtomic(u, v);
+
+    std::vector<ADCGD> z(m);
+    z[0] = v[0] + u[2];
+    z[1] = v[1] * v[0];
+
+    ADFun<CGD> fun(u, z);
+
+    ModelCSourceGen<double> modelSrc(fun, "arrayAtomicOuter");
+    modelSrc.setCreateForwardZero(true);
+    modelSrc.setCreateSparseJacobian(true);
+    modelSrc.setCreateSparseHessian(true);
+
+    ModelLibraryCSourceGen<double> libSrc(modelSrc);
+    DynamicModelLibraryProcessor<double> p(libSrc);
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> model = dynamicLib->model("arrayAtomicOuter");
+    ASSERT_TRUE(model->addAtomicFunction(atomic));
+
+    std::vector<CGD> xOrig(x.begin(), x.end());
+    std::vector<CGD> wOrig(w.begin(), w.end());
+
+    ASSERT_TRUE(compareValues(model->ForwardZero(x), fun.Forward(0, xOrig)));
+    ASSERT_TRUE(compareValues(model->SparseJacobian(x), fun.SparseJacobian(xOrig)));
+    ASSERT_TRUE(compareValues(model->SparseHessian(x, w), fun.SparseHessian(xOrig, wOrig)));
+
+    // the dense CppAD vectors were not used
+    ASSERT_GT(atomic.arrayCalls, 0u);
+}
@@ -0,0 +1,115 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicCompileBudgetTest : public CppADCGDynamicTest {
+protected:
+    double _budget;
+public:
+
+    inline explicit CppADCGDynamicCompileBudgetTest(double budget = 1e-9) :
+            CppADCGDynamicTest("budget"),
+            _budget(budget) {
+        _xTape = {1, 1, 1};
+        _xRun = {0.5, 1.5, 2.5};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(2);
+        y[0] = x[0] * x[1] * cos(x[2]);
+        y[1] = exp(x[1]) * x[2] + x[0] * x[0];
+        return y;
+    }
+
+    std::unique_ptr<GccCompiler<double>> createCompiler() override {
+        std::unique_ptr<GccCompiler<double>> compiler = CppADCGDynamicTest::createCompiler();
+        compiler->setCompileTimeBudget(_budget);
+        return compiler;
+    }
+};
+
+class CppADCGDynamicLargeCompileBudgetTest : public CppADCGDynamicCompileBudgetTest {
+public:
+
+    inline explicit CppADCGDynamicLargeCompileBudgetTest() :
+            CppADCGDynamicCompileBudgetTest(1e6) {
+    }
+};
+
+/**
+ * A large budget with a calibration where the optimization is very slow
+ */
+class CppADCGDynamicSlowOptimizationBudgetTest : public CppADCGDynamicCompileBudgetTest {
+public:
+
+    inline explicit CppADCGDynamicSlowOptimizationBudgetTest() :
+            CppADCGDynamicCompileBudgetTest(1e3) {
+    }
+
+    std::unique_ptr<GccCompiler<double>> createCompiler() override {
+        std::unique_ptr<GccCompiler<double>> compiler = CppADCGDynamicCompileBudgetTest::createCompiler();
+        compiler->setCompileTimeOptimization(1e3);
+        return compiler;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicLargeCompileBudgetTest, DefaultOptimization) {
+    // all sources use the default flags
+    const std::map<std::string, std::string>& flags = _dynamicLib->getCompileFlags();
+    ASSERT_FALSE(flags.empty());
+    for (const auto& f : flags) {
+        ASSERT_EQ(f.second.find("-O1"), std::string::npos) << f.first;
+    }
+
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicCompileBudgetTest, ReducedOptimization) {
+    // the largest sources use reduced optimization
+    const std::map<std::string, std::string>& flags = _dynamicLib->getCompileFlags();
+    auto it = flags.find("budgetdynamic_sparse_hessian.c");
+    ASSERT_TRUE(it != flags.end());
+    ASSERT_NE(it->second.find("-O1"), std::string::npos);
+    ASSERT_EQ(it->second.find("-O2"), std::string::npos);
+
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicSlowOptimizationBudgetTest, ReducedOptimization) {
+    // the estimated compile times use the calibrated coefficients
+    const std::map<std::string, std::string>& flags = _dynamicLib->getCompileFlags();
+    auto it = flags.find("budgetdynamic_sparse_hessian.c");
+    ASSERT_TRUE(it != flags.end());
+    ASSERT_NE(it->second.find("-O1"), std::string::npos);
+
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicCompileBudgetTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicCompileBudgetTest, Hessian) {
+    this->testHessian();
+}
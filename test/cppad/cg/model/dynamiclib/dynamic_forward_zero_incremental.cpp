@@ -0,0 +1,108 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGForwardZeroIncrementalTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    std::vector<double> _x;
+    std::unique_ptr<ADFun<CGD>> _fun;
+    std::unique_ptr<DynamicLib<double>> _dynamicLib;
+    std::unique_ptr<GenericModel<double>> _model;
+public:
+
+    inline CppADCGForwardZeroIncrementalTest() :
+        _modelName("forward_zero_incremental"),
+        _x{0.5, 1.5, 2.5, -1.0} {
+    }
+
+    template<class T>
+    static std::vector<T> model(const std::vector<T>& x) {
+        std::vector<T> y(7);
+        y[0] = x[0] * x[1];
+        y[1] = sin(x[2]);
+        y[2] = CondExpGt(x[3], T(0), x[2], x[0]); // x[3] has no derivative contribution
+        y[3] = 2.0;
+        y[4] = x[1] + x[2];
+        // a temporary shared by two partitions (the full model is cheaper when both change)
+        T shared = exp(x[2] * x[3]) + cos(x[2] / x[3]);
+        y[5] = shared * x[0];
+        y[6] = shared * x[1];
+        return y;
+    }
+
+    void SetUp() override {
+        std::vector<ADCGD> u(_x.size());
+        for (size_t j = 0; j < _x.size(); j++)
+            u[j] = _x[j];
+        CppAD::Independent(u);
+        std::vector<ADCGD> z = model(u);
+        _fun.reset(new ADFun<CGD>(u, z));
+
+        ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateForwardZeroIncremental(true);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+        DynamicModelLibraryProcessor<double> processor(libSourceGen);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        _dynamicLib = processor.createDynamicLibrary(compiler);
+        _model = _dynamicLib->model(_modelName);
+
+        ASSERT_TRUE(_model->isForwardZeroIncrementalAvailable());
+    }
+
+    void TearDown() override {
+        _model.reset();
+        _dynamicLib.reset();
+        _fun.reset();
+        CppADCGTest::TearDown();
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGForwardZeroIncrementalTest, ForwardZeroIncremental) {
+    std::vector<double> y = _model->ForwardZero(_x);
+    ASSERT_TRUE(compareValues(y, model(_x)));
+
+    std::vector<std::vector<size_t>> changes{{2}, {3}, {0, 1}, {0, 1, 2, 3}};
+
+    std::vector<double> x = _x;
+    for (const auto& changed : changes) {
+        for (size_t j : changed)
+            x[j] += 1.5;
+
+        _model->ForwardZeroIncremental(x, changed, y);
+        ASSERT_TRUE(compareValues(y, model(x)));
+    }
+
+    // nothing changed
+    _model->ForwardZeroIncremental(x, std::vector<size_t>(), y);
+    ASSERT_TRUE(compareValues(y, model(x)));
+}
@@ -0,0 +1,109 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <sys/stat.h>
+
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicLinkTimeOptimizationTest : public CppADCGDynamicTest {
+protected:
+    /**
+     * a script which records the arguments of each compiler call
+     */
+    const std::string _compilerScript = "cppadcg_lto_gcc.sh";
+    /**
+     * the arguments of each compiler call (one call per line)
+     */
+    const std::string _argumentsFile = "cppadcg_lto_gcc_args.txt";
+public:
+
+    inline explicit CppADCGDynamicLinkTimeOptimizationTest() :
+            CppADCGDynamicTest("lto") {
+        _xTape = {1, 1, 1};
+        _xRun = {0.5, 1.5, 2.5};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(3);
+        y[0] = x[0] * x[1] + sin(x[2]);
+        y[1] = x[1] * x[2] * x[2];
+        y[2] = exp(x[0]) - x[2] / x[1];
+        return y;
+    }
+
+    void prepareSourceGen(ModelCSourceGen<double>& modelSourceGen) override {
+        modelSourceGen.setJacobianADMode(JacobianADMode::Forward);
+    }
+
+    std::unique_ptr<GccCompiler<double>> createCompiler() override {
+        std::remove(_argumentsFile.c_str());
+
+        std::ofstream script(_compilerScript);
+        script << "#!/bin/sh\n"
+                  "printf '%s\\n' \"$*\" >> " << _argumentsFile << "\n"
+                  "exec " << CPPAD_CG_C_COMPILER << " \"$@\"\n";
+        script.close();
+        chmod(_compilerScript.c_str(), S_IRWXU);
+
+        std::unique_ptr<GccCompiler<double>> compiler(new GccCompiler<double>("./" + _compilerScript));
+        compiler->setLinkTimeOptimization(true);
+        compiler->setLinkTimeOptimizationJobs(2);
+        return compiler;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicLinkTimeOptimizationTest, CommandLine) {
+    std::ifstream arguments(_argumentsFile);
+    size_t compiled = 0;
+    size_t linked = 0;
+    std::string line;
+    while (std::getline(arguments, line)) {
+        line += " ";
+        if (line.find(" -shared ") != std::string::npos) {
+            // parallel link-time optimization
+            ASSERT_NE(line.find(" -flto=2 "), std::string::npos) << line;
+            linked++;
+        } else if (line.find(" -c ") != std::string::npos) {
+            ASSERT_NE(line.find(" -flto "), std::string::npos) << line;
+            compiled++;
+        } else {
+            continue;
+        }
+        ASSERT_NE(line.find(" -fno-semantic-interposition "), std::string::npos) << line;
+    }
+
+    ASSERT_GT(compiled, 0u);
+    ASSERT_EQ(linked, 1u);
+}
+
+TEST_F(CppADCGDynamicLinkTimeOptimizationTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicLinkTimeOptimizationTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicLinkTimeOptimizationTest, Hessian) {
+    this->testHessian();
+}
@@ -0,0 +1,193 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicParametersTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    std::vector<double> _x;
+    std::vector<double> _p;
+    std::unique_ptr<ADFun<CGD>> _fun;
+    std::unique_ptr<ADFun<double>> _funD;
+    std::unique_ptr<DynamicLib<double>> _dynamicLib;
+    std::unique_ptr<GenericModel<double>> _model;
+public:
+
+    inline CppADCGDynamicParametersTest() :
+        _modelName("dynamic_parameters"),
+        _x{0.5, 1.5},
+        _p{2.0, 3.0} {
+    }
+
+    template<class T>
+    static std::vector<T> model(const std::vector<T>& x,
+                                const std::vector<T>& p) {
+        std::vector<T> y(2);
+        T a = p[0] * p[1]; // dependent dynamic parameter
+        y[0] = p[0] * x[0] * x[0] + sin(x[1]);
+        y[1] = a * x[0] * x[1] + exp(p[1]);
+        return y;
+    }
+
+    void SetUp() override {
+        size_t abort_op_index = 0;
+        bool record_compare = false;
+
+        /**
+         * reference tape
+         */
+        std::vector<AD<double>> ax(_x.size()), ap(_p.size());
+        for (size_t j = 0; j < _x.size(); j++)
+            ax[j] = _x[j];
+        for (size_t j = 0; j < _p.size(); j++)
+            ap[j] = _p[j];
+        CppAD::Independent(ax, abort_op_index, record_compare, ap);
+        std::vector<AD<double>> ay = model(ax, ap);
+        _funD.reset(new ADFun<double>(ax, ay));
+
+        /**
+         * tape for code generation
+         */
+        std::vector<ADCGD> u(_x.size()), q(_p.size());
+        for (size_t j = 0; j < _x.size(); j++)
+            u[j] = _x[j];
+        for (size_t j = 0; j < _p.size(); j++)
+            q[j] = _p[j];
+        CppAD::Independent(u, abort_op_index, record_compare, q);
+        std::vector<ADCGD> z = model(u, q);
+        _fun.reset(new ADFun<CGD>(u, z));
+
+        ModelCSourceGen<double> modelSourceGen(*_fun, _modelName);
+        ASSERT_EQ(modelSourceGen.getDynamicParameterSize(), _p.size());
+
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateJacobian(true);
+        modelSourceGen.setCreateHessian(true);
+        modelSourceGen.setCreateSparseJacobian(true);
+        modelSourceGen.setCreateSparseHessian(true);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+        DynamicModelLibraryProcessor<double> processor(libSourceGen);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        _dynamicLib = processor.createDynamicLibrary(compiler);
+        _model = _dynamicLib->model(_modelName);
+
+        ASSERT_EQ(_model->Domain(), _x.size());
+        ASSERT_EQ(_model->DynamicParameterSize(), _p.size());
+    }
+
+    void TearDown() override {
+        _model.reset();
+        _dynamicLib.reset();
+        _fun.reset();
+        _funD.reset();
+        CppADCGTest::TearDown();
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGDynamicParametersTest, ForwardZero) {
+    std::vector<std::vector<double>> pValues{_p, {-1.0, 0.5}};
+
+    for (const auto& p : pValues) {
+        _funD->new_dynamic(p);
+        std::vector<double> yOrig = _funD->Forward(0, _x);
+
+        std::vector<double> y(_model->Range());
+        _model->ForwardZero(_x, p, y);
+        ASSERT_TRUE(compareValues(y, yOrig));
+
+        // the values of the dynamic parameters are kept
+        ArrayView<const double> pModel = _model->getDynamicParameters();
+        ASSERT_TRUE(compareValues(std::vector<double>(pModel.begin(), pModel.end()), p));
+        ASSERT_TRUE(compareValues(_model->ForwardZero(_x), yOrig));
+    }
+}
+
+TEST_F(CppADCGDynamicParametersTest, DenseJacobian) {
+    std::vector<double> p{-1.0, 0.5};
+    _funD->new_dynamic(p);
+    std::vector<double> jacOrig = _funD->Jacobian(_x);
+
+    std::vector<double> jac(_model->Range() * _model->Domain());
+    _model->Jacobian(_x, p, jac);
+    ASSERT_TRUE(compareValues(jac, jacOrig));
+}
+
+TEST_F(CppADCGDynamicParametersTest, DenseHessian) {
+    std::vector<double> p{-1.0, 0.5};
+    std::vector<double> w{1.0, 2.0};
+    _funD->new_dynamic(p);
+    std::vector<double> hessOrig = _funD->Hessian(_x, w);
+
+    std::vector<double> hess(_model->Domain() * _model->Domain());
+    _model->Hessian(_x, w, p, hess);
+    ASSERT_TRUE(compareValues(hess, hessOrig));
+}
+
+TEST_F(CppADCGDynamicParametersTest, SparseJacobian) {
+    size_t n = _model->Domain();
+    std::vector<double> p{-1.0, 0.5};
+    _funD->new_dynamic(p);
+    std::vector<double> jacOrig = _funD->Jacobian(_x);
+
+    std::vector<size_t> rows, cols;
+    _model->JacobianSparsity(rows, cols);
+    std::vector<double> jac(rows.size());
+    size_t const* row;
+    size_t const* col;
+    _model->SparseJacobian(_x, p, jac, &row, &col);
+
+    std::vector<double> jacSparseOrig(rows.size());
+    for (size_t e = 0; e < rows.size(); ++e)
+        jacSparseOrig[e] = jacOrig[row[e] * n + col[e]];
+
+    ASSERT_TRUE(compareValues(jac, jacSparseOrig));
+}
+
+TEST_F(CppADCGDynamicParametersTest, SparseHessian) {
+    size_t n = _model->Domain();
+    std::vector<double> p{-1.0, 0.5};
+    std::vector<double> w{1.0, 2.0};
+    _funD->new_dynamic(p);
+    std::vector<double> hessOrig = _funD->Hessian(_x, w);
+
+    std::vector<size_t> rows, cols;
+    _model->HessianSparsity(rows, cols);
+    std::vector<double> hess(rows.size());
+    size_t const* row;
+    size_t const* col;
+    _model->SparseHessian(_x, w, p, hess, &row, &col);
+
+    std::vector<double> hessSparseOrig(rows.size());
+    for (size_t e = 0; e < rows.size(); ++e)
+        hessSparseOrig[e] = hessOrig[row[e] * n + col[e]];
+
+    ASSERT_TRUE(compareValues(hess, hessSparseOrig));
+}
@@ -0,0 +1,130 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Waits, after the first source file is written, until that file is
+ * extracted by the compiler
+ */
+class OverlapCheckStream : public SourceFileStream {
+public:
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool firstExtracted = false;
+    bool overlapped = false;
+    size_t written = 0;
+
+    using SourceFileStream::SourceFileStream;
+
+    void write(const std::string& name,
+               const std::string& source) override {
+        SourceFileStream::write(name, source);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (written++ == 0) {
+            overlapped = condition.wait_for(lock, std::chrono::seconds(60), [this]() { return firstExtracted; });
+        }
+    }
+
+    std::string extract(const std::string& name) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            firstExtracted = true;
+            condition.notify_all();
+        }
+        return SourceFileStream::extract(name);
+    }
+};
+
+class CppADCGDynamicSourceStreamTest : public CppADCGDynamicTest {
+protected:
+    const bool _compress;
+    OverlapCheckStream _stream;
+public:
+
+    inline explicit CppADCGDynamicSourceStreamTest() :
+            CppADCGDynamicTest("stream"),
+            _compress(!system::findExecutable("gzip").empty()),
+            _stream("cppadcg_stream_sources", _compress) {
+        _xTape = {1, 1, 1};
+        _xRun = {0.5, 1.5, 2.5};
+        _maxAssignPerFunc = 2; // several files per function
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(3);
+        y[0] = x[0] * x[1] + sin(x[2]);
+        y[1] = x[1] * x[2] * x[2] - cos(x[0] * x[1]);
+        y[2] = exp(x[0]) - x[2] / x[1] + x[0] * x[2];
+        return y;
+    }
+
+    void prepareSourceGen(ModelCSourceGen<double>& modelSourceGen) override {
+        modelSourceGen.setSourceStream(&_stream);
+    }
+
+    void TearDown() override {
+        CppADCGDynamicTest::TearDown();
+        _stream.removeFiles();
+        ASSERT_TRUE(_stream.getFiles().empty());
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicSourceStreamTest, Overlap) {
+    // the first source file was compiled before the other files were generated
+    ASSERT_TRUE(_stream.overlapped);
+    ASSERT_GT(_stream.written, 1u);
+
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicSourceStreamTest, Files) {
+    if (!_compress)
+        std::cerr << "gzip was not found: the compression of the source files is not tested" << std::endl;
+
+    // all model sources were written to disk (compressed)
+    const std::map<std::string, std::string>& files = _stream.getFiles();
+    ASSERT_TRUE(files.find("streamdynamic_forward_zero.c") != files.end());
+    ASSERT_TRUE(files.find("streamdynamic_forward_zero__1.c") != files.end());
+    if (_compress) {
+        for (const auto& f : files) {
+            ASSERT_EQ(f.second.substr(f.second.size() - 3), ".gz") << f.first;
+        }
+    }
+    ASSERT_NE(_stream.read("streamdynamic_forward_zero.c").find("streamdynamic_forward_zero"), std::string::npos);
+
+    // the streamed sources are also saved with the other sources
+    std::ifstream saved(system::createPath("sources_" + _name + "_1", "streamdynamic_forward_zero.c"));
+    std::ostringstream savedSource;
+    savedSource << saved.rdbuf();
+    ASSERT_EQ(savedSource.str(), _stream.read("streamdynamic_forward_zero.c"));
+}
+
+TEST_F(CppADCGDynamicSourceStreamTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicSourceStreamTest, Hessian) {
+    this->testHessian();
+}
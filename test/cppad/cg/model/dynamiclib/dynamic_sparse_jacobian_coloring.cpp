@@ -0,0 +1,197 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGSparseJacobianColoringTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    std::vector<double> _x;
+    std::unique_ptr<ADFun<double>> _funD;
+public:
+
+    inline CppADCGSparseJacobianColoringTest() :
+        _modelName("sparse_jacobian_coloring"),
+        _x(10) {
+        for (size_t j = 0; j < _x.size(); j++)
+            _x[j] = 0.5 + 0.1 * j;
+    }
+
+    /**
+     * A banded model
+     */
+    template<class T>
+    static std::vector<T> model(const std::vector<T>& x) {
+        size_t n = x.size();
+        std::vector<T> y(n - 1);
+        for (size_t i = 0; i < n - 1; i++) {
+            y[i] = x[i] * sin(x[i + 1]) + x[i + 1] * x[i + 1];
+        }
+        return y;
+    }
+
+    void SetUp() override {
+        std::vector<AD<double>> u(_x.size());
+        for (size_t j = 0; j < _x.size(); j++)
+            u[j] = _x[j];
+        CppAD::Independent(u);
+        std::vector<AD<double>> z = model(u);
+        _funD.reset(new ADFun<double>(u, z));
+    }
+
+    void TearDown() override {
+        _funD.reset();
+        CppADCGTest::TearDown();
+    }
+
+    void testColoring(JacobianADMode mode,
+                      bool custom) {
+        std::vector<ADCGD> u(_x.size());
+        for (size_t j = 0; j < _x.size(); j++)
+            u[j] = _x[j];
+        CppAD::Independent(u);
+        std::vector<ADCGD> z = model(u);
+        ADFun<CGD> fun(u, z);
+
+        ModelCSourceGen<double> modelSourceGen(fun, _modelName);
+        modelSourceGen.setCreateSparseJacobian(true);
+        modelSourceGen.setJacobianADMode(mode);
+        modelSourceGen.setSparseJacobianColoring(true);
+        if (custom) {
+            // only the diagonal (in reverse order)
+            std::vector<size_t> row, col;
+            for (size_t i = z.size(); i-- > 0;) {
+                row.push_back(i);
+                col.push_back(i);
+            }
+            modelSourceGen.setCustomSparseJacobianElements(row, col);
+        }
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+        DynamicModelLibraryProcessor<double> processor(libSourceGen);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        std::unique_ptr<DynamicLib<double>> dynamicLib = processor.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<double>> model = dynamicLib->model(_modelName);
+
+        size_t n = _x.size();
+
+        std::vector<double> jacDense = _funD->Jacobian(_x);
+
+        std::vector<double> jac;
+        std::vector<size_t> row, col;
+        model->SparseJacobian(_x, jac, row, col);
+
+        ASSERT_EQ(jac.size(), custom ? z.size() : 2 * z.size());
+        for (size_t e = 0; e < jac.size(); e++) {
+            ASSERT_NEAR(jac[e], jacDense[row[e] * n + col[e]], 1e-10);
+        }
+
+        if (!custom) {
+            ASSERT_TRUE(compareValues(model->SparseJacobian(_x), jacDense));
+        }
+    }
+
+    /**
+     * Requests Jacobian elements which are not in the sparsity pattern,
+     * including elements in an empty row and in an empty column
+     */
+    void testStructuralZeros(JacobianADMode mode) {
+        size_t n = _x.size();
+
+        std::vector<ADCGD> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = _x[j];
+        CppAD::Independent(u);
+        // the last independent variable is not used
+        std::vector<ADCGD> z = model(std::vector<ADCGD>(u.begin(), u.end() - 1));
+        z.push_back(ADCGD(2.0)); // the last row is empty
+        ADFun<CGD> fun(u, z);
+
+        size_t m = z.size();
+
+        std::vector<size_t> row, col;
+        for (size_t i = 0; i < m - 1; i++) {
+            row.push_back(i);
+            col.push_back(i);
+        }
+        row.push_back(0); // structural zero in a non-empty row and column
+        col.push_back(5);
+        row.push_back(m - 1); // empty row
+        col.push_back(0);
+        row.push_back(0); // empty column
+        col.push_back(n - 1);
+
+        ModelCSourceGen<double> modelSourceGen(fun, _modelName);
+        modelSourceGen.setCreateSparseJacobian(true);
+        modelSourceGen.setJacobianADMode(mode);
+        modelSourceGen.setSparseJacobianColoring(true);
+        modelSourceGen.setCustomSparseJacobianElements(row, col);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+        DynamicModelLibraryProcessor<double> processor(libSourceGen);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        std::unique_ptr<DynamicLib<double>> dynamicLib = processor.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<double>> model = dynamicLib->model(_modelName);
+
+        std::vector<double> jac(row.size(), 123.0);
+        std::vector<size_t> jacRow, jacCol;
+        model->SparseJacobian(_x, jac, jacRow, jacCol);
+
+        ASSERT_EQ(jac.size(), row.size());
+        for (size_t e = 0; e < m - 1; e++) {
+            ASSERT_EQ(jacRow[e], e);
+            ASSERT_EQ(jacCol[e], e);
+            double expected = sin(_x[e + 1]);
+            ASSERT_NEAR(jac[e], expected, 1e-10);
+        }
+        for (size_t e = m - 1; e < row.size(); e++) {
+            ASSERT_EQ(jacRow[e], row[e]);
+            ASSERT_EQ(jacCol[e], col[e]);
+            ASSERT_EQ(jac[e], 0.0);
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGSparseJacobianColoringTest, Forward) {
+    testColoring(JacobianADMode::Forward, false);
+    testColoring(JacobianADMode::Forward, true);
+}
+
+TEST_F(CppADCGSparseJacobianColoringTest, Reverse) {
+    testColoring(JacobianADMode::Reverse, false);
+    testColoring(JacobianADMode::Reverse, true);
+}
+
+TEST_F(CppADCGSparseJacobianColoringTest, StructuralZeros) {
+    testStructuralZeros(JacobianADMode::Forward);
+    testStructuralZeros(JacobianADMode::Reverse);
+}
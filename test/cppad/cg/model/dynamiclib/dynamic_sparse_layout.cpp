@@ -0,0 +1,166 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGSparseLayoutTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    std::vector<double> _x;
+    std::vector<double> _w;
+    std::unique_ptr<ADFun<double>> _funD;
+public:
+
+    inline CppADCGSparseLayoutTest() :
+        _modelName("sparse_layout"),
+        _x{0.5, 1.5, 2.5, -1.0},
+        _w{1.0, 2.0, 3.0} {
+    }
+
+    template<class T>
+    static std::vector<T> model(const std::vector<T>& x) {
+        std::vector<T> y(3);
+        y[0] = x[3] * x[1] + x[0];
+        y[1] = sin(x[2]) * x[0];
+        y[2] = x[1] * x[1] + x[3] * x[2];
+        return y;
+    }
+
+    void SetUp() override {
+        std::vector<AD<double>> u(_x.size());
+        for (size_t j = 0; j < _x.size(); j++)
+            u[j] = _x[j];
+        CppAD::Independent(u);
+        std::vector<AD<double>> z = model(u);
+        _funD.reset(new ADFun<double>(u, z));
+    }
+
+    void TearDown() override {
+        _funD.reset();
+        CppADCGTest::TearDown();
+    }
+
+    void testLayout(SparseMatrixLayout jacLayout,
+                    SparseMatrixLayout hessLayout,
+                    MatrixTriangle triangle,
+                    bool reuse) {
+        std::vector<ADCGD> u(_x.size());
+        for (size_t j = 0; j < _x.size(); j++)
+            u[j] = _x[j];
+        CppAD::Independent(u);
+        std::vector<ADCGD> z = model(u);
+        ADFun<CGD> fun(u, z);
+
+        ModelCSourceGen<double> modelSourceGen(fun, _modelName);
+        modelSourceGen.setCreateSparseJacobian(true);
+        modelSourceGen.setCreateSparseHessian(true);
+        modelSourceGen.setCreateForwardOne(reuse);
+        modelSourceGen.setCreateReverseOne(reuse);
+        modelSourceGen.setCreateReverseTwo(reuse);
+        modelSourceGen.setSparseJacobianLayout(jacLayout);
+        modelSourceGen.setSparseHessianLayout(hessLayout, triangle);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+        DynamicModelLibraryProcessor<double> processor(libSourceGen);
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        std::unique_ptr<DynamicLib<double>> dynamicLib = processor.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<double>> model = dynamicLib->model(_modelName);
+
+        size_t n = _x.size();
+
+        /**
+         * Jacobian
+         */
+        std::vector<double> jacDense = _funD->Jacobian(_x);
+
+        std::vector<double> jac;
+        std::vector<size_t> row, col;
+        model->SparseJacobian(_x, jac, row, col);
+
+        for (size_t e = 0; e < jac.size(); e++) {
+            ASSERT_NEAR(jac[e], jacDense[row[e] * n + col[e]], 1e-10);
+        }
+
+        std::vector<size_t> start, indexes;
+        if (jacLayout == SparseMatrixLayout::CSR) {
+            model->JacobianSparsityCSR(start, indexes);
+            ASSERT_EQ(indexes, col);
+            for (size_t i = 0; i < model->Range(); i++) {
+                for (size_t e = start[i]; e < start[i + 1]; e++)
+                    ASSERT_EQ(row[e], i);
+            }
+        } else if (jacLayout == SparseMatrixLayout::CSC) {
+            model->JacobianSparsityCSC(start, indexes);
+            ASSERT_EQ(indexes, row);
+            for (size_t j = 0; j < n; j++) {
+                for (size_t e = start[j]; e < start[j + 1]; e++)
+                    ASSERT_EQ(col[e], j);
+            }
+        }
+
+        /**
+         * Hessian
+         */
+        std::vector<double> hessDense = _funD->Hessian(_x, _w);
+
+        std::vector<double> hess;
+        model->SparseHessian(_x, _w, hess, row, col);
+
+        for (size_t e = 0; e < hess.size(); e++) {
+            ASSERT_NEAR(hess[e], hessDense[row[e] * n + col[e]], 1e-10);
+            if (triangle == MatrixTriangle::Lower) {
+                ASSERT_GE(row[e], col[e]);
+            } else if (triangle == MatrixTriangle::Upper) {
+                ASSERT_LE(row[e], col[e]);
+            }
+        }
+
+        if (hessLayout == SparseMatrixLayout::CSR) {
+            model->HessianSparsityCSR(start, indexes);
+            ASSERT_EQ(indexes, col);
+        } else if (hessLayout == SparseMatrixLayout::CSC) {
+            model->HessianSparsityCSC(start, indexes);
+            ASSERT_EQ(indexes, row);
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+using namespace std;
+
+TEST_F(CppADCGSparseLayoutTest, CSR) {
+    testLayout(SparseMatrixLayout::CSR, SparseMatrixLayout::CSR, MatrixTriangle::Upper, false);
+    testLayout(SparseMatrixLayout::CSR, SparseMatrixLayout::CSR, MatrixTriangle::Upper, true);
+}
+
+TEST_F(CppADCGSparseLayoutTest, CSC) {
+    testLayout(SparseMatrixLayout::CSC, SparseMatrixLayout::CSC, MatrixTriangle::Lower, false);
+    testLayout(SparseMatrixLayout::CSC, SparseMatrixLayout::CSC, MatrixTriangle::Lower, true);
+}
+
+TEST_F(CppADCGSparseLayoutTest, Full) {
+    testLayout(SparseMatrixLayout::CSC, SparseMatrixLayout::CSR, MatrixTriangle::Full, true);
+}
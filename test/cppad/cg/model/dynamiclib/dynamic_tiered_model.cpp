@@ -0,0 +1,200 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <future>
+
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicTieredModelTest : public CppADCGDynamicTest {
+public:
+
+    inline explicit CppADCGDynamicTieredModelTest() :
+            CppADCGDynamicTest("tiered") {
+        _xTape = {1, 1, 1};
+        _xRun = {0.5, 1.5, 2.5};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(2);
+        y[0] = x[0] * x[1] + sin(x[2]);
+        y[1] = x[1] * x[2] * x[2] - exp(x[0]);
+        return y;
+    }
+
+    std::unique_ptr<GenericModel<double>> createModel(DynamicModelLibraryProcessor<double>& p,
+                                                    GccCompiler<double>& compiler) override {
+        compiler.setTemporaryFolder("cppadcg_tmp_fast");
+
+        std::shared_ptr<CCompiler<double>> optimizedCompiler(new GccCompiler<double>(CPPAD_CG_C_COMPILER));
+
+        return p.createTieredModel(_name + "dynamic", compiler, optimizedCompiler);
+    }
+
+    TieredGenericModel<double>& tieredModel() {
+        return dynamic_cast<TieredGenericModel<double>&>(*_model);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+template<class T>
+std::vector<T> tieredInnerModel(const std::vector<T>& x) {
+    std::vector<T> y(2);
+    y[0] = x[0] * x[1];
+    y[1] = sin(x[1]) + x[0];
+    return y;
+}
+
+template<class T>
+std::vector<T> tieredOuterModel(const std::vector<T>& y1,
+                                const std::vector<T>& y2,
+                                const std::vector<T>& p) {
+    std::vector<T> z(2);
+    z[0] = p[0] * y1[0] + y2[1];
+    z[1] = y1[1] * y2[0] - p[1];
+    return z;
+}
+
+}
+
+TEST_F(CppADCGDynamicTieredModelTest, Optimized) {
+    // usable before the optimized library is ready
+    // (the optimized build must not depend on the processor or on the source generators)
+    this->testForwardZero();
+    this->testJacobian();
+
+    tieredModel().waitForOptimized();
+    ASSERT_TRUE(tieredModel().isBuildFinished());
+    ASSERT_TRUE(tieredModel().isOptimized());
+
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicTieredModelTest, Jacobian) {
+    tieredModel().waitForOptimized();
+    ASSERT_TRUE(tieredModel().isOptimized());
+
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicTieredModelTest, Hessian) {
+    tieredModel().waitForOptimized();
+    ASSERT_TRUE(tieredModel().isOptimized());
+
+    this->testHessian();
+}
+
+TEST_F(CppADCGTest, DynamicTieredModelReplay) {
+    size_t abort_op_index = 0;
+    bool record_compare = false;
+    std::vector<double> x{0.5, 1.5};
+    std::vector<double> p{2.0, 3.0};
+
+    /**
+     * inner models (used as atomic functions)
+     */
+    std::vector<ADCGD> uInner(x.begin(), x.end());
+    CppAD::Independent(uInner);
+    std::vector<ADCGD> zInner = tieredInnerModel(uInner);
+    ADFun<CGD> funInner(uInner, zInner);
+
+    ModelCSourceGen<double> inner1SourceGen(funInner, "tiered_inner1");
+    ModelCSourceGen<double> inner2SourceGen(funInner, "tiered_inner2");
+    for (ModelCSourceGen<double>* innerSourceGen : {&inner1SourceGen, &inner2SourceGen}) {
+        innerSourceGen->setCreateForwardZero(true);
+        innerSourceGen->setCreateForwardOne(true);
+        innerSourceGen->setCreateReverseOne(true);
+        innerSourceGen->setCreateReverseTwo(true);
+        innerSourceGen->setCreateSparseJacobian(true);
+    }
+
+    ModelLibraryCSourceGen<double> innerLibSourceGen(inner1SourceGen, inner2SourceGen);
+    DynamicModelLibraryProcessor<double> innerProcessor(innerLibSourceGen, "cppad_cg_tiered_inner");
+
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    std::unique_ptr<DynamicLib<double>> innerLib = innerProcessor.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<double>> inner1 = innerLib->model("tiered_inner1");
+    std::unique_ptr<GenericModel<double>> inner2 = innerLib->model("tiered_inner2");
+
+    /**
+     * outer model with atomic functions and dynamic parameters
+     */
+    std::vector<ADCGD> u(x.begin(), x.end()), q(p.begin(), p.end());
+    CppAD::Independent(u, abort_op_index, record_compare, q);
+    CGAtomicFunBridge<double> atomic1("tiered_inner1", funInner, true);
+    CGAtomicFunBridge<double> atomic2("tiered_inner2", funInner, true);
+    std::vector<ADCGD> y1(2), y2(2);
+    atomic1(u, y1);
+    atomic2(u, y2);
+    std::vector<ADCGD> z = tieredOuterModel(y1, y2, q);
+    ADFun<CGD> fun(u, z);
+
+    std::vector<AD<double> > ax(x.begin(), x.end()), ap(p.begin(), p.end());
+    CppAD::Independent(ax, abort_op_index, record_compare, ap);
+    std::vector<AD<double> > ay1 = tieredInnerModel(ax);
+    std::vector<AD<double> > ay = tieredOuterModel(ay1, ay1, ap);
+    ADFun<double> funD(ax, ay);
+    funD.new_dynamic(p);
+
+    ModelCSourceGen<double> modelSourceGen(fun, "tiered_replay");
+    modelSourceGen.setCreateForwardZero(true);
+    modelSourceGen.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+    DynamicModelLibraryProcessor<double> processor(libSourceGen, "cppad_cg_tiered_replay_fast");
+
+    std::unique_ptr<DynamicLib<double>> fastLib = processor.createDynamicLibrary(compiler);
+    processor.setLibraryName("cppad_cg_tiered_replay");
+
+    /**
+     * the optimized library is only built after the model is configured
+     */
+    std::promise<void> configured;
+    std::shared_future<void> configuredFuture = configured.get_future().share();
+    GccCompiler<double> optimizedCompiler(CPPAD_CG_C_COMPILER);
+
+    TieredGenericModel<double> model(std::move(fastLib), "tiered_replay", [&]() {
+        configuredFuture.wait();
+        return processor.createDynamicLibrary(optimizedCompiler);
+    });
+
+    EXPECT_TRUE(model.addAtomicFunction(inner1->asAtomic()));
+    EXPECT_TRUE(model.addExternalModel(*inner2));
+    model.setDynamicParameters(ArrayView<const double>(p));
+
+    EXPECT_FALSE(model.isOptimized());
+    EXPECT_TRUE(compareValues(model.ForwardZero(x), funD.Forward(0, x)));
+
+    configured.set_value();
+
+    // the atomic functions, external models, and dynamic parameters must be defined in the optimized model
+    model.waitForOptimized();
+    ASSERT_TRUE(model.isOptimized());
+
+    ArrayView<const double> pModel = model.getDynamicParameters();
+    ASSERT_TRUE(compareValues(std::vector<double>(pModel.begin(), pModel.end()), p));
+    ASSERT_TRUE(compareValues(model.ForwardZero(x), funD.Forward(0, x)));
+    ASSERT_TRUE(compareValues(model.SparseJacobian(x), funD.SparseJacobian(x)));
+}
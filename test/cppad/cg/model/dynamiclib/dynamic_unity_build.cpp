@@ -0,0 +1,121 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Registers the number of source and object files used to build a library
+ */
+class UnityCountCompiler : public GccCompiler<double> {
+protected:
+    size_t& _sourceFiles;
+    size_t& _objectFiles;
+public:
+
+    UnityCountCompiler(const std::string& gccPath,
+                       size_t& sourceFiles,
+                       size_t& objectFiles) :
+            GccCompiler<double>(gccPath),
+            _sourceFiles(sourceFiles),
+            _objectFiles(objectFiles) {
+    }
+
+    void buildDynamic(const std::string& library,
+                      JobTimer* timer = nullptr) override {
+        _sourceFiles = this->getSourceFiles().size();
+        _objectFiles = this->getObjectFiles().size();
+        GccCompiler<double>::buildDynamic(library, timer);
+    }
+};
+
+class CppADCGDynamicUnityBuildTest : public CppADCGDynamicTest {
+protected:
+    size_t _sourceFiles = 0;
+    size_t _objectFiles = 0;
+public:
+
+    inline explicit CppADCGDynamicUnityBuildTest() :
+            CppADCGDynamicTest("unity") {
+        _xTape = {1, 1, 1};
+        _xRun = {0.5, 1.5, 2.5};
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(3);
+        y[0] = x[0] * x[1] + sin(x[2]);
+        y[1] = x[1] * x[2] * x[2];
+        y[2] = exp(x[0]) - x[1];
+        return y;
+    }
+
+    std::unique_ptr<GccCompiler<double>> createCompiler() override {
+        std::unique_ptr<GccCompiler<double>> compiler(new UnityCountCompiler(CPPAD_CG_C_COMPILER, _sourceFiles, _objectFiles));
+        compiler->setUnityBuildMaxSize(1000000);
+        return compiler;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGTest, DynamicUnityBuildGrouping) {
+    std::map<std::string, std::string> sources;
+    sources["unity_a.c"] = "int unity_a(void) {\n   static int v = 1;\n   return v;\n}\n";
+    sources["unity_b.c"] = "int unity_b(void) {\n   return 2;\n}\n";
+    sources["unity_c.c"] = "static int v = 3;\nint unity_c(void) {\n   return v;\n}\n";
+    sources["unity_d.c"] = "static int v = 4;\nint unity_d(void) {\n   return v;\n}\n";
+    // file scope declarations which do not start a line (would clash in the same translation unit)
+    sources["unity_e.c"] = "int unity_e(void) {\n   return 5;\n}\n   static int w = 5;\n";
+    sources["unity_f.c"] = "const static int w = 6;\nint unity_f(void) {\n   return w;\n}\n";
+    // type definitions protected by an include guard
+    sources["unity_g.c"] = "#ifndef UNITY_S_DEFINED\n#define UNITY_S_DEFINED\nstruct UnityS {\n   int v;\n};\n#endif\n"
+                           "int unity_g(struct UnityS* s) {\n   return s->v;\n}\n";
+    sources["unity_h.c"] = "#ifndef UNITY_S_DEFINED\n#define UNITY_S_DEFINED\nstruct UnityS {\n   int v;\n};\n#endif\n"
+                           "int unity_h(const struct UnityS* s) {\n   return s->v + 1;\n}\n";
+
+    GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+    compiler.setTemporaryFolder("cppadcg_unity_tmp");
+    compiler.setUnityBuildMaxSize(1024);
+
+    compiler.compileSources(sources, true);
+
+    // unity_a.c, unity_b.c, unity_g.c, and unity_h.c are compiled together
+    ASSERT_EQ(compiler.getSourceFiles().size(), 8u);
+    ASSERT_EQ(compiler.getObjectFiles().size(), 5u);
+
+    compiler.cleanup();
+}
+
+TEST_F(CppADCGDynamicUnityBuildTest, ForwardZero) {
+    // the generated sources were merged into fewer translation units
+    ASSERT_GT(_sourceFiles, 0u);
+    ASSERT_LT(_objectFiles, _sourceFiles);
+
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicUnityBuildTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicUnityBuildTest, Hessian) {
+    this->testHessian();
+}
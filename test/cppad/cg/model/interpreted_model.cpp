@@ -0,0 +1,142 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+template<class T>
+std::vector<T> interpretedModel(const std::vector<T>& x) {
+    std::vector<T> y(3);
+    y[0] = exp(x[0]) * sin(x[1]) + x[2] / (1.0 + x[0] * x[0]);
+    y[1] = CondExpLt(x[0], x[1], pow(x[1], 2.0), sqrt(x[2])) - 3.0;
+    y[2] = log(x[2]) * x[1] + tanh(x[0]);
+    return y;
+}
+
+}
+
+TEST_F(CppADCGTest, InterpretedModel) {
+    const size_t n = 3;
+    const size_t m = 3;
+
+    std::vector<double> x{0.5, 1.5, 2.0};
+    std::vector<double> w{1.0, 2.0, 0.5};
+
+    /**
+     * reference
+     */
+    std::vector<AD<double> > ax(x.begin(), x.end());
+    CppAD::Independent(ax);
+    ADFun<double> funD(ax, interpretedModel(ax));
+
+    /**
+     * interpreted model
+     */
+    std::vector<ADCGD> u(x.begin(), x.end());
+    CppAD::Independent(u);
+    ADFun<CGD> fun(u, interpretedModel(u));
+
+    InterpretedModel<double> interpreted(fun, "model");
+    GenericModel<double>& model = interpreted;
+
+    ASSERT_EQ(model.Domain(), n);
+    ASSERT_EQ(model.Range(), m);
+
+    // zero order
+    ASSERT_TRUE(compareValues(model.ForwardZero(x), funD.Forward(0, x)));
+
+    // dense derivatives
+    ASSERT_TRUE(compareValues(model.Jacobian(x), funD.Jacobian(x)));
+    ASSERT_TRUE(compareValues(model.Hessian(x, w), funD.Hessian(x, w)));
+
+    // sparse derivatives
+    ASSERT_TRUE(compareValues(model.SparseJacobian(x), funD.Jacobian(x)));
+    ASSERT_TRUE(compareValues(model.SparseHessian(x, w), funD.Hessian(x, w)));
+
+    // first order forward mode
+    std::vector<double> dx{1.0, 0.0, -1.0};
+    std::vector<double> tx(2 * n), ty(2 * m);
+    for (size_t j = 0; j < n; j++) {
+        tx[2 * j] = x[j];
+        tx[2 * j + 1] = dx[j];
+    }
+    model.ForwardOne(tx, ty);
+
+    funD.Forward(0, x);
+    std::vector<double> dy = funD.Forward(1, dx);
+    for (size_t i = 0; i < m; i++) {
+        ASSERT_NEAR(ty[2 * i + 1], dy[i], 1e-12);
+    }
+
+    // first order reverse mode
+    std::vector<double> px(n), py(w);
+    model.ReverseOne(x, std::vector<double>(m), px, py);
+    funD.Forward(0, x);
+    ASSERT_TRUE(compareValues(px, funD.Reverse(1, w)));
+
+    // second order reverse mode
+    std::vector<double> py2(2 * m), px2(2 * n);
+    for (size_t i = 0; i < m; i++) {
+        py2[2 * i + 1] = w[i];
+    }
+    model.ReverseTwo(tx, ty, px2, py2);
+
+    funD.Forward(0, x);
+    funD.Forward(1, dx);
+    std::vector<double> pxD = funD.Reverse(2, py2);
+    for (size_t j = 0; j < n; j++) {
+        ASSERT_NEAR(px2[2 * j], pxD[2 * j], 1e-12);
+    }
+
+    // the other branch of the conditional expression
+    std::vector<double> x2{2.0, 1.0, 3.0};
+    ASSERT_TRUE(compareValues(model.ForwardZero(x2), funD.Forward(0, x2)));
+}
+
+TEST_F(CppADCGTest, BytecodeFunctionRegisters) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+
+    // a long sequence of operations only requires a few temporary registers
+    CGD a = x[0];
+    for (size_t i = 0; i < 100; i++) {
+        a = a * x[1] + 1.0;
+    }
+
+    std::vector<CGD> y{a, CGD(2.0), x[0]};
+
+    BytecodeFunction<double> fun(handler, y);
+    ASSERT_EQ(fun.getOperationCount(), 200u);
+    // 2 independents + 2 constants (1.0 and 2.0) + 1 temporary
+    ASSERT_EQ(fun.getRegisterCount(), 5u);
+
+    std::vector<double> xv{0.5, 0.9};
+    std::vector<double> yv(3);
+    fun.evaluate(xv, yv);
+
+    double expected = xv[0];
+    for (size_t i = 0; i < 100; i++) {
+        expected = expected * xv[1] + 1.0;
+    }
+
+    ASSERT_NEAR(yv[0], expected, 1e-12);
+    ASSERT_EQ(yv[1], 2.0);
+    ASSERT_EQ(yv[2], xv[0]);
+}
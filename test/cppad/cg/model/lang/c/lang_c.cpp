@@ -17,6 +17,7 @@
 #include <fstream>
 
 #include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
 #include <cppad/cg/cppadcg.hpp>
 #include <cppad/cg/lang/dot/dot.hpp>
 #include <cppad/cg/lang/c/lang_c_default_var_name_gen.hpp>
@@ -71,6 +72,125 @@ public:
         ASSERT_EQ(sources.size(), expectedNumberOfSources);
     }
 
+    void testAutomaticSplitting(size_t maxOperationsPerFunction,
+                                bool expectSplit) {
+        ADFun<CGD> fun = model();
+
+        CodeHandler<double> handler;
+
+        CppAD::vector<CGD> indVars(5);
+        handler.makeVariables(indVars);
+
+        CppAD::vector<CGD> vals = fun.Forward(0, indVars);
+
+        LanguageC<double> langC("double");
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+
+        std::map<std::string, std::string> sources;
+        langC.setMaxAssignmentsPerFunction(0, &sources);
+        langC.setMaxOperationsPerFunction(maxOperationsPerFunction);
+        langC.setGenerateFunction("auto_split_model");
+
+        handler.generateCode(code, langC, vals, nameGen);
+
+        if (this->verbose_) {
+            printSources(sources);
+        }
+
+        const std::vector<size_t>& operations = langC.getFunctionOperations();
+        const std::vector<size_t>& boundaryValues = langC.getFunctionBoundaryValues();
+        if (expectSplit) {
+            ASSERT_GT(sources.size(), 1u);
+            ASSERT_EQ(operations.size(), sources.size());
+            ASSERT_EQ(boundaryValues.size(), sources.size());
+            ASSERT_EQ(boundaryValues[0], 0u);
+        } else {
+            ASSERT_TRUE(sources.empty());
+            ASSERT_TRUE(operations.empty());
+        }
+
+        /**
+         * evaluate the generated code using a dynamic library
+         */
+        std::string modelName = "auto_split_model";
+        ModelCSourceGen<double> modelSourceGen(fun, modelName);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setMaxOperationsPerFunc(maxOperationsPerFunction);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+        DynamicModelLibraryProcessor<double> processor(libSourceGen, "lang_c_" + modelName + std::to_string(maxOperationsPerFunction));
+
+        GccCompiler<double> compiler(CPPAD_CG_C_COMPILER);
+        prepareTestCompilerFlags(compiler);
+
+        std::unique_ptr<DynamicLib<double>> dynamicLib = processor.createDynamicLibrary(compiler);
+        std::unique_ptr<GenericModel<double>> genModel = dynamicLib->model(modelName);
+
+        std::vector<double> x{0.5, 0.5, 0.0, -0.5, 0.0};
+
+        std::vector<CGD> xCG(x.begin(), x.end());
+        std::vector<CGD> yCG = fun.Forward(0, xCG);
+        std::vector<double> expected(yCG.size());
+        for (size_t i = 0; i < yCG.size(); i++)
+            expected[i] = yCG[i].getValue();
+
+        std::vector<double> y = genModel->ForwardZero(x);
+        ASSERT_TRUE(compareValues(y, expected));
+    }
+
+    /**
+     * Uses a chain of variables where two values cross each position of
+     * the variable order except for a narrow section, in the last half of
+     * the first function, where only one value crosses.
+     */
+    void testAutomaticSplittingNarrowCut() {
+        const size_t nVars = 30;
+        const size_t narrow = 13;
+
+        CppAD::vector<ADCG> x(5);
+        Independent(x);
+
+        std::vector<ADCG> v(nVars);
+        v[0] = x[0] * x[1];
+        v[1] = x[1] * x[2];
+        for (size_t k = 2; k < nVars; k++) {
+            if (k == narrow || k == narrow + 1)
+                v[k] = v[k - 1] * v[k - 1] + x[k % 5]; // only the previous variable is used
+            else
+                v[k] = v[k - 1] * v[k - 2] + x[k % 5];
+        }
+
+        CppAD::vector<ADCG> y(1);
+        y[0] = v[nVars - 1];
+
+        ADFun<CGD> fun(x, y);
+
+        CodeHandler<double> handler;
+
+        CppAD::vector<CGD> indVars(5);
+        handler.makeVariables(indVars);
+
+        CppAD::vector<CGD> vals = fun.Forward(0, indVars);
+
+        LanguageC<double> langC("double");
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+
+        std::map<std::string, std::string> sources;
+        langC.setMaxAssignmentsPerFunction(0, &sources);
+        langC.setMaxOperationsPerFunction(48);
+        langC.setGenerateFunction("narrow_cut_model");
+
+        handler.generateCode(code, langC, vals, nameGen);
+
+        const std::vector<size_t>& boundaryValues = langC.getFunctionBoundaryValues();
+        ASSERT_EQ(boundaryValues.size(), 2u);
+        ASSERT_EQ(boundaryValues[1], 1u); // the narrow section is preferred over a fuller first function
+    }
+
 protected:
     inline static ADFun<CGD> model() {
         // independent variable vector
@@ -137,4 +257,19 @@ TEST_F(CppADCGTestLangC, maxOperationPerAssign1) {
     testNumberOfSources(2u,
                         1u,
                         11u);
-}
\ No newline at end of file
+}
+
+TEST_F(CppADCGTestLangC, maxOperationsPerFunc) {
+
+    testAutomaticSplitting(8u, true);
+}
+
+TEST_F(CppADCGTestLangC, maxOperationsPerFuncNoSplit) {
+
+    testAutomaticSplitting(100000u, false);
+}
+
+TEST_F(CppADCGTestLangC, maxOperationsPerFuncNarrowCut) {
+
+    testAutomaticSplittingNarrowCut();
+}
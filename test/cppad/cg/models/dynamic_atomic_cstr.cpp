@@ -150,6 +150,14 @@ TEST_F(CppADCGDynamicAtomicCstrTest, AtomicLibModelBridge) {
     this->testAtomicLibModelBridge(x, xNorm, eqNorm, 1e-14, 1e-13);
 }
 
+TEST_F(CppADCGDynamicAtomicCstrTest, AtomicLibModelBridgeNotDirect) {
+    this->testAtomicLibModelBridgeNotDirect(x, xNorm, eqNorm, 1e-14, 1e-13);
+}
+
+TEST_F(CppADCGDynamicAtomicCstrTest, AtomicLibModelBridgeZeroOrderInner) {
+    this->testAtomicLibModelBridgeZeroOrderInner(x, xNorm, eqNorm, 1e-14, 1e-13);
+}
+
 TEST_F(CppADCGDynamicAtomicCstrTest, AtomicLibModelBridgeCustomRev2) {
     this->testAtomicLibModelBridgeCustom(x, xNorm, eqNorm,
                                          jacInner, hessInner,
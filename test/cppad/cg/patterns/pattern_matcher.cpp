@@ -579,4 +579,113 @@ TEST_F(CppADCGPatternTest, modelWrongEqs) {
     setModel(modelWrongEqs);
     testPatternDetection(m, n, repeat, loops);
     testLibCreation("modelWrongEqs", m, n, repeat);
-}
\ No newline at end of file
+}
+
+TEST_F(CppADCGPatternTest, StructuralFingerprint) {
+    CodeHandler<double> handler;
+    std::vector<CGD> x(4);
+    handler.makeVariables(x);
+
+    CGD y0 = x[0] * sin(x[1]) + 2.0;
+    CGD y1 = x[2] * sin(x[3]) + 3.0; // different constant but same structure
+    CGD y2 = x[0] * cos(x[1]) + 2.0;
+    CGD y3 = sin(x[1]) * x[0] + 2.0;
+
+    CodeHandlerVector<double, size_t> fingerprints(handler);
+    fingerprints.adjustSize();
+    handler.startNewOperationTreeVisit();
+
+    size_t f0 = EquationPattern<double>::structuralFingerprint(y0, fingerprints);
+    ASSERT_EQ(f0, EquationPattern<double>::structuralFingerprint(y1, fingerprints));
+    ASSERT_NE(f0, EquationPattern<double>::structuralFingerprint(y2, fingerprints));
+    ASSERT_NE(f0, EquationPattern<double>::structuralFingerprint(y3, fingerprints));
+}
+
+TEST_F(CppADCGPatternTest, AutomaticRelatedDependents) {
+    size_t m = 2;
+    size_t n = 2;
+    size_t repeat = 6;
+
+    setModel(model0);
+
+    std::vector<Base> xb(n * repeat);
+    for (size_t j = 0; j < xb.size(); j++)
+        xb[j] = 0.5 * (j + 1);
+
+    std::unique_ptr<ADFun<CGD> > fun(tapeModel(repeat, xb));
+
+    /**
+     * candidates
+     */
+    CodeHandler<Base> handler;
+    std::vector<CGD> xx(xb.size());
+    handler.makeVariables(xx);
+    std::vector<CGD> yy = fun->Forward(0, xx);
+
+    std::vector<std::set<size_t> > candidates = DependentPatternMatcher<Base>::findRelatedDependentCandidates(yy);
+    ASSERT_EQ(candidates, createRelatedDepCandidates(m, repeat));
+
+    /**
+     * loops in the generated model
+     */
+    ModelCSourceGen<Base> modelSourceGen(*fun, "auto_loops");
+    modelSourceGen.setAutomaticRelatedDependents(true);
+
+    ModelLibraryCSourceGen<Base> libSourceGen(modelSourceGen);
+    DynamicModelLibraryProcessor<Base> processor(libSourceGen, "auto_loops");
+
+    GccCompiler<Base> compiler(CPPAD_CG_C_COMPILER);
+    prepareTestCompilerFlags(compiler);
+
+    std::unique_ptr<DynamicLib<Base> > dynamicLib = processor.createDynamicLibrary(compiler);
+    std::unique_ptr<GenericModel<Base> > model = dynamicLib->model("auto_loops");
+
+    ASSERT_EQ(modelSourceGen.getLoops().size(), 1u);
+    ASSERT_GT(modelSourceGen.getEstimatedLoopSavings(), 0u);
+
+    std::vector<CGD> xcg(xb.begin(), xb.end());
+    std::vector<CGD> ycg = fun->Forward(0, xcg);
+    std::vector<Base> y = model->ForwardZero(xb);
+    ASSERT_EQ(y.size(), ycg.size());
+    for (size_t i = 0; i < y.size(); i++) {
+        ASSERT_NEAR(y[i], ycg[i].getValue(), 1e-10);
+    }
+}
+
+TEST_F(CppADCGPatternTest, ParallelPatternDetection) {
+    size_t m = 2;
+    size_t n = 2;
+    size_t repeat = 8;
+
+    setModel(model0);
+
+    std::vector<Base> xb(n * repeat, 0.5);
+    std::unique_ptr<ADFun<CGD> > fun(tapeModel(repeat, xb));
+    std::vector<std::set<size_t> > depCandidates = createRelatedDepCandidates(m, repeat);
+
+    auto detect = [&](size_t threads) {
+        CodeHandler<Base> h;
+        std::vector<CGD> xx(fun->Domain());
+        h.makeVariables(xx);
+        std::vector<CGD> yy = fun->Forward(0, xx);
+
+        DependentPatternMatcher<Base> matcher(depCandidates, yy, xx);
+        matcher.setThreadCount(threads);
+
+        LoopFreeModel<Base>* nonLoopTape;
+        SmartSetPointer<LoopModel<Base> > loopTapes;
+        matcher.generateTapes(nonLoopTape, loopTapes.s);
+        delete nonLoopTape;
+
+        std::vector<std::set<size_t> > patterns;
+        for (const EquationPattern<Base>* eq : matcher.getEquationPatterns()) {
+            patterns.push_back(eq->dependents);
+        }
+        return patterns;
+    };
+
+    std::vector<std::set<size_t> > patterns1 = detect(1);
+    ASSERT_EQ(patterns1, depCandidates);
+    ASSERT_EQ(detect(4), patterns1);
+    ASSERT_EQ(detect(0), patterns1);
+}
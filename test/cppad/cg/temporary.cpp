@@ -12,12 +12,12 @@
  * ----------------------------------------------------------------------------
  * Author: Joao Leal
  */
-#include "CppADCGTest.hpp"
+#include "CppADCGOperationTest.hpp"
 
 namespace CppAD {
 namespace cg {
 
-class CppADCGTempTest : public CppADCGTest {
+class CppADCGTempTest : public CppADCGOperationTest {
 protected:
     using CGD = CppADCGTest::CGD;
     using ADCGD = CppADCGTest::ADCGD;
@@ -25,18 +25,20 @@ public:
 
     inline CppADCGTempTest(bool verbose = false,
                            bool printValues = false) :
-        CppADCGTest(verbose, printValues) {
+        CppADCGOperationTest(verbose, printValues) {
     }
 
     void testModel(ADFun<CGD>& f,
                    size_t expectedTmp,
-                   size_t expectedArraySize) {
+                   size_t expectedArraySize,
+                   bool registerPressureScheduling = false) {
         using CppAD::vector;
 
         size_t n = f.Domain();
         //size_t m = f.Range();
 
         CodeHandler<double> handler(10 + n * n);
+        handler.setRegisterPressureScheduling(registerPressureScheduling);
 
         vector<CGD> indVars(n);
         handler.makeVariables(indVars);
@@ -51,6 +53,59 @@ public:
         ASSERT_EQ(handler.getTemporaryVariableCount(), expectedTmp);
         ASSERT_EQ(handler.getTemporaryArraySize(), expectedArraySize);
     }
+
+    /**
+     * Evaluates the model using compiled source code.
+     */
+    std::vector<double> evaluate(ADFun<CGD>& f,
+                                 const std::vector<double>& x,
+                                 bool registerPressureScheduling) {
+        using CppAD::vector;
+
+        size_t n = f.Domain();
+
+        CodeHandler<double> handler(10 + n * n);
+        handler.setRegisterPressureScheduling(registerPressureScheduling);
+
+        vector<CGD> indVars(n);
+        handler.makeVariables(indVars);
+
+        vector<CGD> dep = f.Forward(0, indVars);
+
+        LanguageC<double> langC("double");
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+        handler.generateCode(code, langC, dep, nameGen);
+
+        std::string function = registerPressureScheduling ? "model_scheduled" : "model_default";
+        std::string library = "./tmp/test_temporary_" + function + ".so";
+
+        std::string source = "#include <math.h>\n\n"
+                             "void " + function + "(const double* x, double* y) {\n";
+        source += langC.generateTemporaryVariableDeclaration();
+        source += code.str();
+        source += "}";
+
+        compile(source, library);
+
+        void* libHandle = loadLibrary(library);
+
+        void (*fn)(const double*, double*) = nullptr;
+        try {
+            *(void**) (&fn) = getFunction(libHandle, function);
+        } catch (const std::exception& ex) {
+            closeLibrary(libHandle);
+            throw;
+        }
+
+        std::vector<double> y(dep.size());
+        (*fn)(&x[0], &y[0]);
+
+        closeLibrary(libHandle);
+
+        return y;
+    }
 };
 
 } // END cg namespace
@@ -148,3 +203,43 @@ TEST_F(CppADCGTempTest, Temporary3) {
     ADFun<CGD> f(ind, dep);
     testModel(f, 1, 0);
 }
+
+TEST_F(CppADCGTempTest, RegisterPressureScheduling) {
+    size_t n = 4;
+    size_t m = 1;
+
+    std::vector<ADCGD> u(n); // independent variable vector
+    for (size_t j = 0; j < n; j++)
+        u[j] = j + 1;
+    Independent(u);
+
+    std::vector<ADCGD> Z(m); // dependent variable vector
+
+    // model
+    ADCGD a = u[0] * u[1]; // requires a single temporary
+    ADCGD p = u[1] * u[2];
+    ADCGD q = u[2] * u[3];
+    ADCGD r = p * p + q * q; // requires two temporaries
+    Z[0] = a * a + r * r;
+
+    ADFun<CGD> f(u, Z);
+    testModel(f, 3, 0); // a, p, q
+    testModel(f, 2, 0, true); // p, q (r and a reuse them)
+
+    /**
+     * the rescheduled operations must produce the same results
+     */
+    std::vector<double> x{1.5, -0.5, 2.0, 0.7};
+
+    double ae = x[0] * x[1];
+    double pe = x[1] * x[2];
+    double qe = x[2] * x[3];
+    double re = pe * pe + qe * qe;
+    std::vector<double> expected{ae * ae + re * re};
+
+    std::vector<double> yDefault = evaluate(f, x, false);
+    std::vector<double> yScheduled = evaluate(f, x, true);
+
+    ASSERT_TRUE(compareValues(yDefault, expected));
+    ASSERT_TRUE(compareValues(yScheduled, yDefault));
+}